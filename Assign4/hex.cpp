@@ -116,4 +116,43 @@ string hex::to_hex0x32(uint32_t i)
 
     return std::string("0x")+to_hex32(i);
 
-}
\ No newline at end of file
+}
+
+/**
+Append exactly 2 hex digits representing the 8 bits of the i argument to the end of s.
+ *
+ * @param s the string to append to
+ * @param i a 8 bit unsigned hex number
+ * @return void
+ * formats with a lookup table so bulk writers do not need a stream per value
+ ********************************************************************************/
+void hex::append_hex8(string &s, uint8_t i)
+{
+    static const char digits[] = "0123456789abcdef";
+
+    s += digits[i >> 4];
+    s += digits[i & 0x0f];
+
+}
+
+/**
+Append exactly 8 hex digits representing the 32 bits of the i argument to the end of s.
+ *
+ * @param s the string to append to
+ * @param i a 32 bit unsigned hex number
+ * @return void
+ * formats with a lookup table so bulk writers do not need a stream per value
+ ********************************************************************************/
+void hex::append_hex32(string &s, uint32_t i)
+{
+    static const char digits[] = "0123456789abcdef";
+    char buf[8];
+
+    for(int x = 7; x >= 0; --x)         // fill from the low nibble up
+    {
+        buf[x] = digits[i & 0x0f];
+        i >>= 4;
+    }
+    s.append(buf, sizeof(buf));
+
+}
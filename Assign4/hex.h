@@ -18,6 +18,9 @@ public:
     static string to_hex0x12(uint32_t);
     static string to_hex0x20(uint32_t);
     static string to_hex0x32(uint32_t );
+
+    static void append_hex8(string &, uint8_t );
+    static void append_hex32(string &, uint32_t );
 };
 
 #endif
@@ -12,6 +12,14 @@
 #include <sstream>
 #include <iostream>
 #include <getopt.h>
+#include <thread>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "memory.h"
 #include "rv32i_decode.h"
 
@@ -28,8 +36,11 @@ using std::cerr;
  ********************************************************************************/
 static void usage()
 {
-	cerr << "Usage: rv32i [-m hex-mem-size] infile" << endl;
+	cerr << "Usage: rv32i [-c] [-j threads] [-m hex-mem-size] [-s] infile" << endl;
+	cerr << "    -c collapse runs of identical words when streaming" << endl;
+	cerr << "    -j disassemble in bulk with this many threads (0 = one per core)" << endl;
 	cerr << "    -m specify memory size (default = 0x100)" << endl;
+	cerr << "    -s stream the file from disk instead of loading it into memory" << endl;
 	exit(1);
 }
 
@@ -53,6 +64,191 @@ static void disassemble(const memory &mem)
 
 }
 
+/**
+ * Renders the disassembly of the words in [first, last) into a buffer
+ *
+ * @param mem the memory holding the program
+ * @param first the address of the first word to render
+ * @param last the address one past the last word to render
+ * @param out the buffer the lines are appended to
+ * @return void
+ *
+ * @note produces the same lines as disassemble() without touching an ostream
+ ********************************************************************************/
+static void render_disassembly(const memory &mem, uint32_t first, uint32_t last, std::string &out)
+{
+    const uint8_t *data = mem.get_data();
+
+    out.reserve(out.size() + (last - first) / 4 * 64);
+    for(uint32_t addr = first; addr < last; addr += 4)
+    {
+        const uint8_t *p = data + addr;         // little-endian word
+        uint32_t insn = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+
+        hex::append_hex32(out, addr);
+        out += ": ";
+        hex::append_hex32(out, insn);
+        out += " ";
+        out += rv32i_decode::decode(addr, insn);
+        out += '\n';
+    }
+}
+
+/**
+ * bulk disassemble function used to print instruction information for large images
+ *
+ * @param mem the memory holding the program
+ * @param threads number of render threads, 0 means one per core
+ * @return void
+ *
+ * @note splits memory into one chunk per thread, renders each chunk into its own
+ * buffer and then writes the buffers out in address order
+ ********************************************************************************/
+static void disassemble_bulk(const memory &mem, unsigned threads)
+{
+    if(threads == 0)
+        threads = std::thread::hardware_concurrency();
+    if(threads == 0)
+        threads = 1;
+
+    uint32_t words = mem.get_size() / 4;
+    uint32_t chunk = (words + threads - 1) / threads * 4;       // bytes per thread
+    if(chunk == 0)
+        return;
+
+    std::vector<std::string> bufs(threads);
+    std::vector<std::thread> workers;
+    for(unsigned t = 0; t < threads; ++t)
+    {
+        uint32_t first = t * chunk;
+        if(first >= words * 4)
+            break;
+        uint32_t last = std::min<uint64_t>((uint64_t)first + chunk, words * 4);
+        workers.emplace_back(render_disassembly, std::cref(mem), first, last, std::ref(bufs[t]));
+    }
+
+    for(size_t t = 0; t < workers.size(); ++t)      // write each chunk as soon as it is done
+    {
+        workers[t].join();
+        cout.write(bufs[t].data(), bufs[t].size());
+        std::string().swap(bufs[t]);
+    }
+    cout.flush();
+}
+
+/**
+ * streaming disassemble function used for files of any size up to 4 GiB
+ *
+ * @param fname the name of the file to disassemble
+ * @param collapse true to print a single * line for runs of identical words
+ * @return bool false if the file could not be opened or mapped, or does not
+ * fit in the 32-bit address space
+ *
+ * @note maps the file a window at a time and disassembles it straight from the
+ * mapping, so neither a memory object nor -m are needed and memory use stays
+ * bounded by the window and output buffer sizes
+ ********************************************************************************/
+static bool disassemble_stream(const std::string &fname, bool collapse)
+{
+    static constexpr size_t window_size = 64u << 20;       // bytes mapped at a time
+    static constexpr size_t flush_size = 1u << 20;         // output buffered before a write
+
+    int fd = open(fname.c_str(), O_RDONLY);
+    if(fd < 0)
+    {
+        cerr << "Can't open file " <<  fname << " for reading." << endl;
+        return false;
+    }
+
+    struct stat st;
+    if(fstat(fd, &st) != 0)
+    {
+        cerr << "Can't stat file " << fname << endl;
+        close(fd);
+        return false;
+    }
+
+    uint64_t file_size = st.st_size;
+    if(file_size > 0x100000000ull)      // addresses past 4 GiB would wrap
+    {
+        cerr << "File " << fname << " is larger than the 32-bit address space." << endl;
+        close(fd);
+        return false;
+    }
+    std::string out;
+    out.reserve(flush_size + 256);
+
+    bool in_run = false;            // true while a run of repeated words is being skipped
+    bool have_prev = false;
+    uint32_t prev = 0;
+    uint32_t last_addr = 0;
+
+    for(uint64_t base = 0; base < file_size; base += window_size)
+    {
+        size_t len = std::min<uint64_t>(window_size, file_size - base);
+        void *map = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, base);
+        if(map == MAP_FAILED)
+        {
+            cerr << "Can't map file " << fname << endl;
+            close(fd);
+            return false;
+        }
+        madvise(map, len, MADV_SEQUENTIAL);
+        const uint8_t *data = static_cast<const uint8_t*>(map);
+
+        for(size_t off = 0; off < len; off += 4)
+        {
+            uint8_t b[4] = { 0xa5, 0xa5, 0xa5, 0xa5 };      // same fill as memory for a short last word
+            for(size_t x = 0; x < 4 && off + x < len; ++x)
+                b[x] = data[off + x];
+            uint32_t insn = (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+            uint32_t addr = base + off;
+
+            if(collapse && have_prev && insn == prev)
+            {
+                if(!in_run)
+                    out += "*\n";
+                in_run = true;
+                last_addr = addr;
+                continue;
+            }
+
+            in_run = false;
+            have_prev = true;
+            prev = insn;
+
+            hex::append_hex32(out, addr);
+            out += ": ";
+            hex::append_hex32(out, insn);
+            out += " ";
+            out += rv32i_decode::decode(addr, insn);
+            out += '\n';
+
+            if(out.size() >= flush_size)
+            {
+                cout.write(out.data(), out.size());
+                out.clear();
+            }
+        }
+        munmap(map, len);
+    }
+
+    if(in_run)          // show where the last run ended
+    {
+        hex::append_hex32(out, last_addr);
+        out += ": ";
+        hex::append_hex32(out, prev);
+        out += " ";
+        out += rv32i_decode::decode(last_addr, prev);
+        out += '\n';
+    }
+    cout.write(out.data(), out.size());
+    cout.flush();
+
+    close(fd);
+    return true;
+}
+
 /**
  * Main function used to call printBinFloat to decode a hex number to IEEE 754 number
  *
@@ -65,11 +261,32 @@ static void disassemble(const memory &mem)
 int main(int argc, char **argv)
 {
     uint32_t memory_limit = 0x100;
+    bool bulk_disassembly = false;
+    bool stream = false;
+    bool collapse = false;
+    unsigned disassembly_threads = 0;
     int opt;
-    while ((opt = getopt(argc, argv, "m:")) != -1)
+    while ((opt = getopt(argc, argv, "cj:m:s")) != -1)
     {
         switch (opt)
         {
+            case 'c':
+            {
+                collapse = true;
+            }
+            break;
+            case 's':
+            {
+                stream = true;
+            }
+            break;
+            case 'j':
+            {
+                std::istringstream iss(optarg);
+                iss >> std::dec >> disassembly_threads;
+                bulk_disassembly = true;
+            }
+            break;
         	case 'm':
         	{
         		std::istringstream iss(optarg);
@@ -83,12 +300,22 @@ int main(int argc, char **argv)
     if (optind >= argc)
     	usage();    // missing filename
 
+    if(stream)
+    {
+        if(!disassemble_stream(argv[optind], collapse))
+            usage();
+        return 0;
+    }
+
     memory mem(memory_limit);
 
     if (!mem.load_file(argv[optind]))
         usage();
 
-    disassemble(mem);
+    if(bulk_disassembly)
+        disassemble_bulk(mem, disassembly_threads);
+    else
+        disassemble(mem);
     mem.dump();
 
 return 0; 
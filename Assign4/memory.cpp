@@ -68,6 +68,19 @@
     }
 
 
+/**
+ * Returns a pointer to the first byte of the simulated memory
+ *
+ * @return const uint8_t* to the start of the vector
+ *
+ * @note used by bulk readers that walk whole regions without per byte checks
+ ********************************************************************************/
+    const uint8_t *memory::get_data() const
+    {
+        return mem.data();
+
+    }
+
 /**
  * Check to see if the given addr is in your mem by calling check_illegal(). 
  *   If addr is in the valid range then return the value of the byte from your simulated memory at the given address. 
@@ -13,6 +13,7 @@ public:
 
     bool check_illegal(uint32_t ) const;
     uint32_t get_size() const;
+    const uint8_t *get_data() const;
     uint8_t get8(uint32_t ) const;
     uint16_t get16(uint32_t ) const;
     uint32_t get32(uint32_t ) const;
@@ -0,0 +1,212 @@
+#include <iostream>
+#include <sstream>
+#include <getopt.h>
+#include "aot_runtime.h"
+#include "rv32i_hart.h"
+#include "syscalls.h"
+
+// The dispatch loop and main() linked into every program rv32aot writes.  It
+// runs translated blocks and interprets whatever was not translated.
+
+/**
+ * A hart that runs translated blocks and interprets everything else
+ ********************************************************************************/
+class aot_cpu : public rv32i_hart
+{
+    public:
+        aot_cpu(memory &m) : rv32i_hart(m) {}
+        bool run(uint64_t exec_limit, aot_cpu *ref);
+
+    private:
+        void get_state(const aot_state &s, uint32_t pc, cosim_state &st) const;
+};
+
+/**
+ * Copies the state of the translated engine for a lockstep compare
+ * @return void
+ *
+* @param s the registers and last store of the translated code
+* @param pc the next pc
+* @param st filled in the same layout as rv32i_hart::get_state()
+ ********************************************************************************/
+void aot_cpu::get_state(const aot_state &s, uint32_t pc, cosim_state &st) const
+{
+    st.pc = pc;
+    for(uint32_t r = 0; r < 32; ++r)
+        st.x[r] = s.x[r];
+    st.write_addr = s.write_addr;
+    st.write_val = s.write_val;
+    st.write_len = s.write_len;
+    st.halted = is_halted();
+}
+
+/**
+ * Run the translated program
+ * @return bool false if a lockstep run diverged
+ *
+* @param exec_limit stop after about this many instructions, 0 for no limit
+* @param ref a second hart on its own copy of memory to run in lockstep, or null
+ *
+ * @note the registers live in an aot_state while blocks run and are copied to
+ * and from the hart around each interpreted instruction. The last store goes
+ * to memory too, so one that does not store leaves it as the blocks set it.
+ * The limit is checked between blocks so it can be passed by up to one block.
+ * In lockstep the reference interprets as many instructions as each step ran
+ * and the two states are compared, stopping at the first difference
+ ********************************************************************************/
+bool aot_cpu::run(uint64_t exec_limit, aot_cpu *ref)
+{
+    regs.set(2, mem.get_size());            // same start as cpu_single_hart
+    if(ref)
+        ref->regs.set(2, ref->mem.get_size());
+
+    aot_state s;
+    for(uint32_t r = 0; r < 32; ++r)
+        s.x[r] = regs.get(r);
+    s.data = mem.get_data();
+    s.size = mem.get_size();
+    s.mem = &mem;
+    s.insns = 0;
+    s.write_addr = mem.get_last_write_addr();
+    s.write_val = mem.get_last_write_val();
+    s.write_len = mem.get_last_write_len();
+
+    cosim_state mine, theirs;
+    bool diverged = false;
+
+    uint32_t pc = get_pc();
+    while(!is_halted() && (exec_limit == 0 || s.insns < exec_limit))
+    {
+        uint64_t before = s.insns;
+        aot_block_fn f = aot_lookup(pc);
+        if(f)
+            pc = f(s);
+        else
+        {
+            for(uint32_t r = 1; r < 32; ++r)    // interpret one instruction
+                regs.set(r, s.x[r]);
+            set_pc(pc);
+            mem.set_last_write(s.write_addr, s.write_val, s.write_len);
+            tick();
+            ++s.insns;
+            for(uint32_t r = 1; r < 32; ++r)
+                s.x[r] = regs.get(r);
+            pc = get_pc();
+            s.write_addr = mem.get_last_write_addr();
+            s.write_val = mem.get_last_write_val();
+            s.write_len = mem.get_last_write_len();
+        }
+
+        if(!ref)
+            continue;
+        for(uint64_t i = before; i < s.insns; ++i)
+            ref->tick();
+        get_state(s, pc, mine);
+        ref->rv32i_hart::get_state(theirs);
+        if(!cosim_equal(mine, theirs))
+        {
+            cosim_report(std::cout, mine, "translated", theirs, "interpreter", s.insns);
+            diverged = true;
+            break;
+        }
+    }
+
+    for(uint32_t r = 1; r < 32; ++r)
+        regs.set(r, s.x[r]);
+    set_pc(pc);
+
+    if(sys)
+        sys->flush();
+    if(is_halted())
+        std::cout << "Execution terminated. Reason: " << get_halt_reason() << std::endl;
+    std::cout << s.insns << " instructions executed" << std::endl;
+    return !diverged;
+}
+
+/**
+ * Usage function used to print useful information
+ *
+ * @return void
+ *
+ * @note Shows how to use the program flags
+ ********************************************************************************/
+static void usage()
+{
+    std::cerr << "Usage: translated program [-c] [-l exec-limit] [-s] [-N] [-z]" << std::endl;
+    std::cerr << "    -c check every block in lockstep against the interpreter" << std::endl;
+    std::cerr << "    -l maximum number of instructions to exec" << std::endl;
+    std::cerr << "    -s emulate Linux system calls on ecall instead of halting" << std::endl;
+    std::cerr << "    -N run memcpy/memset/memmove/strlen natively on ecall 0x4000-0x4003" << std::endl;
+    std::cerr << "    -z show a dump of the regs & memory after simulation" << std::endl;
+    exit(1);
+}
+
+/**
+ * Main function for a translated program
+ *
+* @param argc an int for the argument count
+* @param argv a char for the argument values
+ * @return int the guest exit status when it called exit, otherwise 0
+ ********************************************************************************/
+int main(int argc, char **argv)
+{
+    uint64_t exec_limit = 0;
+    bool emulate_syscalls = false;
+    bool native_ecalls = false;
+    bool show_post_dump = false;
+    bool lockstep = false;
+    int opt;
+    while((opt = getopt(argc, argv, "cl:sNz")) != -1)
+    {
+        switch(opt)
+        {
+            case 'c':  lockstep = true; break;
+            case 'l':
+            {
+                std::istringstream iss(optarg);
+                iss >> std::dec >> exec_limit;
+            }
+            break;
+            case 's':  emulate_syscalls = true; break;
+            case 'N':  native_ecalls = true; break;
+            case 'z':  show_post_dump = true; break;
+            default:  usage();
+        }
+    }
+
+    if(lockstep && emulate_syscalls)
+    {
+        std::cerr << "-c and -s can't be used together, the guest would do its I/O twice" << std::endl;
+        usage();
+    }
+
+    memory mem(aot_mem_size);
+    mem.set_block(0, aot_image, aot_image_size);
+    memory ref_mem(aot_mem_size);
+    ref_mem.set_block(0, aot_image, aot_image_size);
+
+    aot_cpu cpu(mem);
+    cpu.reset();
+    cpu.set_pc(aot_entry);
+
+    syscalls sys(mem, (aot_image_size + 7) & ~7u);
+    if(emulate_syscalls)
+        cpu.set_syscalls(&sys);
+    cpu.set_native_ecalls(native_ecalls);
+
+    aot_cpu ref(ref_mem);
+    ref.reset();
+    ref.set_pc(aot_entry);
+    ref.set_native_ecalls(native_ecalls);
+
+    if(!cpu.run(exec_limit, lockstep ? &ref : nullptr))
+        return 2;
+
+    if(show_post_dump)
+    {
+        cpu.dump();
+        mem.dump();
+    }
+
+    return sys.has_exited() ? sys.get_exit_code() : 0;
+}
@@ -0,0 +1,124 @@
+#ifndef AOT_RUNTIME_H
+#define AOT_RUNTIME_H
+
+#include <cstdint>
+#include <cstring>
+#include "memory.h"
+
+// Support for programs translated by rv32aot.  The translated file defines
+// the image and one function per basic block; aot_runtime.cpp holds main()
+// and the dispatch loop that falls back to the interpreter for anything that
+// was not translated.
+
+struct aot_state
+{
+    uint32_t x[32];                 ///< the integer registers, x[0] is always 0
+    uint8_t *data;                  ///< the memory backing store
+    uint32_t size;
+    memory *mem;                    ///< for out of range accesses
+    uint64_t insns;                 ///< instructions executed
+    uint32_t write_addr;            ///< the last store, for lockstep runs
+    uint32_t write_val;
+    uint32_t write_len;
+};
+
+typedef uint32_t (*aot_block_fn)(aot_state &);     ///< runs a block, returns the next pc
+
+// defined by the translated program
+extern const uint32_t aot_entry;
+extern const uint32_t aot_mem_size;
+extern const uint32_t aot_image_size;
+extern const uint8_t aot_image[];
+aot_block_fn aot_lookup(uint32_t pc);
+
+// Loads and stores go straight to the backing store when in range (the host is
+// little-endian like the guest) and through memory, with its warnings, if not.
+
+inline uint32_t aot_ld8(aot_state &s, uint32_t a)
+{
+    return a < s.size ? s.data[a] : s.mem->get8(a);
+}
+
+inline uint32_t aot_ld16(aot_state &s, uint32_t a)
+{
+    uint16_t v;
+    if((uint64_t)a + 2 > s.size)
+        return s.mem->get16(a);
+    std::memcpy(&v, s.data + a, 2);
+    return v;
+}
+
+inline uint32_t aot_ld32(aot_state &s, uint32_t a)
+{
+    uint32_t v;
+    if((uint64_t)a + 4 > s.size)
+        return s.mem->get32(a);
+    std::memcpy(&v, s.data + a, 4);
+    return v;
+}
+
+inline void aot_note_write(aot_state &s, uint32_t a, uint32_t v, uint32_t len)
+{
+    s.write_addr = a;
+    s.write_val = v;
+    s.write_len = len;
+}
+
+inline void aot_st8(aot_state &s, uint32_t a, uint32_t v)
+{
+    aot_note_write(s, a, (uint8_t)v, 1);
+    if(a < s.size)
+        s.data[a] = (uint8_t)v;
+    else
+        s.mem->set8(a, v);
+}
+
+inline void aot_st16(aot_state &s, uint32_t a, uint32_t v)
+{
+    uint16_t h = v;
+    aot_note_write(s, a, h, 2);
+    if((uint64_t)a + 2 > s.size)
+        s.mem->set16(a, h);
+    else
+        std::memcpy(s.data + a, &h, 2);
+}
+
+inline void aot_st32(aot_state &s, uint32_t a, uint32_t v)
+{
+    aot_note_write(s, a, v, 4);
+    if((uint64_t)a + 4 > s.size)
+        s.mem->set32(a, v);
+    else
+        std::memcpy(s.data + a, &v, 4);
+}
+
+// RV32M division, including divide by zero and overflow
+inline uint32_t aot_div(uint32_t a, uint32_t b)
+{
+    if(b == 0)
+        return ~0u;
+    if(a == 0x80000000u && b == ~0u)
+        return a;
+    return (uint32_t)((int32_t)a / (int32_t)b);
+}
+
+inline uint32_t aot_divu(uint32_t a, uint32_t b)
+{
+    return b == 0 ? ~0u : a / b;
+}
+
+inline uint32_t aot_rem(uint32_t a, uint32_t b)
+{
+    if(b == 0)
+        return a;
+    if(a == 0x80000000u && b == ~0u)
+        return 0;
+    return (uint32_t)((int32_t)a % (int32_t)b);
+}
+
+inline uint32_t aot_remu(uint32_t a, uint32_t b)
+{
+    return b == 0 ? a : a % b;
+}
+
+#endif
@@ -0,0 +1,74 @@
+#include "bbv.h"
+
+/**
+ * Opens the output file
+ * @return bool false if it can't be written
+ *
+* @param fname the .bb file
+ ********************************************************************************/
+bool bbv_collector::open(const std::string &fname)
+{
+    os.open(fname, std::ios::out|std::ios::trunc);
+    left = interval;
+    return os.is_open();
+}
+
+/**
+ * Counts one fetch against its block
+ * @return void
+ *
+ * @note loads and stores and other harts are ignored. A hash lookup is only
+ * needed where the fetch stream jumps
+ ********************************************************************************/
+void bbv_collector::access(uint32_t h, uint64_t addr, uint32_t len, kind k)
+{
+    if(k != fetch || h != hart || !os.is_open())
+        return;
+
+    if(addr != next_pc)
+    {
+        auto it = ids.emplace(addr, counts.size());
+        if(it.second)
+            counts.push_back(0);
+        cur = it.first->second;
+    }
+    next_pc = addr + len;
+
+    if(counts[cur]++ == 0)
+        touched.push_back(cur);
+    if(--left == 0)
+    {
+        write_interval();
+        left = interval;
+    }
+}
+
+/**
+ * Writes the counts for an interval and clears them
+ * @return void
+ ********************************************************************************/
+void bbv_collector::write_interval()
+{
+    os << "T";
+    for(uint32_t id : touched)
+    {
+        os << ":" << id + 1 << ":" << counts[id] << " ";
+        counts[id] = 0;
+    }
+    os << "\n";
+    touched.clear();
+    ++intervals;
+}
+
+/**
+ * Writes the last, partial, interval and closes the file
+ * @return void
+ ********************************************************************************/
+void bbv_collector::finish()
+{
+    if(!os.is_open())
+        return;
+    if(!touched.empty())
+        write_interval();
+    os.close();
+}
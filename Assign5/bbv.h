@@ -0,0 +1,46 @@
+#ifndef BBV_H
+#define BBV_H
+#include <vector>
+#include <unordered_map>
+#include <fstream>
+#include <string>
+#include "mem_observer.h"
+
+// Collects basic block vectors for SimPoint style phase analysis.  Every
+// interval of instructions one hart runs becomes a line in the SimPoint .bb
+// format, listing how many instructions ran in each block:
+//
+//     T:1:5120 :3:20480 :4:102400
+//
+// Blocks are found from the fetch stream: a fetch that does not follow the one
+// before it starts a block, and blocks are numbered from 1 as they are first
+// seen.  bbvcluster picks the representative intervals from the file.
+class bbv_collector : public mem_observer
+{
+    public:
+        bbv_collector(uint64_t interval, uint32_t hart = 0) : interval(interval), hart(hart), left(interval) {}
+        ~bbv_collector() { finish(); }
+
+        bool open(const std::string &fname);
+        void access(uint32_t hart, uint64_t addr, uint32_t len, kind k) override;
+        void finish();
+
+        uint64_t get_intervals() const { return intervals; }
+        uint64_t get_blocks() const { return counts.size(); }
+
+    private:
+        void write_interval();
+
+        uint64_t interval;
+        uint32_t hart;
+        std::ofstream os;
+        std::unordered_map<uint64_t, uint32_t> ids;     ///< block start pc -> block id - 1
+        std::vector<uint64_t> counts;                   ///< instructions per block this interval
+        std::vector<uint32_t> touched;                  ///< blocks with a count this interval
+        uint32_t cur = { 0 };                           ///< the block running now
+        uint64_t next_pc = { ~0ull };                   ///< where the current block goes on
+        uint64_t left;                                  ///< instructions left in this interval
+        uint64_t intervals = { 0 };
+};
+
+#endif
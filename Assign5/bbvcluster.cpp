@@ -0,0 +1,307 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <algorithm>
+#include <getopt.h>
+
+// Picks representative intervals from basic block vectors written by rv32i -b,
+// the way SimPoint does: each vector is scaled to sum to 1, randomly projected
+// down to a few dimensions and clustered with k-means.  The interval nearest
+// each cluster centre stands for the cluster, weighted by the fraction of
+// intervals in it.  With -K the number of clusters is the smallest k whose BIC
+// score is within 90% of the best one seen for k = 1..K.
+
+typedef std::vector<double> point;
+
+/**
+ * Print a usage message and abort the program.
+ *
+ ********************************************************************************/
+static void usage()
+{
+    std::cerr << "Usage: bbvcluster [-k clusters | -K max-clusters] [-d dims] [-n restarts] [-s seed] [-o prefix] bbv-file" << std::endl;
+    std::cerr << "    -k use exactly this many clusters" << std::endl;
+    std::cerr << "    -K pick the number of clusters up to this many by BIC (default 10)" << std::endl;
+    std::cerr << "    -d dimensions to project the vectors to (default 15)" << std::endl;
+    std::cerr << "    -n k-means runs from different starts, the best is kept (default 5)" << std::endl;
+    std::cerr << "    -s random seed (default 1)" << std::endl;
+    std::cerr << "    -o also write prefix.simpoints and prefix.weights in SimPoint format" << std::endl;
+    exit(1);
+}
+
+/**
+ * A projection matrix entry in [-1, 1), the same for a block id every time
+ * @return double
+ ********************************************************************************/
+static double projection(uint64_t id, unsigned dim, uint32_t seed)
+{
+    uint64_t x = (id * 0x9e3779b97f4a7c15ull) ^ ((uint64_t)dim << 32) ^ seed;     // splitmix64
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return (x >> 11) * (2.0 / 9007199254740992.0) - 1.0;
+}
+
+/**
+ * Reads the vectors and projects each one as it is read
+ * @return bool false if the file can't be read
+ ********************************************************************************/
+static bool load(const std::string &fname, unsigned dims, uint32_t seed, std::vector<point> &pts)
+{
+    std::ifstream in(fname);
+    if(!in.is_open())
+    {
+        std::cerr << "Can't open file " << fname << " for reading." << std::endl;
+        return false;
+    }
+
+    std::string line;
+    std::vector<std::pair<uint64_t, double>> v;
+    while(std::getline(in, line))
+    {
+        if(line.empty() || line[0] != 'T')
+            continue;
+        v.clear();
+        double total = 0;
+        std::istringstream iss(line.substr(1));
+        char c;
+        uint64_t id;
+        double count;
+        while(iss >> c >> id >> c >> count)    // :id:count
+        {
+            v.emplace_back(id, count);
+            total += count;
+        }
+        point p(dims, 0.0);
+        for(const auto &e : v)
+            for(unsigned d = 0; d < dims; ++d)
+                p[d] += e.second / total * projection(e.first, d, seed);
+        pts.push_back(p);
+    }
+    return true;
+}
+
+/**
+ * Squared euclidean distance
+ * @return double
+ ********************************************************************************/
+static double dist2(const point &a, const point &b)
+{
+    double s = 0;
+    for(size_t d = 0; d < a.size(); ++d)
+        s += (a[d] - b[d]) * (a[d] - b[d]);
+    return s;
+}
+
+struct clustering
+{
+    std::vector<point> centres;
+    std::vector<unsigned> assign;
+    double distortion;                      ///< sum of squared distances to the centres
+};
+
+/**
+ * k-means from a k-means++ start
+ * @return clustering
+ ********************************************************************************/
+static clustering kmeans(const std::vector<point> &pts, unsigned k, std::mt19937_64 &rng)
+{
+    size_t n = pts.size();
+    clustering c;
+    c.assign.assign(n, 0);
+
+    c.centres.push_back(pts[rng() % n]);
+    std::vector<double> d2(n);
+    while(c.centres.size() < k)
+    {
+        double total = 0;
+        for(size_t i = 0; i < n; ++i)
+        {
+            d2[i] = std::numeric_limits<double>::max();
+            for(const point &ctr : c.centres)
+                d2[i] = std::min(d2[i], dist2(pts[i], ctr));
+            total += d2[i];
+        }
+        double r = (rng() >> 11) * (1.0 / 9007199254740992.0) * total;
+        size_t pick = 0;
+        for(; pick + 1 < n && r >= d2[pick]; ++pick)
+            r -= d2[pick];
+        c.centres.push_back(pts[pick]);
+    }
+
+    for(unsigned iter = 0; iter < 100; ++iter)
+    {
+        bool changed = false;
+        for(size_t i = 0; i < n; ++i)
+        {
+            unsigned best = 0;
+            for(unsigned j = 1; j < k; ++j)
+                if(dist2(pts[i], c.centres[j]) < dist2(pts[i], c.centres[best]))
+                    best = j;
+            changed = changed || best != c.assign[i];
+            c.assign[i] = best;
+        }
+        if(!changed && iter > 0)
+            break;
+
+        std::vector<point> sum(k, point(pts[0].size(), 0.0));
+        std::vector<size_t> cnt(k, 0);
+        for(size_t i = 0; i < n; ++i)
+        {
+            for(size_t d = 0; d < pts[i].size(); ++d)
+                sum[c.assign[i]][d] += pts[i][d];
+            ++cnt[c.assign[i]];
+        }
+        for(unsigned j = 0; j < k; ++j)
+            if(cnt[j])
+                for(size_t d = 0; d < sum[j].size(); ++d)
+                    c.centres[j][d] = sum[j][d] / cnt[j];
+    }
+
+    c.distortion = 0;
+    for(size_t i = 0; i < n; ++i)
+        c.distortion += dist2(pts[i], c.centres[c.assign[i]]);
+    return c;
+}
+
+/**
+ * Bayesian information criterion of a clustering, higher is better
+ * @return double
+ *
+ * @note spherical gaussians with one shared variance, as in X-means and SimPoint
+ ********************************************************************************/
+static double bic(const std::vector<point> &pts, const clustering &c)
+{
+    double r = pts.size();
+    double m = pts[0].size();
+    double k = c.centres.size();
+    if(r <= k)
+        return -std::numeric_limits<double>::max();
+    double var = std::max(c.distortion / (r - k), 1e-300);
+
+    std::vector<double> size(c.centres.size(), 0);
+    for(unsigned a : c.assign)
+        ++size[a];
+    double ll = 0;
+    for(double ri : size)
+        if(ri > 0)
+            ll += -ri / 2 * std::log(2 * M_PI) - ri * m / 2 * std::log(var) - (ri - k) / 2
+                + ri * std::log(ri) - ri * std::log(r);
+    return ll - k * (m + 1) / 2 * std::log(r);
+}
+
+/**
+ * Clusters the vectors and prints the simulation points
+ *
+* @param argc an int for the argument count
+* @param argv a char for the argument values
+ * @return int
+ *
+ ********************************************************************************/
+int main(int argc, char **argv)
+{
+    unsigned fixed_k = 0;
+    unsigned max_k = 10;
+    unsigned dims = 15;
+    unsigned restarts = 5;
+    uint32_t seed = 1;
+    std::string prefix;
+    int opt;
+    while((opt = getopt(argc, argv, "k:K:d:n:s:o:")) != -1)
+    {
+        std::istringstream iss(optarg ? optarg : "");
+        switch(opt)
+        {
+            case 'k': iss >> fixed_k; break;
+            case 'K': iss >> max_k; break;
+            case 'd': iss >> dims; break;
+            case 'n': iss >> restarts; break;
+            case 's': iss >> seed; break;
+            case 'o': prefix = optarg; break;
+            default: usage();
+        }
+    }
+    if(optind != argc - 1 || dims == 0 || restarts == 0 || (fixed_k == 0 && max_k == 0))
+        usage();
+
+    std::vector<point> pts;
+    if(!load(argv[optind], dims, seed, pts))
+        return 1;
+    if(pts.empty())
+    {
+        std::cerr << "No vectors in " << argv[optind] << std::endl;
+        return 1;
+    }
+
+    unsigned lo = fixed_k ? fixed_k : 1;
+    unsigned hi = std::min<size_t>(fixed_k ? fixed_k : max_k, pts.size());
+    lo = std::min(lo, hi);
+    std::vector<clustering> best(hi + 1);
+    std::vector<double> score(hi + 1);
+    std::mt19937_64 rng(seed);
+    for(unsigned k = lo; k <= hi; ++k)
+    {
+        for(unsigned r = 0; r < restarts; ++r)
+        {
+            clustering c = kmeans(pts, k, rng);
+            if(r == 0 || c.distortion < best[k].distortion)
+                best[k] = c;
+        }
+        score[k] = bic(pts, best[k]);
+    }
+
+    unsigned k = hi;
+    if(!fixed_k)
+    {
+        double smin = *std::min_element(score.begin() + lo, score.end());
+        double smax = *std::max_element(score.begin() + lo, score.end());
+        for(k = lo; k < hi && score[k] < smin + 0.9 * (smax - smin); ++k)
+            ;
+    }
+    const clustering &c = best[k];
+
+    std::vector<size_t> rep(k, pts.size()), cnt(k, 0);
+    for(size_t i = 0; i < pts.size(); ++i)
+    {
+        unsigned a = c.assign[i];
+        ++cnt[a];
+        if(rep[a] == pts.size() || dist2(pts[i], c.centres[a]) < dist2(pts[rep[a]], c.centres[a]))
+            rep[a] = i;
+    }
+
+    std::ofstream sp, wt;
+    if(!prefix.empty())
+    {
+        sp.open(prefix + ".simpoints");
+        wt.open(prefix + ".weights");
+        if(!sp.is_open() || !wt.is_open())
+        {
+            std::cerr << "Can't open file " << prefix << ".simpoints or .weights for writing." << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << pts.size() << " intervals, " << k << " clusters" << std::endl;
+    std::cout << "cluster  interval    weight" << std::endl;
+    for(unsigned j = 0; j < k; ++j)
+    {
+        if(!cnt[j])
+            continue;
+        double w = (double)cnt[j] / pts.size();
+        std::cout << std::setw(7) << j << std::setw(10) << rep[j] << std::setw(10) << std::fixed
+            << std::setprecision(4) << w << std::endl;
+        if(sp.is_open())
+        {
+            sp << rep[j] << " " << j << "\n";
+            wt << w << " " << j << "\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,30 @@
+#include "cosim.h"
+#include "hex.h"
+
+/**
+ * Print only the fields that differ between two engine states
+ *
+ * @param os where to print
+ * @param a the state of the first engine
+ * @param a_name what to call the first engine
+ * @param b the state of the second engine
+ * @param b_name what to call the second engine
+ * @param insns the number of instructions both have executed
+ * @return void
+ ********************************************************************************/
+void cosim_report(std::ostream &os, const cosim_state &a, const char *a_name,
+    const cosim_state &b, const char *b_name, uint64_t insns)
+{
+    os << "lockstep divergence after " << insns << " instructions (" << a_name << " / " << b_name << ")" << std::endl;
+
+    if(a.pc != b.pc)
+        os << "  pc " << hex::to_hex0x64(a.pc) << " / " << hex::to_hex0x64(b.pc) << std::endl;
+    for(int r = 0; r < 32; ++r)
+        if(a.x[r] != b.x[r])
+            os << (r < 10 ? "  x" : " x") << r << " " << hex::to_hex0x64(a.x[r]) << " / " << hex::to_hex0x64(b.x[r]) << std::endl;
+    if(a.write_addr != b.write_addr || a.write_val != b.write_val || a.write_len != b.write_len)
+        os << "  last write m" << a.write_len * 8 << "(" << hex::to_hex0x64(a.write_addr) << ") = " << hex::to_hex0x64(a.write_val)
+           << " / m" << b.write_len * 8 << "(" << hex::to_hex0x64(b.write_addr) << ") = " << hex::to_hex0x64(b.write_val) << std::endl;
+    if(a.halted != b.halted)
+        os << "  halted " << a.halted << " / " << b.halted << std::endl;
+}
@@ -0,0 +1,28 @@
+#ifndef COSIM_H
+#define COSIM_H
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+// Architectural state of one engine, laid out flat so two of them compare with
+// a single memcmp after every step of a lockstep run
+struct cosim_state
+{
+    uint64_t pc;
+    uint64_t x[32];
+    uint64_t write_addr;            ///< the last store
+    uint64_t write_val;
+    uint64_t write_len;
+    uint64_t halted;
+};
+
+inline bool cosim_equal(const cosim_state &a, const cosim_state &b)
+{
+    return std::memcmp(&a, &b, sizeof(cosim_state)) == 0;
+}
+
+void cosim_report(std::ostream &os, const cosim_state &a, const char *a_name,
+    const cosim_state &b, const char *b_name, uint64_t insns);
+
+#endif
@@ -0,0 +1,147 @@
+#include "cpu_multi_hart.h"
+#include "syscalls.h"
+
+/**
+ * Makes the harts, numbered from 0 in mhartid
+ *
+* @param m the memory they all share
+* @param n how many harts
+* @param ss bytes of stack each hart gets, hart i starts with sp = size - i*ss
+ ********************************************************************************/
+cpu_multi_hart::cpu_multi_hart(memory &m, unsigned n, uint32_t ss) : mem(m), stack_size(ss)
+{
+    for(unsigned i = 0; i < n; ++i)
+    {
+        harts.emplace_back(new rv32i_hart(mem));
+        harts.back()->set_mhartid(i);
+        hdrs.push_back("[" + std::to_string(i) + "] ");
+    }
+}
+
+void cpu_multi_hart::set_show_instructions(bool b)
+{
+    for(auto &h : harts)
+        h->set_show_instructions(b);
+}
+
+void cpu_multi_hart::set_show_registers(bool b)
+{
+    for(auto &h : harts)
+        h->set_show_registers(b);
+}
+
+void cpu_multi_hart::set_output(std::ostream &os)
+{
+    out = &os;
+    for(auto &h : harts)
+        h->set_output(os);
+}
+
+void cpu_multi_hart::set_syscalls(syscalls *s)
+{
+    sys = s;
+    for(auto &h : harts)
+        h->set_syscalls(s);
+}
+
+void cpu_multi_hart::set_native_ecalls(bool b)
+{
+    for(auto &h : harts)
+        h->set_native_ecalls(b);
+}
+
+void cpu_multi_hart::set_observer(mem_observer *o)
+{
+    for(auto &h : harts)
+        h->set_observer(o);
+}
+
+void cpu_multi_hart::set_sampling(uint64_t fast_forward, uint64_t window, uint64_t period)
+{
+    for(auto &h : harts)
+        h->set_sampling(fast_forward, window, period);
+}
+
+/**
+ * True when no hart has anything left to run
+ * @return bool
+ ********************************************************************************/
+bool cpu_multi_hart::all_halted() const
+{
+    for(const auto &h : harts)
+        if(!h->is_halted())
+            return false;
+    return true;
+}
+
+/**
+ * Resets every hart and gives each its own stack
+ * @return void
+ *
+ * @note all the harts start at pc 0, the guest reads mhartid to tell them apart
+ ********************************************************************************/
+void cpu_multi_hart::reset()
+{
+    for(unsigned i = 0; i < harts.size(); ++i)
+    {
+        harts[i]->reset();
+        harts[i]->set_reg(2, mem.get_size() - (uint64_t)i * stack_size);
+    }
+    switches = 0;
+}
+
+/**
+ * Runs the harts in turn, a quantum each, then prints how each one ended
+ * @return void
+ *
+* @param exec_limit the most instructions all the harts together run, 0 for no limit
+ *
+ * @note an exit system call ends the process, so once one hart has made it
+ * none of the others runs again
+ ********************************************************************************/
+void cpu_multi_hart::run(uint64_t exec_limit)
+{
+    uint64_t total = 0;
+    while(!all_halted() && (exec_limit == 0 || total < exec_limit) && !(sys && sys->has_exited()))
+    {
+        for(unsigned i = 0; i < harts.size(); ++i)
+        {
+            rv32i_hart &h = *harts[i];
+            if(h.is_halted())
+                continue;
+            ++switches;
+            for(uint64_t q = 0; q < quantum && !h.is_halted() && (exec_limit == 0 || total < exec_limit); ++q, ++total)
+                h.tick(hdrs[i]);
+            if((exec_limit && total >= exec_limit) || (sys && sys->has_exited()))
+                break;
+        }
+    }
+
+    if(sys)                                 // guest output comes before the summary
+        sys->flush();
+
+    uint64_t insns = 0;
+    for(unsigned i = 0; i < harts.size(); ++i)
+    {
+        rv32i_hart &h = *harts[i];
+        if(h.is_halted())
+            *out << hdrs[i] << "Execution terminated. Reason: " << h.get_halt_reason() << std::endl;
+        *out << hdrs[i] << h.get_insn_counter() << " instructions executed" << std::endl;
+        if(h.is_sampling())
+            *out << hdrs[i] << h.get_fast_insns() << " fast-forwarded, " << h.get_insn_counter() - h.get_fast_insns()
+                << " in " << h.get_detail_windows() << " detailed windows" << std::endl;
+        insns += h.get_insn_counter();
+    }
+    *out << insns << " instructions executed on " << harts.size() << " harts, "
+        << switches << " switches" << std::endl;
+}
+
+/**
+ * Dumps the registers of every hart
+ * @return void
+ ********************************************************************************/
+void cpu_multi_hart::dump() const
+{
+    for(unsigned i = 0; i < harts.size(); ++i)
+        harts[i]->dump(hdrs[i]);
+}
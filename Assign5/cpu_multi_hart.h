@@ -0,0 +1,48 @@
+#ifndef CPU_MULTI_HART_H
+#define CPU_MULTI_HART_H
+#include <vector>
+#include <memory>
+#include "rv32i_hart.h"
+
+// Runs several harts over one shared memory on the calling thread.  Each hart
+// runs a quantum of instructions and then the next one gets a turn, in hart id
+// order, so a run is the same every time.  A switch is one function call; no
+// host threads or stacks are involved.
+class cpu_multi_hart
+{
+    public:
+        cpu_multi_hart(memory &mem, unsigned harts, uint32_t stack_size = default_stack_size);
+
+        void set_quantum(uint64_t q) { quantum = q ? q : 1; }
+        void set_show_instructions(bool b);
+        void set_show_registers(bool b);
+        void set_output(std::ostream &os);
+        void set_syscalls(syscalls *s);
+        void set_native_ecalls(bool b);
+        void set_observer(mem_observer *o);
+        void set_sampling(uint64_t fast_forward, uint64_t window, uint64_t period);
+
+        unsigned get_harts() const { return harts.size(); }
+        rv32i_hart &get_hart(unsigned i) { return *harts[i]; }
+        bool all_halted() const;
+        uint64_t get_switches() const { return switches; }
+
+        void reset();
+        void run(uint64_t exec_limit);
+        void dump() const;
+
+        static constexpr uint32_t default_stack_size = 0x1000;
+        static constexpr uint64_t default_quantum = 100;
+
+    private:
+        std::vector<std::unique_ptr<rv32i_hart>> harts;
+        std::vector<std::string> hdrs;          ///< "[n] " before each trace line
+        memory &mem;
+        uint32_t stack_size;
+        uint64_t quantum = { default_quantum };
+        uint64_t switches = { 0 };
+        std::ostream *out = { &std::cout };
+        syscalls *sys = { nullptr };
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "cpu_single_hart.h"
+#include "syscalls.h"
 
 /**
  * The one cpu hart that run the program on the cpu
@@ -17,10 +18,16 @@ void cpu_single_hart::run(uint64_t exec_limit)
          if(!is_halted())
             tick();
 
+   if(sys)                    // guest output comes before the summary
+      sys->flush();
+
    if(is_halted())            // prints if halted 
-      std::cout << get_halt_reason() << " ";
+      *out << "Execution terminated. Reason: " << get_halt_reason() << std::endl;
                                                    // prints the instruction counter
-   std::cout << get_insn_counter() << " instructions executed" << std::endl;
+   *out << get_insn_counter() << " instructions executed" << std::endl;
+   if(is_sampling())          // how much of it the models saw
+      *out << get_fast_insns() << " fast-forwarded, " << get_insn_counter() - get_fast_insns()
+         << " in " << get_detail_windows() << " detailed windows" << std::endl;
    
 
 }
\ No newline at end of file
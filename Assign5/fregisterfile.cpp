@@ -0,0 +1,103 @@
+#include "fregisterfile.h"
+#include <cstring>
+
+/**
+ * Constructor 
+ * @return void  
+ *
+ * @note resets fregisterfile with default values 
+ ********************************************************************************/
+fregisterfile::fregisterfile()
+{
+    reset(); 
+}
+
+/**
+ * reset function to reset fregisterfile 
+ * @return void  
+ *
+ * @note resets all 32 regs to the same fill pattern as the integer registers
+ * and clears the rounding mode and accrued exception flags
+ ********************************************************************************/
+void fregisterfile::reset()
+{
+    registers.assign(32,0xf0f0f0f0);
+    fcsr = 0;
+
+}
+
+/**
+ * set function 
+ * @return void  
+ * @param r index of the vector
+ * @param val the IEEE 754 bit pattern to store
+ * @note there is no hardwired zero register in the floating point file
+ ********************************************************************************/
+void fregisterfile::set(uint32_t r, uint32_t val)
+{
+    registers[r] = val;
+
+}
+
+/**
+ * get function 
+ * @return uint32_t the IEEE 754 bit pattern
+ * @param r index of the vector
+ ********************************************************************************/
+uint32_t fregisterfile::get(uint32_t r) const
+{
+    return registers[r];
+
+}
+
+/**
+ * get a register as a host float
+ * @return float
+ * @param r index of the vector
+ ********************************************************************************/
+float fregisterfile::get_float(uint32_t r) const
+{
+    float f;
+    std::memcpy(&f, &registers[r], sizeof(f));
+    return f;
+
+}
+
+/**
+ * set a register from a host float
+ * @return void
+ * @param r index of the vector
+ * @param val the value to store
+ ********************************************************************************/
+void fregisterfile::set_float(uint32_t r, float val)
+{
+    std::memcpy(&registers[r], &val, sizeof(val));
+
+}
+
+/**
+ * Dump the register vector
+ * @return void  
+ * @param hdr prefix string 
+ * @param os where to print
+ * @note dumps the floating point registers in the same layout as registerfile
+ * followed by fcsr
+ * 
+ ********************************************************************************/
+void fregisterfile::dump(const std::string &hdr, std::ostream &os) const
+{
+    for(size_t r = 0; r < registers.size(); r += 8)
+    {
+        os << hdr << std::right << std::setw(3) << std::setfill(' ') << ("f" + std::to_string(r));
+
+        for(size_t x = 0; x < 8; x++)       // loops through the 8 registers
+        {
+            if(x == 4)
+                os << " ";
+            os << " " << hex::to_hex32(get(r + x));
+        }
+        os << std::endl;
+    }
+    os << hdr << "fcsr " << hex::to_hex32(fcsr) << std::endl;
+
+}
@@ -0,0 +1,38 @@
+#ifndef FREGISTERFILE_H
+#define FREGISTERFILE_H
+#include <vector>
+#include <iostream>
+#include "hex.h"
+
+class fregisterfile
+{
+    public:
+        static constexpr uint32_t fflags_nx     = 0x01;     // inexact
+        static constexpr uint32_t fflags_uf     = 0x02;     // underflow
+        static constexpr uint32_t fflags_of     = 0x04;     // overflow
+        static constexpr uint32_t fflags_dz     = 0x08;     // divide by zero
+        static constexpr uint32_t fflags_nv     = 0x10;     // invalid operation
+
+        fregisterfile();
+        void reset();
+        void set(uint32_t r, uint32_t val);
+        uint32_t get(uint32_t r) const;
+        float get_float(uint32_t r) const;
+        void set_float(uint32_t r, float val);
+
+        uint32_t get_fcsr() const { return fcsr; }
+        void set_fcsr(uint32_t val) { fcsr = val & 0xff; }
+        uint32_t get_frm() const { return (fcsr >> 5) & 0x7; }
+        void set_frm(uint32_t val) { fcsr = (fcsr & 0x1f) | ((val & 0x7) << 5); }
+        uint32_t get_fflags() const { return fcsr & 0x1f; }
+        void set_fflags(uint32_t val) { fcsr = (fcsr & 0xe0) | (val & 0x1f); }
+        void raise_fflags(uint32_t val) { fcsr |= (val & 0x1f); }
+
+        void dump(const std::string &hdr, std::ostream &os = std::cout) const;
+
+    private: 
+        std::vector<uint32_t> registers;
+        uint32_t fcsr = { 0 };
+};
+
+#endif
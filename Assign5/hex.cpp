@@ -116,4 +116,74 @@ string hex::to_hex0x32(uint32_t i)
 
     return std::string("0x")+to_hex32(i);
 
-}
\ No newline at end of file
+}
+
+/**
+This function must return a std::string with 16 hex digits representing the 64 bits of the i
+argument.
+ *
+ * @param i a 64 bit unsigned hex number
+ * @return string
+ * prints the int as a hex  
+ ********************************************************************************/
+string hex::to_hex64(uint64_t i)
+{
+
+    std::ostringstream os;
+    os << std::hex << std::setfill('0') << std::setw(16) << i;
+    return os.str();
+
+}
+
+/**
+This function must return a std::string beginning with 0x, followed by the 16 hex digits representing 
+ *
+ * @param i a 64 bit unsigned hex number
+ * @return string
+ * prints the int as a hex  
+ ********************************************************************************/
+string hex::to_hex0x64(uint64_t i)
+{
+
+    return std::string("0x")+to_hex64(i);
+
+}
+
+/**
+Append exactly 2 hex digits representing the 8 bits of the i argument to the end of s.
+ *
+ * @param s the string to append to
+ * @param i a 8 bit unsigned hex number
+ * @return void
+ * formats with a lookup table so bulk writers do not need a stream per value
+ ********************************************************************************/
+void hex::append_hex8(string &s, uint8_t i)
+{
+    static const char digits[] = "0123456789abcdef";
+
+    s += digits[i >> 4];
+    s += digits[i & 0x0f];
+
+}
+
+/**
+Append exactly 8 hex digits representing the 32 bits of the i argument to the end of s.
+ *
+ * @param s the string to append to
+ * @param i a 32 bit unsigned hex number
+ * @return void
+ * formats with a lookup table so bulk writers do not need a stream per value
+ ********************************************************************************/
+void hex::append_hex32(string &s, uint32_t i)
+{
+    static const char digits[] = "0123456789abcdef";
+    char buf[8];
+
+    for(int x = 7; x >= 0; --x)         // fill from the low nibble up
+    {
+        buf[x] = digits[i & 0x0f];
+        i >>= 4;
+    }
+    s.append(buf, sizeof(buf));
+
+}
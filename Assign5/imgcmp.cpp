@@ -0,0 +1,194 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <getopt.h>
+#include "hex.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Compares two raw memory or register images written by rv32i -M or -R and
+// prints the byte ranges that differ.
+
+/**
+ * Usage function used to print useful information
+ *
+ * @return void
+ *
+ * @note Shows how to use the program flags
+ ********************************************************************************/
+static void usage()
+{
+    std::cerr << "Usage: imgcmp [-g gap] [-q] image1 image2" << std::endl;
+    std::cerr << "    -g merge differences closer than gap bytes (default = 16)" << std::endl;
+    std::cerr << "    -q only set the exit status, print nothing" << std::endl;
+    exit(2);
+}
+
+/**
+ * Read a whole binary file into a vector
+ *
+ * @param fname the file to read
+ * @param data the vector to fill
+ * @return bool false if the file could not be read
+ ********************************************************************************/
+static bool read_image(const std::string &fname, std::vector<uint8_t> &data)
+{
+    std::ifstream infile(fname, std::ios::in|std::ios::binary|std::ios::ate);
+    if(!infile.is_open())
+    {
+        std::cerr << "Can't open file " << fname << " for reading." << std::endl;
+        return false;
+    }
+
+    std::streamsize size = infile.tellg();
+    infile.seekg(0);
+    data.resize(size);
+    if(!infile.read(reinterpret_cast<char*>(data.data()), size))
+    {
+        std::cerr << "Error reading " << fname << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Find the next byte at or after i where a and b differ
+ *
+ * @param a first image
+ * @param b second image
+ * @param i offset to start looking at
+ * @param n number of bytes both images have
+ * @return size_t offset of the next difference, n if there is none
+ *
+ * @note skips equal data 16 bytes at a time with SSE2, 8 bytes at a time without
+ ********************************************************************************/
+static size_t next_diff(const uint8_t *a, const uint8_t *b, size_t i, size_t n)
+{
+#if defined(__SSE2__)
+    for(; i + 16 <= n; i += 16)
+    {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) ^ 0xffff;
+        if(mask)
+            return i + __builtin_ctz(mask);
+    }
+#else
+    for(; i + 8 <= n; i += 8)
+    {
+        uint64_t wa, wb;
+        std::memcpy(&wa, a + i, 8);
+        std::memcpy(&wb, b + i, 8);
+        if(wa != wb)
+            break;
+    }
+#endif
+    for(; i < n; ++i)
+        if(a[i] != b[i])
+            return i;
+    return n;
+}
+
+/**
+ * Find the next byte at or after i where a and b are equal again
+ *
+ * @param a first image
+ * @param b second image
+ * @param i offset to start looking at
+ * @param n number of bytes both images have
+ * @return size_t offset of the next equal byte, n if there is none
+ ********************************************************************************/
+static size_t next_same(const uint8_t *a, const uint8_t *b, size_t i, size_t n)
+{
+    for(; i < n; ++i)
+        if(a[i] == b[i])
+            return i;
+    return n;
+}
+
+/**
+ * Main function used to compare two raw memory or register images
+ *
+* @param argc an int for the argument count
+* @param argv a char for the argument values
+ * @return int 0 if the images are the same, 1 if they differ, 2 on error
+ *
+ * @note prints one line per differing region as first-last: count
+ ********************************************************************************/
+int main(int argc, char **argv)
+{
+    size_t gap = 16;
+    bool quiet = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "g:q")) != -1)
+    {
+        switch (opt)
+        {
+            case 'g':
+            {
+                std::istringstream iss(optarg);
+                iss >> std::dec >> gap;
+            }
+            break;
+            case 'q':
+            {
+                quiet = true;
+            }
+            break;
+            default: /* ’?’ */
+            usage();
+        }
+    }
+    if (optind + 2 != argc)
+        usage();    // need two file names
+
+    std::vector<uint8_t> img1;
+    std::vector<uint8_t> img2;
+    if(!read_image(argv[optind], img1) || !read_image(argv[optind+1], img2))
+        return 2;
+
+    const uint8_t *a = img1.data();
+    const uint8_t *b = img2.data();
+    size_t n = std::min(img1.size(), img2.size());
+    bool differ = (img1.size() != img2.size());
+
+    size_t i = next_diff(a, b, 0, n);
+    while(i < n)
+    {
+        differ = true;
+        size_t first = i;
+        size_t last = next_same(a, b, i, n);        // one past the end of this run
+        size_t count = last - first;
+
+        while(last < n)                     // merge runs separated by less than gap equal bytes
+        {
+            size_t next = next_diff(a, b, last, n);
+            if(next >= n || next - last >= gap)
+            {
+                i = next;
+                break;
+            }
+            size_t end = next_same(a, b, next, n);
+            count += end - next;
+            last = end;
+        }
+        if(last >= n)
+            i = n;
+
+        if(quiet)
+            break;
+        std::cout << hex::to_hex32(first) << "-" << hex::to_hex32(last - 1) << ": "
+            << count << " bytes differ" << '\n';
+    }
+
+    if(img1.size() != img2.size() && !quiet)
+        std::cout << "size differs: " << hex::to_hex0x32(img1.size()) << " != "
+            << hex::to_hex0x32(img2.size()) << '\n';
+
+    return differ ? 1 : 0;
+}
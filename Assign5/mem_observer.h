@@ -0,0 +1,34 @@
+#ifndef MEM_OBSERVER_H
+#define MEM_OBSERVER_H
+#include <cstdint>
+#include <vector>
+
+// Sees every guest memory access a hart makes, tagged with the hart that made
+// it.  Accesses made on the guest's behalf by syscalls are not reported.
+class mem_observer
+{
+    public:
+        enum kind { fetch, load, store };
+
+        virtual ~mem_observer() {}
+        virtual void access(uint32_t hart, uint64_t addr, uint32_t len, kind k) = 0;
+};
+
+// Passes each access on to every observer added, in the order they were added
+class mem_observer_list : public mem_observer
+{
+    public:
+        void add(mem_observer *o) { list.push_back(o); }
+        bool empty() const { return list.empty(); }
+
+        void access(uint32_t hart, uint64_t addr, uint32_t len, kind k) override
+        {
+            for(mem_observer *o : list)
+                o->access(hart, addr, len, k);
+        }
+
+    private:
+        std::vector<mem_observer*> list;
+};
+
+#endif
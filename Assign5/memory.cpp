@@ -2,6 +2,12 @@
 #include "hex.h"
 #include <string>
 #include <fstream>
+#include <cstring>
+#include <cctype>
+#ifdef RV_HEATMAP
+#include <algorithm>
+#include <iomanip>
+#endif
 
 /**
  * Allocate siz bytes in the mem vector and initialize every byte/element to 0xa5.
@@ -17,6 +23,9 @@
         siz = (siz+15)&0xfffffff0;  // round up 
 
         mem.resize(siz,0xa5);       // resize and store a default value 
+#ifdef RV_HEATMAP
+        pages.resize(((uint64_t)siz + (1u << page_shift) - 1) >> page_shift);
+#endif
     }
 
    /**
@@ -42,12 +51,12 @@
  *
  * @note returns true if it is outside of vector 
  ********************************************************************************/
-    bool memory::check_illegal(uint32_t i) const
+    bool memory::check_illegal(addr_t i) const
     {
 
             if(i >= mem.size())             // checks if addy is bigger than the size
             {
-            std::cout << "WARNING: Address out of range: " << hex::to_hex0x32(i) << std::endl;
+            *out << "WARNING: Address out of range: " << xlen_t::to_hex0x(i) << std::endl;
             return true;
             }
             
@@ -68,6 +77,32 @@
     }
 
 
+/**
+ * Returns a pointer to the first byte of the simulated memory
+ *
+ * @return const uint8_t* to the start of the vector
+ *
+ * @note used by bulk readers that walk whole regions without per byte checks
+ ********************************************************************************/
+    const uint8_t *memory::get_data() const
+    {
+        return mem.data();
+
+    }
+
+/**
+ * Returns a writable pointer to the first byte of the simulated memory
+ *
+ * @return uint8_t* to the start of the vector
+ *
+ * @note for translated code that checks its own bounds before each access
+ ********************************************************************************/
+    uint8_t *memory::get_data()
+    {
+        return mem.data();
+
+    }
+
 /**
  * Check to see if the given addr is in your mem by calling check_illegal(). 
  *   If addr is in the valid range then return the value of the byte from your simulated memory at the given address. 
@@ -77,7 +112,7 @@
  *
  * @note assigns in the mem vector  
  ********************************************************************************/
-    uint8_t memory::get8(uint32_t addr) const
+    uint8_t memory::get8(addr_t addr) const
     {
 
         if(check_illegal(addr))
@@ -98,7 +133,7 @@
  *
  * @note stores a 16 bit value
  ********************************************************************************/
-    uint16_t memory::get16(uint32_t addr) const
+    uint16_t memory::get16(addr_t addr) const
     {
         uint16_t temp = ((uint16_t)get8(addr)) | ((uint16_t)get8(addr+1) << 8); // casts to a uint16_t and shift 8  bits
 
@@ -114,7 +149,7 @@
  *
  * @note stores a 32 bit value 
  ********************************************************************************/
-    uint32_t memory::get32(uint32_t addr) const
+    uint32_t memory::get32(addr_t addr) const
     {                 
         uint32_t temp = ((uint32_t)get16(addr)) | ((uint32_t)get16(addr + 2) << 16) ; // casts to a uint16_t and shift 16 bits
         return temp;
@@ -130,7 +165,7 @@
  *
  * @note returns a signed extended value
  ********************************************************************************/
-    int32_t memory::get8_sx(uint32_t addr) const
+    int32_t memory::get8_sx(addr_t addr) const
     {
         int32_t temp = get8(addr) ;     // cast to sign extended
        
@@ -146,7 +181,7 @@
  *
  * @note returns a signed extended value
  ********************************************************************************/
-    int32_t memory::get16_sx(uint32_t addr) const
+    int32_t memory::get16_sx(addr_t addr) const
     {
          int32_t temp = get16(addr);        // cast to sign extended
          return temp | (temp & 0x00008000 ? 0xffff0000 : 0);
@@ -161,11 +196,26 @@
  *
  * @note returns a signed extended value
  ********************************************************************************/
-    int32_t memory::get32_sx(uint32_t addr) const
+    int32_t memory::get32_sx(addr_t addr) const
     {
          return get32(addr);        
     }
 
+    /**
+ * This function must call your get32() function twice and then combine them in little-endian order 
+    to create a 64-bit return value.
+*  
+ * @param addr address of the first byte
+ * @return uint64_t 
+ *
+ * @note used by the RV64I ld instruction
+ ********************************************************************************/
+    uint64_t memory::get64(addr_t addr) const
+    {                 
+        uint64_t temp = ((uint64_t)get32(addr)) | ((uint64_t)get32(addr + 4) << 32);
+        return temp;
+    }
+
 /**
  * This function will call check_illegal() to verify the addr argument is valid. If addr is valid then 
     set the byte in the simulated memory at that address to the given val.
@@ -176,7 +226,7 @@
  *
  * @note stores value in memory at addr
  ********************************************************************************/
-    void memory::set8(uint32_t addr, uint8_t val)
+    void memory::set8(addr_t addr, uint8_t val)
     {
         if(check_illegal(addr))
         {
@@ -184,6 +234,9 @@
         }
 
         mem[addr] = val;
+        last_write_addr = addr;
+        last_write_val = val;
+        last_write_len = 1;
     }
 
   /**
@@ -195,11 +248,14 @@
  *
  * @note stores 16 bits
  ********************************************************************************/
-    void memory::set16(uint32_t addr, uint16_t val)
+    void memory::set16(addr_t addr, uint16_t val)
     {
         
         set8(addr,(uint8_t)(val));
         set8(addr+1,((val)>>8));
+        last_write_addr = addr;
+        last_write_val = val;
+        last_write_len = 2;
     }
 
     /**
@@ -211,59 +267,210 @@
  *
  * @note stores 32 bits
  ********************************************************************************/
-    void memory::set32(uint32_t addr, uint32_t val)
+    void memory::set32(addr_t addr, uint32_t val)
     {
       
         set16(addr,(uint16_t)(val));
         set16(addr+2,((val) >> 16));
+        last_write_addr = addr;
+        last_write_val = val;
+        last_write_len = 4;
+    }
+
+/**
+ * This function must call your set32() function twice to store the 64-bit value
+    in little-endian order.
+ *  
+ * @param addr address of the first byte
+ * @param val 64 bit value to store
+ * @return void  
+ *
+ * @note used by the RV64I sd instruction
+ ********************************************************************************/
+    void memory::set64(addr_t addr, uint64_t val)
+    {
+      
+        set32(addr,(uint32_t)(val));
+        set32(addr+4,(uint32_t)(val >> 32));
+        last_write_addr = addr;
+        last_write_val = val;
+        last_write_len = 8;
+    }
+
+/**
+ * Copy len bytes starting at addr out of the simulated memory
+ *  
+ * @param addr address of the first byte
+ * @param dst where to copy the bytes to
+ * @param len the number of bytes
+ * @return void  
+ *
+ * @note one memcpy when the whole block is in range, otherwise byte by byte
+ * through get8() so out of range bytes warn and read as 0
+ ********************************************************************************/
+    void memory::get_block(addr_t addr, uint8_t *dst, uint32_t len) const
+    {
+        if(addr < mem.size() && len <= mem.size() - addr)
+        {
+            std::memcpy(dst, &mem[addr], len);
+            return;
+        }
+        for(uint32_t i = 0; i < len; ++i)
+            dst[i] = get8(addr + i);
+    }
+
+/**
+ * Copy len bytes into the simulated memory starting at addr
+ *  
+ * @param addr address of the first byte
+ * @param src the bytes to store
+ * @param len the number of bytes
+ * @return void  
+ *
+ * @note one memcpy when the whole block is in range, otherwise byte by byte
+ * through set8() so out of range bytes warn and are dropped
+ ********************************************************************************/
+    void memory::set_block(addr_t addr, const uint8_t *src, uint32_t len)
+    {
+        if(addr < mem.size() && len <= mem.size() - addr)
+        {
+            std::memcpy(&mem[addr], src, len);
+            return;
+        }
+        for(uint32_t i = 0; i < len; ++i)
+            set8(addr + i, src[i]);
+    }
+
+/**
+ * Copy len bytes from src to dst inside the simulated memory
+ *  
+ * @param dst address of the first byte to write
+ * @param src address of the first byte to read
+ * @param len the number of bytes
+ * @return void  
+ *
+ * @note the blocks may overlap (memmove). One host memmove when both blocks are
+ * in range, otherwise byte by byte in the safe direction through get8()/set8()
+ ********************************************************************************/
+    void memory::move_block(addr_t dst, addr_t src, addr_t len)
+    {
+        if(dst < mem.size() && len <= mem.size() - dst && src < mem.size() && len <= mem.size() - src)
+        {
+            std::memmove(&mem[dst], &mem[src], len);
+            return;
+        }
+        if(dst <= src)
+            for(addr_t i = 0; i < len; ++i)
+                set8(dst + i, get8(src + i));
+        else
+            for(addr_t i = len; i-- > 0; )
+                set8(dst + i, get8(src + i));
+    }
+
+/**
+ * Set len bytes starting at addr to val
+ *  
+ * @param addr address of the first byte
+ * @param val the byte to store
+ * @param len the number of bytes
+ * @return void  
+ *
+ * @note one host memset when the block is in range, otherwise byte by byte
+ * through set8()
+ ********************************************************************************/
+    void memory::fill_block(addr_t addr, uint8_t val, addr_t len)
+    {
+        if(addr < mem.size() && len <= mem.size() - addr)
+        {
+            std::memset(&mem[addr], val, len);
+            return;
+        }
+        for(addr_t i = 0; i < len; ++i)
+            set8(addr + i, val);
+    }
+
+/**
+ * Find the first byte equal to val at or after addr
+ *  
+ * @param addr address to start at
+ * @param val the byte to look for
+ * @return addr_t the number of bytes before it
+ *
+ * @note a host memchr over the rest of memory. If val is not found the rest of
+ * memory is counted and the out of range warning is printed, as a guest loop
+ * would have run off the end
+ ********************************************************************************/
+    memory::addr_t memory::find_byte(addr_t addr, uint8_t val) const
+    {
+        if(addr < mem.size())
+        {
+            const void *p = std::memchr(&mem[addr], val, mem.size() - addr);
+            if(p)
+                return static_cast<const uint8_t*>(p) - &mem[addr];
+            check_illegal(mem.size());
+            return mem.size() - addr;
+        }
+        check_illegal(addr);
+        return 0;
     }
 
 /**
  * Dump the entire contents of your simulated memory in hex with the corresponding ASCII2 characters
+ *
+ * @param collapse true to print a single * line for runs of identical lines
  * @return void  
  *
- * @note prints the memory out
+ * @note formats whole lines into a buffer straight from the vector and writes
+ * the buffer out in large blocks, collapsing repeated lines like hexdump does
  ********************************************************************************/
-    void memory::dump() const
+    void memory::dump(bool collapse) const
     {
-        auto it = mem.begin();
-        int addressLine = 0;
+        static constexpr size_t flush_size = 1u << 16;     // output buffered before a write
+
+        std::string buf;
+        buf.reserve(flush_size + 128);
+
+        const uint8_t *data = mem.data();
+        size_t size = mem.size();
+        bool in_run = false;                // true while repeated lines are being skipped
 
-        while(it != mem.end())
+        for(size_t addr = 0; addr < size; addr += 16)
         {
-            if(addressLine % 16 == 0)
+            const uint8_t *line = data + addr;
+            bool last = (addr + 16 >= size);
+
+            if(collapse && addr != 0 && !last && std::memcmp(line, line - 16, 16) == 0)
             {
-            std::cout << hex::to_hex32(addressLine) << ": ";
+                if(!in_run)
+                    buf += "*\n";
+                in_run = true;
+                continue;
+            }
+            in_run = false;
 
-            size_t t = std::distance(mem.begin(),it); 
+            hex::append_hex32(buf, addr);
+            buf += ": ";
             for(size_t x = 0; x < 16; x++)
             {
                 if(x == 8)
-                    std::cout << " ";
-
-                std::cout << hex::to_hex8(get8(t)) << " ";
-                t++;
+                    buf += ' ';
+                hex::append_hex8(buf, line[x]);
+                buf += ' ';
             }
 
-            std::cout << "*";
-            size_t i = std::distance(mem.begin(),it); 
+            buf += '*';
             for(size_t x = 0; x < 16; x++)
+                buf += isprint(line[x]) ? (char)line[x] : '.';
+            buf += "*\n";
+
+            if(buf.size() >= flush_size)
             {
-                uint8_t ch = get8(i);
-                ch = isprint(ch) ? ch : '.';
-                std::cout << ch;
-                i++;
-            }
-            std::cout << "*";
-            std::cout << std::endl;
+                out->write(buf.data(), buf.size());
+                buf.clear();
             }
-
-            addressLine ++;
-            it++;
-
         }
-        
-       
+        out->write(buf.data(), buf.size());
+        out->flush();
 
     }
 
@@ -301,9 +508,183 @@
             }
 
             set8(addr,i);
+            load_size = addr + 1;
 
         }
          infile.close();
          return true;
         
     }
+
+/**
+ * Write the raw contents of your simulated memory to the file named fname.
+ *  
+ * @param string a file name
+ * @return bool
+ *
+ * @note writes the vector in one block so images can be compared with imgcmp
+ ********************************************************************************/
+    bool memory::save_file(const std::string &fname) const
+    {
+        std::ofstream outfile(fname, std::ios::out|std::ios::binary|std::ios::trunc);
+
+        if(!outfile.is_open())
+        {
+            std::cerr << "Can't open file " <<  fname << " for writing." << std::endl;
+            return false;
+
+        }
+
+        outfile.write(reinterpret_cast<const char*>(mem.data()), mem.size());
+        if(!outfile)
+        {
+            std::cerr << "Error writing " << fname << std::endl;
+            return false;
+        }
+        return true;
+
+    }
+
+#ifdef RV_HEATMAP
+/**
+ * Counts a guest access in every page, and line, it covers
+ *
+ * @param addr the first byte
+ * @param len the number of bytes
+ * @param k fetches also advance the working set windows, one per instruction
+ * @return void
+ *
+ * @note out of range accesses are not counted, check_illegal warns about them
+ ********************************************************************************/
+    void memory::touch(addr_t addr, uint32_t len, mem_observer::kind k)
+    {
+        if(k == mem_observer::fetch && --window_left == 0)
+            end_window();
+        if(addr >= mem.size() || len == 0)
+            return;
+
+        uint64_t last = std::min<uint64_t>((uint64_t)addr + len, mem.size()) - 1;
+        for(uint64_t p = addr >> page_shift; p <= last >> page_shift; ++p)
+            pages[p].count(k, cur_window, ws_pages);
+        if(lines.empty())
+            return;
+        for(uint64_t l = addr >> line_shift; l <= last >> line_shift; ++l)
+            lines[l].count(k, cur_window, ws_lines);
+    }
+
+/**
+ * Turns on the per line counts and sets the working set window
+ *
+ * @param lines count 64 byte lines as well as pages
+ * @param window instructions in each working set sample
+ * @return void
+ *
+ * @note call before the run, it clears anything counted so far
+ ********************************************************************************/
+    void memory::set_heatmap(bool lines, uint64_t window)
+    {
+        pages.assign(pages.size(), heat());
+        this->lines.clear();
+        if(lines)
+            this->lines.resize(((uint64_t)mem.size() + (1u << line_shift) - 1) >> line_shift);
+        working_set.clear();
+        heat_window = window ? window : default_heat_window;
+        window_left = heat_window;
+        cur_window = 0;
+        ws_pages = 0;
+        ws_lines = 0;
+    }
+
+/**
+ * Closes a working set window
+ *
+ * @return void
+ ********************************************************************************/
+    void memory::end_window()
+    {
+        working_set.push_back({ heat_window - window_left, ws_pages, ws_lines });
+        ++cur_window;
+        window_left = heat_window;
+        ws_pages = 0;
+        ws_lines = 0;
+    }
+
+/**
+ * Prints the busiest pages or lines, most accesses first
+ *
+ * @return void
+ ********************************************************************************/
+    void memory::heat_list(std::ostream &os, const std::vector<heat> &v, unsigned shift, unsigned hot) const
+    {
+        std::vector<uint64_t> idx;
+        for(uint64_t i = 0; i < v.size(); ++i)
+            if(v[i].window != ~0ull)
+                idx.push_back(i);
+        auto total = [&v](uint64_t i) { return v[i].fetches + v[i].loads + v[i].stores; };
+        std::stable_sort(idx.begin(), idx.end(), [&total](uint64_t a, uint64_t b) { return total(a) > total(b); });
+        if(idx.size() > hot)
+            idx.resize(hot);
+
+        os << "address          fetches        loads       stores        total" << std::endl;
+        for(uint64_t i : idx)
+            os << std::left << std::setw(12) << xlen_t::to_hex0x(i << shift) << std::right
+                << std::setw(13) << v[i].fetches << std::setw(13) << v[i].loads << std::setw(13) << v[i].stores
+                << std::setw(13) << total(i) << std::endl;
+    }
+
+/**
+ * Prints the working set over time and the hottest pages and lines
+ *
+ * @param os where to print
+ * @param hot how many pages and lines to list
+ * @return void
+ *
+ * @note the last window is usually short, its instruction count says how short
+ ********************************************************************************/
+    void memory::heat_report(std::ostream &os, unsigned hot) const
+    {
+        std::vector<ws_sample> ws = working_set;
+        if(heat_window - window_left != 0 || ws_pages != 0)
+            ws.push_back({ heat_window - window_left, ws_pages, ws_lines });
+
+        uint64_t touched = 0;
+        for(const heat &h : pages)
+            touched += (h.window != ~0ull);
+        uint64_t touched_lines = 0;
+        for(const heat &h : lines)
+            touched_lines += (h.window != ~0ull);
+
+        os << "heatmap: " << touched << " of " << pages.size() << " " << (1u << page_shift) << " byte pages touched ("
+            << (touched << page_shift) / 1024 << " KiB)";
+        if(!lines.empty())
+            os << ", " << touched_lines << " of " << lines.size() << " " << (1u << line_shift)
+                << " byte lines (" << (touched_lines << line_shift) << " bytes)";
+        os << std::endl;
+
+        os << "working set per " << heat_window << " instructions:" << std::endl;
+        os << "  window  instructions     pages       KiB" << (lines.empty() ? "" : "     lines     bytes") << std::endl;
+        ws_sample peak = { 0, 0, 0 };
+        for(size_t w = 0; w < ws.size(); ++w)
+        {
+            os << std::setw(8) << w << std::setw(14) << ws[w].insns << std::setw(10) << ws[w].pages
+                << std::setw(10) << (ws[w].pages << page_shift) / 1024;
+            if(!lines.empty())
+                os << std::setw(10) << ws[w].lines << std::setw(10) << (ws[w].lines << line_shift);
+            os << std::endl;
+            peak.pages = std::max(peak.pages, ws[w].pages);
+            peak.lines = std::max(peak.lines, ws[w].lines);
+        }
+        os << "peak working set: " << peak.pages << " pages (" << (peak.pages << page_shift) / 1024 << " KiB)";
+        if(!lines.empty())
+            os << ", " << peak.lines << " lines (" << (peak.lines << line_shift) << " bytes)";
+        os << std::endl;
+
+        os << "hottest pages:" << std::endl;
+        heat_list(os, pages, page_shift, hot);
+        if(!lines.empty())
+        {
+            os << "hottest lines:" << std::endl;
+            heat_list(os, lines, line_shift, hot);
+        }
+    }
+#endif
@@ -4,32 +4,119 @@
 #include <vector>
 #include <iostream>
 #include "hex.h"
+#include "xlen.h"
+#include "mem_observer.h"
 
 class memory : public hex
 {
 public:
+    typedef xlen_t::uword_t addr_t;         ///< addresses are as wide as the registers
+
     memory(uint32_t siz);
     ~memory();
 
-    bool check_illegal(uint32_t ) const;
+    bool check_illegal(addr_t ) const;
     uint32_t get_size() const;
-    uint8_t get8(uint32_t ) const;
-    uint16_t get16(uint32_t ) const;
-    uint32_t get32(uint32_t ) const;
+    uint32_t get_load_size() const { return load_size; }
+    const uint8_t *get_data() const;
+    uint8_t *get_data();
+    uint8_t get8(addr_t ) const;
+    uint16_t get16(addr_t ) const;
+    uint32_t get32(addr_t ) const;
+
+    int32_t get8_sx(addr_t ) const;
+    int32_t get16_sx(addr_t ) const;
+    int32_t get32_sx(addr_t ) const;
+    uint64_t get64(addr_t ) const;
+
+    void set8(addr_t , uint8_t ); 
+    void set16(addr_t , uint16_t ); 
+    void set32(addr_t , uint32_t );
+    void set64(addr_t , uint64_t );
+
+    void get_block(addr_t , uint8_t *, uint32_t ) const;
+    void set_block(addr_t , const uint8_t *, uint32_t );
+    void move_block(addr_t , addr_t , addr_t );
+    void fill_block(addr_t , uint8_t , addr_t );
+    addr_t find_byte(addr_t , uint8_t ) const;
+
+    // the last set8/16/32/64, so two runs can be compared store by store
+    addr_t get_last_write_addr() const { return last_write_addr; }
+    uint64_t get_last_write_val() const { return last_write_val; }
+    uint32_t get_last_write_len() const { return last_write_len; }
+    void set_last_write(addr_t addr, uint64_t val, uint32_t len) { last_write_addr = addr; last_write_val = val; last_write_len = len; }
 
-    int32_t get8_sx(uint32_t ) const;
-    int32_t get16_sx(uint32_t ) const;
-    int32_t get32_sx(uint32_t ) const;
+    // Guest accesses per 4K page, and per 64 byte line when asked, for sizing
+    // memories.  Built with -DRV_HEATMAP only, otherwise touch() is empty and
+    // the hart's accesses cost nothing extra.
+#ifdef RV_HEATMAP
+    void touch(addr_t addr, uint32_t len, mem_observer::kind k);
+    void set_heatmap(bool lines, uint64_t window);
+    void heat_report(std::ostream &os, unsigned hot = 10) const;
 
-    void set8(uint32_t , uint8_t ); 
-    void set16(uint32_t , uint16_t ); 
-    void set32(uint32_t , uint32_t );
+    static constexpr unsigned page_shift = 12;
+    static constexpr unsigned line_shift = 6;
+    static constexpr uint64_t default_heat_window = 100000;
+#else
+    void touch(addr_t , uint32_t , mem_observer::kind ) {}
+#endif
 
-    void dump() const;
+    void dump(bool collapse = false) const;
+    void set_output(std::ostream &os) { out = &os; }
     bool load_file(const std::string &);
+    bool save_file(const std::string &) const;
 
 private:
         std::vector<uint8_t> mem;
+        uint32_t load_size = { 0 };         ///< bytes read by load_file
+        addr_t last_write_addr = { 0 };
+        uint64_t last_write_val = { 0 };
+        uint32_t last_write_len = { 0 };
+        std::ostream *out = { &std::cout };     ///< where warnings and dumps go
+
+#ifdef RV_HEATMAP
+        struct heat
+        {
+            uint64_t fetches = { 0 };
+            uint64_t loads = { 0 };
+            uint64_t stores = { 0 };
+            uint64_t window = { ~0ull };        ///< the last window it was touched in
+
+            void count(mem_observer::kind k, uint64_t cur_window, uint64_t &ws)
+            {
+                if(k == mem_observer::fetch)
+                    ++fetches;
+                else if(k == mem_observer::load)
+                    ++loads;
+                else
+                    ++stores;
+                if(window != cur_window)        // first touch this window
+                {
+                    window = cur_window;
+                    ++ws;
+                }
+            }
+        };
+
+        struct ws_sample
+        {
+            uint64_t insns;                     ///< fetches in the window
+            uint64_t pages;
+            uint64_t lines;
+        };
+
+        void end_window();
+        void heat_list(std::ostream &os, const std::vector<heat> &v, unsigned shift, unsigned hot) const;
+
+        std::vector<heat> pages;
+        std::vector<heat> lines;                ///< empty unless set_heatmap asked for lines
+        std::vector<ws_sample> working_set;
+        uint64_t heat_window = { default_heat_window };
+        uint64_t window_left = { default_heat_window };
+        uint64_t cur_window = { 0 };
+        uint64_t ws_pages = { 0 };              ///< pages touched in this window so far
+        uint64_t ws_lines = { 0 };
+#endif
  };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,237 @@
+#include "memtrace.h"
+#include <cstring>
+
+static const char magic[8] = { 'R', 'V', 'M', 'T', 'R', 'C', 1, 0 };
+static constexpr size_t block_size = 1u << 16;      // bytes buffered before a write
+
+static constexpr uint8_t tag_kind = 0x03;
+static constexpr unsigned tag_size_shift = 2;
+static constexpr uint8_t tag_size_varint = 7;
+static constexpr uint8_t tag_hart = 0x20;
+static constexpr uint8_t tag_seq = 0x40;
+static constexpr uint64_t max_harts = 1u << 16;     // more in a trace means it is corrupt
+
+/**
+ * Opens the output file and writes the header
+ * @return bool false if it can't be written
+ *
+* @param fname the trace file
+ ********************************************************************************/
+bool memtrace_writer::open(const std::string &fname)
+{
+    os.open(fname, std::ios::out|std::ios::binary|std::ios::trunc);
+    if(!os.is_open())
+        return false;
+    buf.reserve(block_size + 32);
+    buf.assign(magic, sizeof(magic));
+    return true;
+}
+
+/**
+ * Appends an unsigned LEB128 number
+ * @return void
+ ********************************************************************************/
+void memtrace_writer::put_varint(uint64_t v)
+{
+    while(v >= 0x80)
+    {
+        buf += (char)(v | 0x80);
+        v >>= 7;
+    }
+    buf += (char)v;
+}
+
+/**
+ * Encodes one access
+ * @return void
+ *
+ * @note only the size and the hart change are coded when a fetch follows on
+ ********************************************************************************/
+void memtrace_writer::access(uint32_t hart, uint64_t addr, uint32_t len, kind k)
+{
+    if(!os.is_open())
+        return;
+    if(hart >= harts.size())
+        harts.resize(hart + 1);
+    hart_state &hs = harts[hart];
+
+    uint8_t size = tag_size_varint;
+    if(len && (len & (len - 1)) == 0 && len < (1u << tag_size_varint))
+        for(size = 0; (1u << size) != len; ++size)
+            ;
+    uint8_t tag = k | (size << tag_size_shift);
+    if(hart != cur_hart)
+        tag |= tag_hart;
+    uint64_t expect = (k == fetch) ? hs.next_fetch : hs.last_data;
+    if(k == fetch && addr == expect)
+        tag |= tag_seq;
+
+    buf += (char)tag;
+    if(tag & tag_hart)
+        put_varint(hart);
+    if(size == tag_size_varint)
+        put_varint(len);
+    if(!(tag & tag_seq))
+    {
+        int64_t delta = addr - expect;
+        put_varint(((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63));     // zigzag, small either way
+    }
+
+    cur_hart = hart;
+    if(k == fetch)
+        hs.next_fetch = addr + len;
+    else
+        hs.last_data = addr;
+    ++records;
+    if(buf.size() >= block_size)
+        flush();
+}
+
+/**
+ * Writes out the buffered bytes
+ * @return void
+ ********************************************************************************/
+void memtrace_writer::flush()
+{
+    os.write(buf.data(), buf.size());
+    bytes += buf.size();
+    buf.clear();
+}
+
+/**
+ * Writes what is left and closes the file
+ * @return void
+ ********************************************************************************/
+void memtrace_writer::finish()
+{
+    if(!os.is_open())
+        return;
+    flush();
+    os.close();
+}
+
+/**
+ * Opens a trace and checks the header
+ * @return bool false if it can't be read or is not a trace
+ *
+* @param fname the trace file
+ ********************************************************************************/
+bool memtrace_reader::open(const std::string &fname)
+{
+    is.open(fname, std::ios::in|std::ios::binary);
+    if(!is.is_open())
+        return false;
+    buf.resize(block_size);
+    pos = end = 0;
+    harts.clear();
+    cur_hart = 0;
+    bad = false;
+
+    char hdr[sizeof(magic)];
+    for(size_t i = 0; i < sizeof(hdr); ++i)
+    {
+        uint8_t b;
+        if(!get_byte(b))
+        {
+            bad = true;
+            return false;
+        }
+        hdr[i] = b;
+    }
+    bad = std::memcmp(hdr, magic, sizeof(magic)) != 0;
+    return !bad;
+}
+
+/**
+ * Reads the next block of the file
+ * @return bool false at the end of the file
+ ********************************************************************************/
+bool memtrace_reader::fill()
+{
+    is.read(buf.data(), buf.size());
+    pos = 0;
+    end = is.gcount();
+    return end != 0;
+}
+
+bool memtrace_reader::get_byte(uint8_t &b)
+{
+    if(pos == end && !fill())
+        return false;
+    b = buf[pos++];
+    return true;
+}
+
+/**
+ * Reads an unsigned LEB128 number
+ * @return bool false if the file ends inside it
+ ********************************************************************************/
+bool memtrace_reader::get_varint(uint64_t &v)
+{
+    v = 0;
+    uint8_t b;
+    for(unsigned shift = 0; shift < 64; shift += 7)
+    {
+        if(!get_byte(b))
+            return false;
+        v |= (uint64_t)(b & 0x7f) << shift;
+        if(!(b & 0x80))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * Decodes the next access
+ * @return bool false at the end of the trace, or if it is bad
+ *
+* @param r where the access goes
+ ********************************************************************************/
+bool memtrace_reader::next(record &r)
+{
+    uint8_t tag;
+    if(bad || !get_byte(tag))
+        return false;
+    uint64_t v = 0;
+    if((tag & tag_kind) > mem_observer::store || (tag & 0x80)
+        || ((tag & tag_hart) && (!get_varint(v) || v >= max_harts)))
+    {
+        bad = true;
+        return false;
+    }
+    if(tag & tag_hart)
+        cur_hart = v;
+    r.hart = cur_hart;
+    r.k = (mem_observer::kind)(tag & tag_kind);
+
+    uint8_t size = (tag >> tag_size_shift) & 7;
+    if(size != tag_size_varint)
+        r.len = 1u << size;
+    else if(get_varint(v))
+        r.len = v;
+    else
+    {
+        bad = true;
+        return false;
+    }
+
+    if(r.hart >= harts.size())
+        harts.resize(r.hart + 1);
+    hart_state &hs = harts[r.hart];
+    uint64_t expect = (r.k == mem_observer::fetch) ? hs.next_fetch : hs.last_data;
+    if(tag & tag_seq)
+        r.addr = expect;
+    else if(get_varint(v))
+        r.addr = expect + ((v >> 1) ^ (0 - (v & 1)));
+    else
+    {
+        bad = true;
+        return false;
+    }
+
+    if(r.k == mem_observer::fetch)
+        hs.next_fetch = r.addr + r.len;
+    else
+        hs.last_data = r.addr;
+    return true;
+}
@@ -0,0 +1,91 @@
+#ifndef MEMTRACE_H
+#define MEMTRACE_H
+#include <vector>
+#include <fstream>
+#include <string>
+#include "mem_observer.h"
+
+// A compact binary trace of every fetch, load and store the harts make, for
+// cache and prefetcher studies that replay it instead of running the guest.
+//
+// The file starts with the 8 bytes "RVMTRC" 1 0 (the last two are the version
+// and a reserved byte).  Each access is a tag byte, then the fields the tag
+// says are there:
+//
+//     bits 0-1  kind, 0 fetch, 1 load, 2 store
+//     bits 2-4  size, 1 << n bytes for n < 7; 7 means a varint size follows
+//     bit  5    a varint hart number follows, the hart changed
+//     bit  6    a fetch that follows the last fetch of its hart, no address
+//
+// Without bit 6 a zigzag varint follows with the address minus the one
+// expected: the end of the hart's last fetch for a fetch, or the hart's last
+// load or store address for a load or store.  Varints are little endian base
+// 128.  A straight line fetch takes one byte and most data accesses two or
+// three, against the 40 or more of an -i trace line.
+class memtrace_writer : public mem_observer
+{
+    public:
+        ~memtrace_writer() { finish(); }
+
+        bool open(const std::string &fname);
+        void access(uint32_t hart, uint64_t addr, uint32_t len, kind k) override;
+        void finish();
+
+        uint64_t get_records() const { return records; }
+        uint64_t get_bytes() const { return bytes; }
+
+    private:
+        struct hart_state
+        {
+            uint64_t next_fetch = { 0 };        ///< where a straight line fetch would be
+            uint64_t last_data = { 0 };         ///< the last load or store address
+        };
+
+        void put_varint(uint64_t v);
+        void flush();
+
+        std::ofstream os;
+        std::string buf;                        ///< written out in large blocks
+        std::vector<hart_state> harts;
+        uint32_t cur_hart = { 0 };
+        uint64_t records = { 0 };
+        uint64_t bytes = { 0 };
+};
+
+// Reads a trace back one access at a time
+class memtrace_reader
+{
+    public:
+        struct record
+        {
+            uint32_t hart;
+            uint64_t addr;
+            uint32_t len;
+            mem_observer::kind k;
+        };
+
+        bool open(const std::string &fname);
+        bool next(record &r);
+        bool is_bad() const { return bad; }
+
+    private:
+        struct hart_state
+        {
+            uint64_t next_fetch = { 0 };
+            uint64_t last_data = { 0 };
+        };
+
+        bool fill();
+        bool get_byte(uint8_t &b);
+        bool get_varint(uint64_t &v);
+
+        std::ifstream is;
+        std::vector<char> buf;
+        size_t pos = { 0 };
+        size_t end = { 0 };
+        std::vector<hart_state> harts;
+        uint32_t cur_hart = { 0 };
+        bool bad = { false };                   ///< the file is not a trace or ends inside a record
+};
+
+#endif
@@ -0,0 +1,252 @@
+#include "mesi.h"
+#include "hex.h"
+#include <algorithm>
+#include <iomanip>
+#include <cassert>
+
+/**
+ * Makes empty caches for each hart
+ *
+* @param harts how many harts, at most max_harts
+* @param cache_size bytes in each L1
+* @param ways associativity
+* @param line_size bytes per line, a power of 2 no bigger than 64
+ ********************************************************************************/
+mesi_model::mesi_model(unsigned harts, uint32_t cache_size, unsigned ways, uint32_t line_size)
+    : nharts(harts), nways(ways), line_size(line_size)
+{
+    assert(harts >= 1 && harts <= max_harts && "a sharer mask is a uint64_t");
+    assert(line_size <= 64 && (line_size & (line_size - 1)) == 0 && "a byte mask is a uint64_t");
+    nsets = std::max(1u, cache_size / (ways * line_size));
+    this->ways.resize((size_t)harts * nsets * ways);
+    hstats.resize(harts);
+}
+
+/**
+ * Splits an access into the lines it touches
+ * @return void
+ *
+* @param hart the hart making the access, ignored if there is no cache for it
+* @param addr the first byte
+* @param len the number of bytes
+* @param k fetches and loads read the line, stores need it exclusive
+ ********************************************************************************/
+void mesi_model::access(uint32_t hart, uint64_t addr, uint32_t len, kind k)
+{
+    if(hart >= nharts || len == 0)
+        return;
+
+    uint64_t end = addr + len;
+    for(uint64_t line = addr / line_size; line * line_size < end; ++line)
+    {
+        uint64_t base = line * line_size;
+        uint32_t lo = std::max(addr, base) - base;
+        uint32_t hi = std::min<uint64_t>(end, base + line_size) - base;
+        uint64_t mask = (hi - lo == 64) ? ~0ull : ((1ull << (hi - lo)) - 1) << lo;
+        access_line(hart, line, mask, k);
+    }
+}
+
+/**
+ * One access to one line, with the MESI transitions
+ * @return void
+ *
+* @param hart the hart making the access
+* @param line the line number
+* @param mask the bytes of the line being accessed
+* @param k the kind of access
+ ********************************************************************************/
+void mesi_model::access_line(uint32_t hart, uint64_t line, uint64_t mask, kind k)
+{
+    uint64_t bit = 1ull << hart;
+    hart_stats &hs = hstats[hart];
+    line_stats &ls = directory[line];
+    way *w = lookup(hart, line);
+
+    ++tick;
+    ++hs.accesses;
+    if(k != store)
+    {
+        ls.readers |= bit;
+        if(w)
+            ++hs.hits;
+        else
+        {
+            ++hs.misses;
+            ++bus_rd;
+            uint64_t others = ls.sharers & ~bit;
+            if(others)                          // another cache supplies it, everyone ends up in S
+            {
+                ++ls.transfers;
+                for(uint32_t o = 0; o < nharts; ++o)
+                    if(others & (1ull << o))
+                    {
+                        way *ow = lookup(o, line);
+                        if(ow->st == M)
+                            ++writebacks;
+                        ow->st = S;
+                    }
+            }
+            w = &fill(hart, line);
+            w->st = others ? S : E;
+            ls.sharers |= bit;
+        }
+    }
+    else
+    {
+        ls.writers |= bit;
+        if(w && w->st != S)                     // M, or E which goes to M without a bus request
+            ++hs.hits;
+        else if(w)
+        {
+            ++hs.hits;
+            ++hs.upgrades;
+            ++bus_upgr;
+            invalidate_others(hart, line, mask, ls);
+        }
+        else
+        {
+            ++hs.misses;
+            ++bus_rdx;
+            if(ls.sharers & ~bit)
+                ++ls.transfers;
+            invalidate_others(hart, line, mask, ls);
+            w = &fill(hart, line);
+            ls.sharers |= bit;
+        }
+        w->st = M;
+    }
+    w->lru = tick;
+    w->touched |= mask;
+}
+
+/**
+ * Finds a line in a hart's cache
+ * @return way* or nullptr on a miss
+ ********************************************************************************/
+mesi_model::way *mesi_model::lookup(uint32_t hart, uint64_t line)
+{
+    way *set = &ways[((size_t)hart * nsets + line % nsets) * nways];
+    for(unsigned i = 0; i < nways; ++i)
+        if(set[i].st != I && set[i].line == line)
+            return &set[i];
+    return nullptr;
+}
+
+/**
+ * Makes room for a line, evicting the least recently used one if the set is full
+ * @return way& the way for the line, in state I
+ ********************************************************************************/
+mesi_model::way &mesi_model::fill(uint32_t hart, uint64_t line)
+{
+    way *set = &ways[((size_t)hart * nsets + line % nsets) * nways];
+    way *victim = &set[0];
+    for(unsigned i = 0; i < nways && victim->st != I; ++i)
+        if(set[i].st == I || set[i].lru < victim->lru)
+            victim = &set[i];
+
+    if(victim->st != I)
+    {
+        ++hstats[hart].evictions;
+        if(victim->st == M)
+            ++writebacks;
+        directory[victim->line].sharers &= ~(1ull << hart);
+    }
+    *victim = way();
+    victim->line = line;
+    return *victim;
+}
+
+/**
+ * Takes a line away from every other cache holding it
+ * @return void
+ *
+* @param hart the hart that is storing
+* @param line the line number
+* @param mask the bytes being stored
+* @param ls the directory entry for the line
+ ********************************************************************************/
+void mesi_model::invalidate_others(uint32_t hart, uint64_t line, uint64_t mask, line_stats &ls)
+{
+    uint64_t others = ls.sharers & ~(1ull << hart);
+    for(uint32_t o = 0; o < nharts; ++o)
+        if(others & (1ull << o))
+        {
+            way *ow = lookup(o, line);
+            if(ow->st == M)
+                ++writebacks;
+            ++ls.invalidations;
+            ++hstats[o].invalidated;
+            if(!(ow->touched & mask))           // the other hart never used these bytes
+                ++ls.false_sharing;
+            *ow = way();
+        }
+    ls.sharers &= (1ull << hart);
+}
+
+/**
+ * Renders a hart bit mask as a list of hart numbers
+ * @return std::string
+ ********************************************************************************/
+static std::string render_harts(uint64_t mask)
+{
+    std::string s;
+    for(uint32_t h = 0; h < 64; ++h)
+        if(mask & (1ull << h))
+            s += (s.empty() ? "" : ",") + std::to_string(h);
+    return s.empty() ? "-" : s;
+}
+
+/**
+ * Prints the per hart counts, the bus traffic and the lines with the most
+ * invalidations, false sharing first
+ * @return void
+ *
+* @param os where to print
+* @param hot_lines how many lines to list
+ ********************************************************************************/
+void mesi_model::report(std::ostream &os, unsigned hot_lines) const
+{
+    os << "MESI: " << nharts << " harts, " << (nsets * nways * line_size / 1024) << "K " << nways
+        << "-way L1s, " << line_size << " byte lines" << std::endl;
+    os << "hart    accesses        hits      misses    hit%  upgrades  invalidated  evictions" << std::endl;
+    for(uint32_t h = 0; h < nharts; ++h)
+    {
+        const hart_stats &hs = hstats[h];
+        os << std::right << std::setw(4) << h << std::setw(12) << hs.accesses << std::setw(12) << hs.hits
+            << std::setw(12) << hs.misses << std::setw(8) << std::fixed << std::setprecision(2)
+            << (hs.accesses ? 100.0 * hs.hits / hs.accesses : 0.0) << std::setw(10) << hs.upgrades
+            << std::setw(13) << hs.invalidated << std::setw(11) << hs.evictions << std::endl;
+    }
+    os << "bus: " << bus_rd << " reads, " << bus_rdx << " read-exclusives, " << bus_upgr << " upgrades, "
+        << writebacks << " writebacks" << std::endl;
+
+    std::vector<std::pair<uint64_t, const line_stats*>> hot;
+    for(const auto &e : directory)
+        if(e.second.invalidations)
+            hot.emplace_back(e.first, &e.second);
+    std::sort(hot.begin(), hot.end(), [](const std::pair<uint64_t, const line_stats*> &a,
+        const std::pair<uint64_t, const line_stats*> &b)
+    {
+        if(a.second->false_sharing != b.second->false_sharing)
+            return a.second->false_sharing > b.second->false_sharing;
+        if(a.second->invalidations != b.second->invalidations)
+            return a.second->invalidations > b.second->invalidations;
+        return a.first < b.first;
+    });
+    if(hot.size() > hot_lines)
+        hot.resize(hot_lines);
+
+    os << "sharing hot spots (" << hot.size() << " lines):" << std::endl;
+    if(hot.empty())
+        return;
+    os << "line          invals     false  transfers  readers  writers" << std::endl;
+    for(const auto &e : hot)
+    {
+        uint64_t addr = e.first * line_size;
+        os << std::left << std::setw(12) << (addr >> 32 ? hex::to_hex0x64(addr) : hex::to_hex0x32(addr)) << std::right
+            << std::setw(8) << e.second->invalidations << std::setw(10) << e.second->false_sharing
+            << std::setw(11) << e.second->transfers << "  " << std::left << std::setw(9)
+            << render_harts(e.second->readers) << render_harts(e.second->writers) << std::right << std::endl;
+    }
+}
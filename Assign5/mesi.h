@@ -0,0 +1,82 @@
+#ifndef MESI_H
+#define MESI_H
+#include <vector>
+#include <unordered_map>
+#include <iostream>
+#include "mem_observer.h"
+
+// Private L1 caches kept coherent with MESI, one per hart, over the shared
+// memory.  A directory holds the sharers of every line so a miss or an upgrade
+// only goes to the caches that have the line, the way a snoop filter would.
+// Nothing is timed; the model counts hits, misses, bus requests, invalidations,
+// writebacks and cache to cache transfers.
+//
+// To find false sharing each cache remembers which bytes of a line its hart
+// touched while it held the line.  An invalidation caused by a store to bytes
+// the victim never touched is counted as false sharing.
+class mesi_model : public mem_observer
+{
+    public:
+        mesi_model(unsigned harts, uint32_t cache_size = default_cache_size,
+            unsigned ways = default_ways, uint32_t line_size = default_line_size);
+
+        void access(uint32_t hart, uint64_t addr, uint32_t len, kind k) override;
+        void report(std::ostream &os, unsigned hot_lines = 10) const;
+
+        static constexpr uint32_t default_cache_size = 32 * 1024;
+        static constexpr unsigned default_ways = 4;
+        static constexpr uint32_t default_line_size = 64;     ///< at most 64, a byte mask is a uint64_t
+        static constexpr unsigned max_harts = 64;             ///< a sharer mask is a uint64_t
+
+    private:
+        enum state { I, S, E, M };
+
+        struct way
+        {
+            uint64_t line = { 0 };              ///< address / line_size
+            state st = { I };
+            uint64_t lru = { 0 };               ///< last use, smallest is the victim
+            uint64_t touched = { 0 };           ///< bytes the hart used since it got the line
+        };
+
+        struct hart_stats
+        {
+            uint64_t accesses = { 0 };
+            uint64_t hits = { 0 };
+            uint64_t misses = { 0 };
+            uint64_t upgrades = { 0 };          ///< stores that hit a shared line
+            uint64_t invalidated = { 0 };       ///< lines taken away by other harts
+            uint64_t evictions = { 0 };
+        };
+
+        struct line_stats
+        {
+            uint64_t sharers = { 0 };           ///< bit per hart holding the line
+            uint64_t readers = { 0 };           ///< bit per hart that ever loaded or fetched it
+            uint64_t writers = { 0 };           ///< bit per hart that ever stored to it
+            uint64_t invalidations = { 0 };
+            uint64_t false_sharing = { 0 };
+            uint64_t transfers = { 0 };         ///< misses served by another cache
+        };
+
+        void access_line(uint32_t hart, uint64_t line, uint64_t mask, kind k);
+        way *lookup(uint32_t hart, uint64_t line);
+        way &fill(uint32_t hart, uint64_t line);
+        void invalidate_others(uint32_t hart, uint64_t line, uint64_t mask, line_stats &ls);
+
+        unsigned nharts;
+        unsigned nsets;
+        unsigned nways;
+        uint32_t line_size;
+        std::vector<way> ways;                  ///< [hart][set][way]
+        std::vector<hart_stats> hstats;
+        std::unordered_map<uint64_t, line_stats> directory;
+        uint64_t tick = { 0 };
+
+        uint64_t bus_rd = { 0 };                ///< read misses
+        uint64_t bus_rdx = { 0 };               ///< write misses
+        uint64_t bus_upgr = { 0 };              ///< S to M
+        uint64_t writebacks = { 0 };            ///< M lines flushed by eviction or snoop
+};
+
+#endif
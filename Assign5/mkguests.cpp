@@ -0,0 +1,382 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <getopt.h>
+#include "rv32i_asm.h"
+
+// Writes the guest images the golden tests in testdata run.  They are built
+// with rv32i_asm so they can be remade without a RISC-V toolchain:
+//
+//     mkguests testdata                every RV32 guest
+//     mkguests testdata muldiv         just muldiv.bin
+//     mkguests -x 64 testdata64        the guests for rv64i
+//
+// Each guest exercises the corner cases of one extension and ends with an
+// ebreak.  The golden outputs next to the images were made by running rv32i
+// on them and checking every result by hand.
+
+typedef rv32i_asm a;
+
+/**
+ * RV32M, including division by zero and the signed overflow case
+ * @return void
+ *
+* @param as the assembler
+ ********************************************************************************/
+static void build_muldiv(rv32i_asm &as)
+{
+    as.li(a::a0, 7);
+    as.li(a::a1, -3);
+    as.li(a::s0, 0x80000000);               // the most negative value
+    as.li(a::s1, -1);
+
+    as.mul(a::t0, a::a0, a::a1);
+    as.mul(a::t1, a::s0, a::s1);            // wraps back to 0x80000000
+    as.mulh(a::t2, a::s0, a::s1);
+    as.mulh(a::t3, a::a0, a::a1);
+    as.mulhsu(a::t4, a::s0, a::s1);
+    as.mulhsu(a::t5, a::a1, a::a0);
+    as.mulhu(a::t6, a::s0, a::s1);
+    as.mulhu(a::a2, a::s1, a::s1);
+
+    as.div(a::a3, a::a0, a::a1);            // rounds towards zero
+    as.div(a::a4, a::a1, a::a0);
+    as.divu(a::a5, a::a1, a::a0);
+    as.rem(a::a6, a::a0, a::a1);            // takes the sign of the dividend
+    as.rem(a::a7, a::a1, a::a0);
+    as.remu(a::s2, a::a1, a::a0);
+
+    as.div(a::s3, a::a0, a::zero);          // by zero: all ones
+    as.divu(a::s4, a::a0, a::zero);
+    as.rem(a::s5, a::a0, a::zero);          // by zero: the dividend
+    as.remu(a::s6, a::a1, a::zero);
+
+    as.div(a::s7, a::s0, a::s1);            // overflow: the dividend
+    as.rem(a::t0, a::s0, a::s1);            // overflow: 0
+    as.divu(a::t1, a::s0, a::s1);
+    as.remu(a::t2, a::s0, a::s1);
+    as.ebreak();
+}
+
+/**
+ * Zba and Zbb, with the zero and wrap around cases of the counts and rotates
+ * @return void
+ *
+* @param as the assembler
+ ********************************************************************************/
+static void build_bitmanip(rv32i_asm &as)
+{
+    as.li(a::a0, 0x12345680);
+    as.li(a::a1, -5);
+    as.li(a::a2, 0x00f0ff01);
+    as.li(a::a3, 0x80);
+    as.li(a::a4, 0x8001);
+    as.li(a::a5, 36);                       // rotates by 4
+
+    as.sh1add(a::t0, a::a0, a::a1);
+    as.sh2add(a::t1, a::a0, a::a1);
+    as.sh3add(a::t2, a::a1, a::a0);
+
+    as.andn(a::t3, a::a0, a::a2);
+    as.orn(a::t4, a::a0, a::a2);
+    as.xnor(a::t5, a::a0, a::a2);
+
+    as.min(a::t6, a::a0, a::a1);
+    as.minu(a::s0, a::a0, a::a1);
+    as.max(a::s1, a::a0, a::a1);
+    as.maxu(a::s2, a::a0, a::a1);
+
+    as.rol(a::s3, a::a0, a::a5);
+    as.ror(a::s4, a::a0, a::a5);
+    as.rori(a::s5, a::a0, 12);
+    as.rol(a::s6, a::a0, a::zero);
+
+    as.clz(a::s7, a::a0);
+    as.clz(a::s8, a::zero);                 // 32
+    as.ctz(a::s9, a::a0);
+    as.ctz(a::s10, a::zero);                // 32
+    as.cpop(a::s11, a::a1);
+    as.cpop(a::a6, a::zero);
+
+    as.rev8(a::a7, a::a0);
+    as.orc_b(a::t0, a::a2);
+    as.sext_b(a::t1, a::a3);
+    as.sext_b(a::t2, a::a4);
+    as.sext_h(a::t3, a::a4);
+    as.zext_h(a::t4, a::a1);
+    as.ebreak();
+}
+
+/**
+ * The counter and floating point CSRs through all six csr instructions.  It
+ * ends with a write to the read-only cycle, which is illegal
+ * @return void
+ *
+* @param as the assembler
+ ********************************************************************************/
+static void build_csr(rv32i_asm &as)
+{
+    as.csrrs(a::a0, a::csr_cycle, a::zero);     // instructions retired before this one
+    as.csrrs(a::a1, a::csr_instret, a::zero);
+    as.li(a::t0, 1000);
+    as.csrrw(a::a2, a::csr_mcycle, a::t0);
+    as.csrrs(a::a3, a::csr_cycle, a::zero);     // counts on from what was written
+    as.csrrs(a::a4, a::csr_mcycle, a::zero);
+    as.csrrwi(a::a5, a::csr_minstret, 5);
+    as.csrrs(a::a6, a::csr_instret, a::zero);
+    as.csrrsi(a::a7, a::csr_minstret, 0x10);
+    as.csrrs(a::s0, a::csr_minstret, a::zero);
+    as.csrrci(a::s1, a::csr_mcycle, 3);
+    as.csrrs(a::s2, a::csr_cycle, a::zero);
+    as.csrrwi(a::s3, a::csr_mcycleh, 1);
+    as.csrrs(a::s4, a::csr_cycleh, a::zero);
+    as.csrrc(a::s5, a::csr_instreth, a::zero);  // rs1 zero, no write
+
+    as.csrrwi(a::s6, a::csr_frm, rv32i_asm::rm_rmm);
+    as.csrrsi(a::s7, a::csr_fflags, 0x5);
+    as.csrrci(a::t1, a::csr_fflags, 0x1);
+    as.csrrs(a::t2, a::csr_fcsr, a::zero);
+    as.li(a::t3, 0xff);                         // frm and fflags are all that fit
+    as.csrrw(a::t4, a::csr_fcsr, a::t3);
+    as.csrrci(a::t5, a::csr_frm, 0);
+    as.csrrc(a::t6, a::csr_fflags, a::t3);
+    as.csrrs(a::s8, a::csr_fcsr, a::zero);
+
+    as.csrrw(a::s9, a::csr_cycle, a::t0);
+    as.ebreak();
+}
+
+/**
+ * Writes hello to stdout and exits with status 7, run with -s
+ * @return void
+ *
+* @param as the assembler
+ ********************************************************************************/
+static void build_hello(rv32i_asm &as)
+{
+    as.li(a::t0, 0x100);
+    as.li(a::t1, 0x6c6c6568);                   // "hell"
+    as.sw(a::t1, a::t0, 0);
+    as.li(a::t1, 0x0a6f);                       // "o\n"
+    as.sw(a::t1, a::t0, 4);
+
+    as.li(a::a0, 1);
+    as.mv(a::a1, a::t0);
+    as.li(a::a2, 6);
+    as.li(a::a7, 64);                           // write
+    as.ecall();
+    as.li(a::a0, 7);
+    as.li(a::a7, 93);                           // exit
+    as.ecall();
+}
+
+/**
+ * RVV loads, stores, arithmetic and reductions.  VLEN is 128, so with vl 7
+ * at e32 and LMUL 2, e8 with vl 19 and e16 with vl 11 the host SSE loop does
+ * one 16 byte block and the scalar loop does the rest.  Data at 0x200,
+ * results stored from 0x240 every 0x20 bytes, the reductions in v24 to v31
+ * @return void
+ *
+* @param as the assembler
+ ********************************************************************************/
+static void build_vector(rv32i_asm &as)
+{
+    static const int32_t data[] = { 1, -2, 0x7fffffff, (int32_t)0x80000000, 0x12345678, 16, -1, 0xabcd };
+
+    as.li(a::t0, 0x200);
+    for(unsigned i = 0; i < 8; ++i)
+    {
+        as.li(a::t2, data[i]);
+        as.sw(a::t2, a::t0, i*4);
+    }
+    as.addi(a::t1, a::t0, 4);
+    as.li(a::a2, 0x100);
+    as.li(a::a3, 0x10203);
+    as.li(a::a4, 0x83);
+
+    as.li(a::a0, 7);
+    as.vsetvli(a::a1, a::a0, rv32i_asm::vtype(32, 2));
+    as.vle32(2, a::t0);
+    as.vle32(4, a::t1);                     // the same data one element on
+    as.vadd_vv(6, 2, 4);
+    as.vsub_vv(8, 2, 4);
+    as.vand_vv(10, 2, 4);
+    as.vor_vv(12, 2, 4);
+    as.vxor_vv(14, 2, 4);
+    as.vmul_vv(16, 2, 4);
+    as.vadd_vx(18, 2, a::a2);
+    as.vsub_vx(20, 2, a::a2);
+    as.vmul_vx(22, 2, a::a3);
+    as.vadd_vi(24, 2, -16);
+    as.vand_vi(26, 2, 15);
+    as.vxor_vi(28, 2, -1);
+
+    as.li(a::t3, 0x240);
+    for(uint32_t v = 6; v <= 28; v += 2)
+    {
+        as.vse32(v, a::t3);
+        as.addi(a::t3, a::t3, 0x20);
+    }
+
+    as.vredsum_vs(24, 2, 4);                // v4[0] is the start value
+    as.vredand_vs(25, 4, 2);
+    as.vredor_vs(26, 4, 2);
+    as.vredxor_vs(27, 2, 4);
+    as.vredminu_vs(28, 2, 4);
+    as.vredmin_vs(29, 2, 4);
+    as.vredmaxu_vs(30, 2, 4);
+    as.vredmax_vs(31, 2, 4);
+
+    as.vsetivli(a::a5, 19, rv32i_asm::vtype(8, 2));
+    as.vle8(2, a::t0);
+    as.vadd_vx(6, 2, a::a4);
+    as.vmul_vv(8, 2, 2);                    // no SSE multiply for bytes
+    as.vredsum_vs(17, 2, 2);
+    as.vse8(6, a::t3);
+
+    as.vsetivli(a::a6, 11, rv32i_asm::vtype(16, 2));
+    as.vle16(2, a::t0);
+    as.vmul_vv(10, 2, 2);
+    as.vredxor_vs(19, 2, 2);
+    as.addi(a::t3, a::t3, 0x20);
+    as.vse16(10, a::t3);
+
+    as.li(a::a7, rv32i_asm::vtype(64, 2));
+    as.vsetvl(a::s0, a::zero, a::a7);       // vl = VLMAX = 4
+    as.vle64(2, a::t0);
+    as.vadd_vv(12, 2, 2);
+    as.vredsum_vs(21, 2, 2);
+    as.addi(a::t3, a::t3, 0x20);
+    as.vse64(12, a::t3);
+
+    as.li(a::a7, 0x100);
+    as.vsetvl(a::s1, a::a0, a::a7);         // reserved vtype sets vill and vl 0
+    as.ebreak();
+}
+
+/**
+ * The RV64I word instructions and doubleword loads and stores, data at 0x100
+ * @return void
+ *
+* @param as the assembler
+ ********************************************************************************/
+static void build_rv64(rv32i_asm &as)
+{
+    as.lui(a::a0, 0x80000);
+    as.addiw(a::a0, a::a0, -1);             // 0x7fffffff, li would give 0xffffffff7fffffff
+    as.addiw(a::a1, a::a0, 1);              // wraps to 0xffffffff80000000
+    as.addi(a::a2, a::a0, 1);               // 0x0000000080000000
+    as.li(a::a3, -1);
+    as.li(a::a4, 33);                       // sllw only uses 5 bits
+
+    as.sllw(a::a5, a::a3, a::a4);
+    as.sllw(a::a6, a::a2, a::a4);           // the carry out of bit 31 is lost
+    as.srlw(a::a7, a::a1, a::a4);
+    as.sraw(a::s0, a::a1, a::a4);
+    as.addw(a::s1, a::a0, a::a0);
+    as.subw(a::s2, a::zero, a::a2);
+    as.slliw(a::s3, a::a0, 4);
+    as.srliw(a::s4, a::a3, 4);
+    as.sraiw(a::s5, a::a2, 4);
+
+    as.sd(a::a1, a::zero, 0x100);
+    as.sd(a::a0, a::zero, 0x108);
+    as.ld(a::s6, a::zero, 0x100);
+    as.ld(a::s7, a::zero, 0x104);           // straddles the two
+    as.lw(a::t0, a::zero, 0x104);           // sign extended
+    as.lwu(a::t1, a::zero, 0x104);
+    as.ebreak();
+}
+
+struct guest
+{
+    const char *name;
+    void (*build)(rv32i_asm &);
+    unsigned xlen;                          ///< rv32i or rv64i runs it
+};
+
+static const guest guests[] =
+{
+    { "muldiv",  build_muldiv, 32 },
+    { "bitmanip",  build_bitmanip, 32 },
+    { "vector",  build_vector, 32 },
+    { "csr",  build_csr, 32 },
+    { "hello",  build_hello, 32 },
+    { "rv64",  build_rv64, 64 },
+};
+
+/**
+ * Print a usage message and abort the program.
+ *
+ ********************************************************************************/
+static void usage()
+{
+    std::cerr << "Usage: mkguests [-x xlen] dir [guest...]" << std::endl;
+    std::cerr << "    writes each guest to dir as <guest>.bin" << std::endl;
+    std::cerr << "    -x only the guests for 32 or 64-bit registers (default 32)" << std::endl;
+    std::cerr << "    guests:";
+    for(const auto &g : guests)
+        std::cerr << " " << g.name << "(" << g.xlen << ")";
+    std::cerr << std::endl;
+    exit(1);
+}
+
+/**
+ * Writes the selected guests
+ *
+* @param argc an int for the argument count
+* @param argv a char for the argument values
+ * @return int 1 if a file could not be written
+ *
+ ********************************************************************************/
+int main(int argc, char **argv)
+{
+    unsigned xlen = 32;
+    int opt;
+    while((opt = getopt(argc, argv, "x:")) != -1)
+    {
+        switch(opt)
+        {
+            case 'x':
+                xlen = std::stoul(optarg);
+                break;
+            default:
+                usage();
+        }
+    }
+    if((xlen != 32 && xlen != 64) || optind >= argc)
+        usage();
+    std::string dir = argv[optind];
+
+    std::vector<const guest*> selected;
+    for(int i = optind + 1; i < argc; ++i)
+    {
+        auto it = std::find_if(std::begin(guests), std::end(guests),
+            [&](const guest &g) { return argv[i] == std::string(g.name); });
+        if(it == std::end(guests) || it->xlen != xlen)
+        {
+            std::cerr << "Unknown " << xlen << "-bit guest " << argv[i] << std::endl;
+            usage();
+        }
+        selected.push_back(&*it);
+    }
+    if(selected.empty())
+        for(const auto &g : guests)
+            if(g.xlen == xlen)
+                selected.push_back(&g);
+
+    for(const guest *g : selected)
+    {
+        rv32i_asm as;
+        g->build(as);
+        std::string fname = dir + "/" + g->name + ".bin";
+        if(!as.save(fname))
+        {
+            std::cerr << "Can't write file '" << fname << "'" << std::endl;
+            return 1;
+        }
+        std::cout << fname << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <unordered_set>
+#include <algorithm>
+#include <getopt.h>
+#include "memtrace.h"
+#include "hex.h"
+
+// Prints a trace written by rv32i -T as text, or just counts what is in it.
+// It is also the example of reading a trace with memtrace_reader.
+
+/**
+ * Print a usage message and abort the program.
+ *
+ ********************************************************************************/
+static void usage()
+{
+    std::cerr << "Usage: mtdump [-s] [-n count] [-l line-size] trace-file" << std::endl;
+    std::cerr << "    -s only print the summary" << std::endl;
+    std::cerr << "    -n print at most this many accesses" << std::endl;
+    std::cerr << "    -l line size for the distinct line count (default 64)" << std::endl;
+    exit(1);
+}
+
+/**
+ * Reads the trace and prints it
+ *
+* @param argc an int for the argument count
+* @param argv a char for the argument values
+ * @return int
+ *
+ ********************************************************************************/
+int main(int argc, char **argv)
+{
+    bool summary_only = false;
+    uint64_t limit = ~0ull;
+    uint32_t line_size = 64;
+    int opt;
+    while((opt = getopt(argc, argv, "sn:l:")) != -1)
+    {
+        switch(opt)
+        {
+            case 's':
+            {
+                summary_only = true;
+            }
+            break;
+            case 'n':
+            {
+                std::istringstream iss(optarg);
+                iss >> std::dec >> limit;
+            }
+            break;
+            case 'l':
+            {
+                std::istringstream iss(optarg);
+                iss >> std::dec >> line_size;
+                if(line_size == 0)
+                    usage();
+            }
+            break;
+            default:
+                usage();
+        }
+    }
+    if(optind != argc - 1)
+        usage();
+
+    memtrace_reader in;
+    if(!in.open(argv[optind]))
+    {
+        std::cerr << "Can't read trace " << argv[optind] << std::endl;
+        return 1;
+    }
+
+    static const char kind_name[] = { 'F', 'L', 'S' };
+    uint64_t count[3] = { 0, 0, 0 };
+    uint64_t records = 0;
+    uint32_t harts = 0;
+    std::unordered_set<uint64_t> lines;
+    memtrace_reader::record r;
+    while(in.next(r))
+    {
+        if(!summary_only && records < limit)
+            std::cout << r.hart << " " << kind_name[r.k] << " "
+                << (r.addr >> 32 ? hex::to_hex0x64(r.addr) : hex::to_hex0x32(r.addr)) << " " << r.len << "\n";
+        ++records;
+        ++count[r.k];
+        harts = std::max(harts, r.hart + 1);
+        lines.insert(r.addr / line_size);
+    }
+    if(in.is_bad())
+    {
+        std::cerr << "Bad trace " << argv[optind] << " after " << records << " accesses" << std::endl;
+        return 1;
+    }
+
+    std::cout << records << " accesses on " << harts << " harts: " << count[0] << " fetches, " << count[1]
+        << " loads, " << count[2] << " stores, " << lines.size() << " distinct " << line_size
+        << " byte lines" << std::endl;
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <dirent.h>
+#include "rv32i_predecode.h"
+#include "memory.h"
+#include "hex.h"
+
+// Checks the predecoder against memory's own get32 over random words and over
+// every image in a testdata directory.  Each run uses every length up to a few
+// dozen words as well as the whole buffer, so short regions are covered too.
+
+/**
+ * Compares the predecoded words with the words expected
+ * @return unsigned the number of wrong words
+ ********************************************************************************/
+static unsigned check(const rv32i_predecode &pd, const std::vector<uint32_t> &words)
+{
+    if(pd.size() != words.size())
+    {
+        std::cout << "predecoded " << pd.size() << " words, expected " << words.size() << std::endl;
+        return words.size();
+    }
+    unsigned bad = 0;
+    for(size_t i = 0; i < words.size(); ++i)
+        if(pd.get_insns()[i] != words[i])
+        {
+            if(bad < 10)
+                std::cout << "word " << i << " " << hex::to_hex0x32(words[i]) << " predecoded as "
+                    << hex::to_hex0x32(pd.get_insns()[i]) << std::endl;
+            ++bad;
+        }
+    return bad;
+}
+
+/**
+ * Predecodes words stored as little-endian bytes and checks the result
+ * @return unsigned the number of wrong words
+ ********************************************************************************/
+static unsigned check_words(const std::vector<uint32_t> &words)
+{
+    std::vector<uint8_t> bytes;
+    for(uint32_t w : words)
+        for(unsigned b = 0; b < 4; ++b)
+            bytes.push_back(w >> (b*8));
+
+    rv32i_predecode pd;
+    unsigned bad = 0;
+    for(size_t n = 0; n <= 24 && n <= words.size(); ++n)
+    {
+        pd.predecode_words(bytes.data(), n);
+        bad += check(pd, std::vector<uint32_t>(words.begin(), words.begin() + n));
+    }
+    pd.predecode_words(bytes.data(), words.size());
+    return bad + check(pd, words);
+}
+
+/**
+ * Checks random words and the testdata images
+ *
+* @param argc an int for the argument count
+* @param argv a char for the argument values
+ * @return int 0 if every word matched
+ *
+ ********************************************************************************/
+int main(int argc, char **argv)
+{
+    std::string dir = argc > 1 ? argv[1] : "testdata";
+    unsigned bad = 0;
+    size_t total = 0;
+
+    std::mt19937 rng(1);
+    std::vector<uint32_t> words(100003);
+    for(uint32_t &w : words)
+        w = rng();
+    words[0] = 0;
+    words[1] = 0xffffffff;
+    words[2] = 0x80000000;
+    words[3] = 0x7fffffff;
+    bad += check_words(words);
+    total += words.size();
+
+    DIR *d = opendir(dir.c_str());
+    if(d)
+    {
+        while(dirent *e = readdir(d))
+        {
+            std::string name = e->d_name;
+            if(name.size() < 4 || name.compare(name.size() - 4, 4, ".bin") != 0)
+                continue;
+            memory mem(0x10000);
+            if(!mem.load_file(dir + "/" + name))
+                continue;
+
+            rv32i_predecode pd;
+            pd.predecode_region(mem, 0, mem.get_size());
+            std::vector<uint32_t> image;
+            for(uint32_t addr = 0; addr + 4 <= mem.get_size(); addr += 4)
+                image.push_back(mem.get32(addr));
+            bad += check(pd, image);
+            total += image.size();
+        }
+        closedir(d);
+    }
+
+    std::cout << total << " words predecoded, " << bad << " wrong" << std::endl;
+    return bad ? 1 : 0;
+}
@@ -6,7 +6,8 @@
  *
  * @note resets registerfile with default values 
  ********************************************************************************/
-registerfile::registerfile()
+template <unsigned XLEN>
+basic_registerfile<XLEN>::basic_registerfile()
 {
     reset(); 
 }
@@ -17,9 +18,10 @@ registerfile::registerfile()
  *
  * @note resets all 32 regs with default values besides reg 0 -> 0x0
  ********************************************************************************/
-void registerfile::reset()
+template <unsigned XLEN>
+void basic_registerfile<XLEN>::reset()
 {
-    registers.resize(32,0xf0f0f0f0);
+    registers.resize(32,(sreg_t)0xf0f0f0f0f0f0f0f0ull);
     registers[0] = 0x0;
 
 }
@@ -31,7 +33,8 @@ void registerfile::reset()
  * @param val the value to be added to the reg
  * @note sets the index r in the registers vector with the value pass in (val)
  ********************************************************************************/
-void registerfile::set(uint32_t r, int32_t val)
+template <unsigned XLEN>
+void basic_registerfile<XLEN>::set(uint32_t r, sreg_t val)
 {
     if(r == 0)
         return;
@@ -42,11 +45,12 @@ void registerfile::set(uint32_t r, int32_t val)
 
 /**
  * get function 
- * @return int32_t  
+ * @return sreg_t  
  * @param r index of the vector
  * @note gets the index r in the registers vector and returns it 
  ********************************************************************************/
-int32_t registerfile::get(uint32_t r) const
+template <unsigned XLEN>
+typename basic_registerfile<XLEN>::sreg_t basic_registerfile<XLEN>::get(uint32_t r) const
 {
     if(r == 0)
         return 0;
@@ -59,39 +63,49 @@ int32_t registerfile::get(uint32_t r) const
  * Dump the register vector
  * @return void  
  * @param hdr prefix string 
- * @note dumps the register vecotr and prints out a header string if there is one
+ * @param os where to print
+ * @note dumps the registers eight to a line, each line starting with the
+ * right justified name of its first register
  * 
  ********************************************************************************/
-void registerfile::dump(const std::string &hdr) const
+template <unsigned XLEN>
+void basic_registerfile<XLEN>::dump(const std::string &hdr, std::ostream &os) const
 {
-     auto it = registers.begin();               // start of vector
-        int addressLine = 0;                    // address line for registers
+    for(size_t r = 0; r < registers.size(); r += 8)
+    {
+        os << hdr << std::right << std::setw(3) << std::setfill(' ') << ("x" + std::to_string(r));
 
-        while(it != registers.end())            
+        for(size_t x = 0; x < 8; x++)       // loops through the 8 registers
         {
-            if(addressLine % 8 == 0)               // if 0 4 8 16 or 24
-            {
-                if(hdr != " ")                      // checks if hdr is null or not
-                    std::cout << hdr << "  x" << addressLine << " ";
-                else                                // prints either the prefix header or just the reg number
-                    std::cout << " x" << addressLine << " ";
-
-            size_t t = std::distance(registers.begin(),it);             // distance from the start of vector to it
-            for(size_t x = 0; x < 8; x++)                               // loops through the 8  registers
-            {
-                if(x == 4)
-                    std::cout << " ";
+            if(x == 4)
+                os << " ";
+            os << " " << xlen_traits<XLEN>::to_hex(get(r + x));
+        }
+        os << std::endl;
+    }
 
-                std::cout << hex::to_hex32(get(t)) << " ";
-                t++;
-            }
-            std::cout << std::endl;
-            }
+}
 
-            addressLine ++;                                 // increments 
-            it++;
+/**
+ * Write the register vector as raw binary
+ * @return void  
+ * @param os the binary stream to write to
+ * @note writes x0 to x31 as XLEN-bit little-endian words
+ * 
+ ********************************************************************************/
+template <unsigned XLEN>
+void basic_registerfile<XLEN>::save(std::ostream &os) const
+{
+    for(size_t r = 0; r < registers.size(); ++r)
+    {
+        reg_t val = get(r);
+        char b[XLEN/8];
+        for(size_t i = 0; i < sizeof(b); ++i)
+            b[i] = (char)(val >> (i*8));
+        os.write(b, sizeof(b));
+    }
 
-        }
-        std::cout << std::endl;
+}
 
-}
\ No newline at end of file
+template class basic_registerfile<32>;
+template class basic_registerfile<64>;
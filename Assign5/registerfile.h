@@ -3,18 +3,26 @@
 #include <vector>
 #include <iostream>
 #include "hex.h"
+#include "xlen.h"
 
-class registerfile
+template <unsigned XLEN>
+class basic_registerfile
 {
     public:
-        registerfile();
+        typedef typename xlen_traits<XLEN>::uword_t reg_t;
+        typedef typename xlen_traits<XLEN>::sword_t sreg_t;
+
+        basic_registerfile();
         void reset();
-        void set(uint32_t r, int32_t val);
-        int32_t get(uint32_t r) const;
-        void dump(const std::string &hdr) const;
+        void set(uint32_t r, sreg_t val);
+        sreg_t get(uint32_t r) const;
+        void dump(const std::string &hdr, std::ostream &os = std::cout) const;
+        void save(std::ostream &os) const;
 
     private: 
-        std::vector<int32_t> registers;
+        std::vector<sreg_t> registers;
 };
 
+typedef basic_registerfile<RV_XLEN> registerfile;
+
 #endif
\ No newline at end of file
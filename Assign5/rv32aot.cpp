@@ -0,0 +1,91 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <getopt.h>
+#include "memory.h"
+#include "rv32i_translate.h"
+
+// Translates a flat RV32 image to a C++ source file, one function per basic
+// block.  Build the result with aotrt.a to get a program that runs the image.
+
+/**
+ * Usage function used to print useful information
+ *
+ * @return void
+ *
+ * @note Shows how to use the program flags
+ ********************************************************************************/
+static void usage()
+{
+    std::cerr << "Usage: rv32aot [-e entry] [-m hex-mem-size] [-o outfile] infile" << std::endl;
+    std::cerr << "    -e hex address execution starts at (default = 0)" << std::endl;
+    std::cerr << "    -m specify memory size (default = 0x100)" << std::endl;
+    std::cerr << "    -o write the C++ source here (default = standard output)" << std::endl;
+    std::cerr << "Build the result with: g++ -O2 -std=c++14 -pthread -o prog prog.cpp aotrt.a" << std::endl;
+    exit(1);
+}
+
+/**
+ * Main function of the translator
+ *
+* @param argc an int for the argument count
+* @param argv a char for the argument values
+ * @return int
+ *
+ * @note translates a flat RV32I binary image into C++
+ ********************************************************************************/
+int main(int argc, char **argv)
+{
+    uint32_t memory_limit = 0x100;
+    uint32_t entry = 0;
+    std::string outfile;
+    int opt;
+    while((opt = getopt(argc, argv, "e:m:o:")) != -1)
+    {
+        switch(opt)
+        {
+            case 'e':
+            {
+                std::istringstream iss(optarg);
+                iss >> std::hex >> entry;
+            }
+            break;
+            case 'm':
+            {
+                std::istringstream iss(optarg);
+                iss >> std::hex >> memory_limit;
+            }
+            break;
+            case 'o':
+                outfile = optarg;
+                break;
+            default:
+                usage();
+        }
+    }
+    if(optind >= argc)
+        usage();
+
+    memory mem(memory_limit);
+    if(!mem.load_file(argv[optind]))
+        usage();
+
+    rv32i_translate tr(mem, mem.get_load_size());
+    tr.discover(entry);
+
+    if(outfile.empty())
+    {
+        tr.emit(std::cout, argv[optind]);
+        return 0;
+    }
+
+    std::ofstream os(outfile);
+    if(!os.is_open())
+    {
+        std::cerr << "Can't open file " << outfile << " for writing." << std::endl;
+        return 1;
+    }
+    tr.emit(os, argv[optind]);
+    std::cerr << tr.get_block_count() << " blocks translated" << std::endl;
+    return os ? 0 : 1;
+}
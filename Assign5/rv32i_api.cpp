@@ -0,0 +1,255 @@
+#include "rv32i_api.h"
+#include "memory.h"
+#include "cpu_single_hart.h"
+#include <streambuf>
+#include <vector>
+#include <memory>
+#include <cstring>
+
+// Hands the trace text to the C callback, or drops it when there is none
+class trace_buf : public std::streambuf
+{
+public:
+    rv32i_trace_fn fn = { nullptr };
+    void *ctx = { nullptr };
+
+protected:
+    int overflow(int c) override
+    {
+        if(c != traits_type::eof() && fn)
+        {
+            char ch = c;
+            fn(ctx, &ch, 1);
+        }
+        return traits_type::not_eof(c);
+    }
+    std::streamsize xsputn(const char *s, std::streamsize n) override
+    {
+        if(fn)
+            fn(ctx, s, n);
+        return n;
+    }
+};
+
+struct rv32i_sim
+{
+    rv32i_sim(uint32_t siz) : mem(siz), cpu(mem), trace(&buf)
+    {
+        mem.set_output(trace);
+        cpu.set_output(trace);
+    }
+
+    memory mem;
+    cpu_single_hart cpu;
+    trace_buf buf;
+    std::ostream trace;
+};
+
+struct rv32i_snapshot
+{
+    rv32i_hart::snapshot hart;
+    std::vector<uint8_t> mem;
+};
+
+/**
+ * The version of the API in this library
+ * @return int RV32I_API_VERSION when it was built
+ ********************************************************************************/
+int rv32i_api_version(void)
+{
+    return RV32I_API_VERSION;
+}
+
+/**
+ * Makes a simulator
+ * @return rv32i_sim* or NULL if the memory can't be had
+ *
+* @param mem_size bytes of memory, rounded up to 16
+ ********************************************************************************/
+rv32i_sim *rv32i_create(uint32_t mem_size)
+{
+    try
+    {
+        rv32i_sim *sim = new rv32i_sim(mem_size);
+        rv32i_reset(sim);
+        return sim;
+    }
+    catch(const std::bad_alloc &)
+    {
+        return nullptr;
+    }
+}
+
+/**
+ * Frees a simulator
+ * @return void
+ ********************************************************************************/
+void rv32i_destroy(rv32i_sim *sim)
+{
+    delete sim;
+}
+
+/**
+ * Resets the hart the same way rv32i starts a run
+ * @return void
+ *
+ * @note the x registers go back to their power on values. cpu_single_hart::run
+ * sets sp, this does it once here so rv32i_run can be called again and again
+ ********************************************************************************/
+void rv32i_reset(rv32i_sim *sim)
+{
+    sim->cpu.reset();
+    for(uint32_t r = 1; r < 32; ++r)
+        sim->cpu.set_reg(r, r == 2 ? sim->mem.get_size() : 0xf0f0f0f0f0f0f0f0ull);
+}
+
+/**
+ * Loads an image from a host buffer
+ * @return int -1 if it does not fit
+ ********************************************************************************/
+int rv32i_load(rv32i_sim *sim, uint64_t addr, const void *buf, uint32_t len)
+{
+    return rv32i_write_mem(sim, addr, buf, len);
+}
+
+/**
+ * Runs the hart
+ * @return uint64_t the number of instructions executed
+ *
+* @param n the most to run, 0 runs until halted
+ ********************************************************************************/
+uint64_t rv32i_run(rv32i_sim *sim, uint64_t n)
+{
+    uint64_t start = sim->cpu.get_insn_counter();
+    for(uint64_t i = 0; !sim->cpu.is_halted() && (n == 0 || i < n); ++i)
+        sim->cpu.tick();
+    sim->trace.flush();
+    return sim->cpu.get_insn_counter() - start;
+}
+
+int rv32i_halted(const rv32i_sim *sim)
+{
+    return sim->cpu.is_halted();
+}
+
+const char *rv32i_halt_reason(const rv32i_sim *sim)
+{
+    return sim->cpu.get_halt_reason().c_str();
+}
+
+uint64_t rv32i_insn_count(const rv32i_sim *sim)
+{
+    return sim->cpu.get_insn_counter();
+}
+
+uint64_t rv32i_get_pc(const rv32i_sim *sim)
+{
+    return sim->cpu.get_pc();
+}
+
+void rv32i_set_pc(rv32i_sim *sim, uint64_t pc)
+{
+    sim->cpu.set_pc(pc);
+}
+
+/**
+ * Reads an x register
+ * @return uint64_t the value zero extended from XLEN, 0 for a bad r
+ ********************************************************************************/
+uint64_t rv32i_get_reg(const rv32i_sim *sim, uint32_t r)
+{
+    return r < 32 ? sim->cpu.get_reg(r) : 0;
+}
+
+/**
+ * Writes an x register
+ * @return int -1 for a bad r, writes to x0 are ignored like the hart does
+ ********************************************************************************/
+int rv32i_set_reg(rv32i_sim *sim, uint32_t r, uint64_t val)
+{
+    if(r >= 32)
+        return -1;
+    sim->cpu.set_reg(r, val);
+    return 0;
+}
+
+uint32_t rv32i_mem_size(const rv32i_sim *sim)
+{
+    return sim->mem.get_size();
+}
+
+/**
+ * Copies simulated memory out
+ * @return int -1 if the range is not all in memory
+ ********************************************************************************/
+int rv32i_read_mem(const rv32i_sim *sim, uint64_t addr, void *buf, uint32_t len)
+{
+    uint32_t size = sim->mem.get_size();
+    if(addr > size || len > size - addr)
+        return -1;
+    std::memcpy(buf, sim->mem.get_data() + addr, len);
+    return 0;
+}
+
+/**
+ * Copies into simulated memory
+ * @return int -1 if the range is not all in memory
+ ********************************************************************************/
+int rv32i_write_mem(rv32i_sim *sim, uint64_t addr, const void *buf, uint32_t len)
+{
+    uint32_t size = sim->mem.get_size();
+    if(addr > size || len > size - addr)
+        return -1;
+    std::memcpy(sim->mem.get_data() + addr, buf, len);
+    return 0;
+}
+
+/**
+ * Turns the instruction and register traces on or off
+ * @return void
+ ********************************************************************************/
+void rv32i_set_trace(rv32i_sim *sim, int show_insns, int show_regs, rv32i_trace_fn fn, void *ctx)
+{
+    sim->buf.fn = fn;
+    sim->buf.ctx = ctx;
+    sim->cpu.set_show_instructions(fn && show_insns);
+    sim->cpu.set_show_registers(fn && show_regs);
+}
+
+/**
+ * Saves the hart and memory
+ * @return rv32i_snapshot* or NULL if there is no memory for it
+ ********************************************************************************/
+rv32i_snapshot *rv32i_snapshot_take(const rv32i_sim *sim)
+{
+    try
+    {
+        std::unique_ptr<rv32i_snapshot> snap(new rv32i_snapshot);
+        sim->cpu.save_snapshot(snap->hart);
+        const uint8_t *data = sim->mem.get_data();
+        snap->mem.assign(data, data + sim->mem.get_size());
+        return snap.release();
+    }
+    catch(const std::bad_alloc &)
+    {
+        return nullptr;
+    }
+}
+
+/**
+ * Puts a simulator back the way it was when the snapshot was taken
+ * @return int -1 if the memory sizes differ
+ ********************************************************************************/
+int rv32i_snapshot_restore(rv32i_sim *sim, const rv32i_snapshot *snap)
+{
+    if(snap->mem.size() != sim->mem.get_size())
+        return -1;
+    sim->cpu.restore_snapshot(snap->hart);
+    std::memcpy(sim->mem.get_data(), snap->mem.data(), snap->mem.size());
+    return 0;
+}
+
+void rv32i_snapshot_free(rv32i_snapshot *snap)
+{
+    delete snap;
+}
@@ -0,0 +1,73 @@
+#ifndef RV32I_API_H
+#define RV32I_API_H
+
+/*
+ * C interface to the simulator, for running it in process from C or from
+ * anything that can call C.  Link with librv32i.a (and the C++ runtime) or
+ * with librv32i.so.
+ *
+ * A simulator is a memory and one hart.  Nothing is printed unless tracing is
+ * turned on with rv32i_set_trace, and then it goes to the callback.  The
+ * functions returning int give 0 on success and -1 on a bad argument.
+ *
+ * The handle and snapshot types are opaque and only grow at the end, so code
+ * built against an older version of this header keeps working.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RV32I_API_VERSION 1
+
+typedef struct rv32i_sim rv32i_sim;
+typedef struct rv32i_snapshot rv32i_snapshot;
+
+/* gets a chunk of trace text, not nul terminated */
+typedef void (*rv32i_trace_fn)(void *ctx, const char *text, size_t len);
+
+int rv32i_api_version(void);
+
+/* a simulator with mem_size bytes of memory, reset and ready to run from 0 */
+rv32i_sim *rv32i_create(uint32_t mem_size);
+void rv32i_destroy(rv32i_sim *sim);
+
+/* pc = 0, sp = the memory size, not halted, counters cleared; memory kept */
+void rv32i_reset(rv32i_sim *sim);
+
+/* copies len bytes from buf to addr in the simulated memory */
+int rv32i_load(rv32i_sim *sim, uint64_t addr, const void *buf, uint32_t len);
+
+/* runs until halted or n instructions (0 = no limit), returns the number run */
+uint64_t rv32i_run(rv32i_sim *sim, uint64_t n);
+
+int rv32i_halted(const rv32i_sim *sim);
+const char *rv32i_halt_reason(const rv32i_sim *sim);
+uint64_t rv32i_insn_count(const rv32i_sim *sim);
+
+uint64_t rv32i_get_pc(const rv32i_sim *sim);
+void rv32i_set_pc(rv32i_sim *sim, uint64_t pc);
+uint64_t rv32i_get_reg(const rv32i_sim *sim, uint32_t r);
+int rv32i_set_reg(rv32i_sim *sim, uint32_t r, uint64_t val);
+
+uint32_t rv32i_mem_size(const rv32i_sim *sim);
+int rv32i_read_mem(const rv32i_sim *sim, uint64_t addr, void *buf, uint32_t len);
+int rv32i_write_mem(rv32i_sim *sim, uint64_t addr, const void *buf, uint32_t len);
+
+/* show_insns and show_regs are the rv32i -i and -r traces; fn NULL turns off */
+void rv32i_set_trace(rv32i_sim *sim, int show_insns, int show_regs, rv32i_trace_fn fn, void *ctx);
+
+/* the hart and all of memory, restorable into the simulator it came from or
+   any other one with the same memory size */
+rv32i_snapshot *rv32i_snapshot_take(const rv32i_sim *sim);
+int rv32i_snapshot_restore(rv32i_sim *sim, const rv32i_snapshot *snap);
+void rv32i_snapshot_free(rv32i_snapshot *snap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,232 @@
+#include "rv32i_asm.h"
+#include <fstream>
+#include <cassert>
+
+/**
+ * Makes a label that is not bound yet
+ * @return label
+ ********************************************************************************/
+rv32i_asm::label rv32i_asm::new_label()
+{
+    labels.push_back(-1);
+    return labels.size() - 1;
+}
+
+/**
+ * Binds a label to the next instruction
+ * @return void
+ *
+* @param l the label
+ ********************************************************************************/
+void rv32i_asm::bind(label l)
+{
+    assert(labels[l] < 0 && "label bound twice");
+    labels[l] = here();
+}
+
+/**
+ * lui
+ * @return void
+ *
+* @param rd the destination
+* @param imm20 the upper 20 bits
+ ********************************************************************************/
+void rv32i_asm::lui(uint32_t rd, uint32_t imm20)
+{
+    emit((imm20 << 12) | (rd << 7) | opcode_lui);
+}
+
+/**
+ * jal to a label
+ * @return void
+ *
+* @param rd gets the return address
+* @param l the target
+ ********************************************************************************/
+void rv32i_asm::jal(uint32_t rd, label l)
+{
+    fixups.push_back({ (uint32_t)code.size(), l });
+    emit((rd << 7) | opcode_jal);
+}
+
+/**
+ * jalr
+ * @return void
+ *
+* @param rd gets the return address
+* @param rs1 the base
+* @param imm the displacement
+ ********************************************************************************/
+void rv32i_asm::jalr(uint32_t rd, uint32_t rs1, int32_t imm)
+{
+    itype(opcode_jalr, 0, rd, rs1, imm);
+}
+
+/**
+ * Loads any 32 bit value
+ * @return void
+ *
+* @param rd the destination
+* @param val the value
+ *
+ * @note uses addi alone for 12 bit values, otherwise lui and addi with the
+ * upper part rounded so the sign extended addi lands on val
+ ********************************************************************************/
+void rv32i_asm::li(uint32_t rd, int32_t val)
+{
+    if(val >= -2048 && val < 2048)
+    {
+        addi(rd, zero, val);
+        return;
+    }
+    uint32_t u = val;
+    int32_t lo = u & 0xfff;
+    if(lo & 0x800)
+        lo -= 0x1000;
+    lui(rd, ((u - lo) >> 12) & 0xfffff);
+    if(lo)
+        addi(rd, rd, lo);
+}
+
+/**
+ * I type encoding, also loads and jalr
+ * @return void
+ ********************************************************************************/
+void rv32i_asm::itype(uint32_t opcode, uint32_t funct3, uint32_t rd, uint32_t rs1, int32_t imm)
+{
+    assert(imm >= -2048 && imm < 4096 && "immediate out of range");
+    emit(((uint32_t)(imm & 0xfff) << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode);
+}
+
+/**
+ * S type encoding
+ * @return void
+ ********************************************************************************/
+void rv32i_asm::stype(uint32_t funct3, uint32_t rs2, uint32_t rs1, int32_t imm)
+{
+    assert(imm >= -2048 && imm < 2048 && "immediate out of range");
+    uint32_t u = imm & 0xfff;
+    emit(((u >> 5) << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | ((u & 0x1f) << 7) | opcode_stype);
+}
+
+/**
+ * R type encoding, OP-32 for the RV64 word instructions
+ * @return void
+ ********************************************************************************/
+void rv32i_asm::rtype(uint32_t funct7, uint32_t funct3, uint32_t rd, uint32_t rs1, uint32_t rs2, uint32_t opcode)
+{
+    emit((funct7 << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode);
+}
+
+/**
+ * Unit-stride vector load or store, unmasked
+ * @return void
+ ********************************************************************************/
+void rv32i_asm::vmem(uint32_t opcode, uint32_t width, uint32_t vd, uint32_t rs1)
+{
+    emit((1 << 25) | (rs1 << 15) | (width << 12) | (vd << 7) | opcode);
+}
+
+/**
+ * OP-V arithmetic encoding, unmasked, vs1 is also rs1 or the 5 bit immediate
+ * @return void
+ ********************************************************************************/
+void rv32i_asm::vop(uint32_t funct6, uint32_t funct3, uint32_t vd, uint32_t vs2, uint32_t vs1)
+{
+    emit((funct6 << 26) | (1 << 25) | (vs2 << 20) | (vs1 << 15) | (funct3 << 12) | (vd << 7) | opcode_op_v);
+}
+
+/**
+ * The vtypei for an element width and register group size, tail and mask
+ * undisturbed
+ * @return uint32_t vsew and vlmul
+ *
+* @param sew 8, 16, 32 or 64
+* @param lmul 1, 2, 4 or 8
+ ********************************************************************************/
+uint32_t rv32i_asm::vtype(uint32_t sew, uint32_t lmul)
+{
+    uint32_t vsew = 0;
+    while((8u << vsew) < sew)
+        ++vsew;
+    uint32_t vlmul = 0;
+    while((1u << vlmul) < lmul)
+        ++vlmul;
+    return (vsew << 3) | vlmul;
+}
+
+/**
+ * Conditional branch to a label
+ * @return void
+ ********************************************************************************/
+void rv32i_asm::branch(uint32_t funct3, uint32_t rs1, uint32_t rs2, label l)
+{
+    fixups.push_back({ (uint32_t)code.size(), l });
+    emit((rs2 << 20) | (rs1 << 15) | (funct3 << 12) | opcode_btype);
+}
+
+/**
+ * Puts a branch offset into a B type instruction
+ * @return uint32_t the instruction
+ ********************************************************************************/
+uint32_t rv32i_asm::encode_b(uint32_t insn, int32_t off)
+{
+    uint32_t u = off;
+    return insn | ((u & 0x1000) << 19) | ((u & 0x7e0) << 20) | ((u & 0x1e) << 7) | ((u & 0x800) >> 4);
+}
+
+/**
+ * Puts a jump offset into a J type instruction
+ * @return uint32_t the instruction
+ ********************************************************************************/
+uint32_t rv32i_asm::encode_j(uint32_t insn, int32_t off)
+{
+    uint32_t u = off;
+    return insn | ((u & 0x100000) << 11) | ((u & 0x7fe) << 20) | ((u & 0x800) << 9) | (u & 0xff000);
+}
+
+/**
+ * Resolves the branch and jump targets
+ * @return const std::vector<uint32_t>& the program, one word per instruction
+ *
+ * @note every label used must have been bound
+ ********************************************************************************/
+const std::vector<uint32_t> &rv32i_asm::finish()
+{
+    for(const auto &f : fixups)
+    {
+        assert(labels[f.target] >= 0 && "label never bound");
+        int32_t off = (int32_t)labels[f.target] - (int32_t)(f.pos * 4);
+        uint32_t &insn = code[f.pos];
+        if(get_opcode(insn) == opcode_jal)
+        {
+            assert(off >= -(1 << 20) && off < (1 << 20) && "jump out of range");
+            insn = encode_j(insn, off);
+        }
+        else
+        {
+            assert(off >= -4096 && off < 4096 && "branch out of range");
+            insn = encode_b(insn, off);
+        }
+    }
+    fixups.clear();
+    return code;
+}
+
+/**
+ * Writes the program as a raw little-endian image rv32i can load
+ * @return bool false if the file could not be written
+ *
+* @param fname the file to write
+ ********************************************************************************/
+bool rv32i_asm::save(const std::string &fname)
+{
+    finish();
+    std::ofstream outfile(fname, std::ios::out|std::ios::binary|std::ios::trunc);
+    for(uint32_t w : code)
+    {
+        char b[4] = { (char)w, (char)(w >> 8), (char)(w >> 16), (char)(w >> 24) };
+        outfile.write(b, sizeof(b));
+    }
+    return (bool)outfile;
+}
@@ -0,0 +1,216 @@
+#ifndef RV32I_ASM_H
+#define RV32I_ASM_H
+
+#include <vector>
+#include <string>
+#include "rv32i_decode.h"
+
+// A small RV32IM assembler, with Zba, Zbb, RVV and the RV64I word instructions,
+// for building guest programs in C++ when there is no RISC-V toolchain.  Branches
+// and jumps take labels that are resolved by finish(), so code can jump
+// forward to a label that is bound later.  li is lui and addi, so on RV64 it
+// sign extends values that round up to 0x80000000 in the lui.
+class rv32i_asm : public rv32i_decode
+{
+public:
+    typedef uint32_t label;
+
+    // ABI register names
+    static constexpr uint32_t zero = 0, ra = 1, sp = 2, gp = 3, tp = 4;
+    static constexpr uint32_t t0 = 5, t1 = 6, t2 = 7, s0 = 8, s1 = 9;
+    static constexpr uint32_t a0 = 10, a1 = 11, a2 = 12, a3 = 13, a4 = 14, a5 = 15, a6 = 16, a7 = 17;
+    static constexpr uint32_t s2 = 18, s3 = 19, s4 = 20, s5 = 21, s6 = 22, s7 = 23, s8 = 24, s9 = 25;
+    static constexpr uint32_t s10 = 26, s11 = 27;
+    static constexpr uint32_t t3 = 28, t4 = 29, t5 = 30, t6 = 31;
+
+    label new_label();
+    void bind(label l);
+    uint32_t here() const { return code.size() * 4; }
+
+    void lui(uint32_t rd, uint32_t imm20);
+    void jal(uint32_t rd, label l);
+    void jalr(uint32_t rd, uint32_t rs1, int32_t imm);
+
+    void beq(uint32_t rs1, uint32_t rs2, label l) { branch(funct3_beq, rs1, rs2, l); }
+    void bne(uint32_t rs1, uint32_t rs2, label l) { branch(funct3_bne, rs1, rs2, l); }
+    void blt(uint32_t rs1, uint32_t rs2, label l) { branch(funct3_blt, rs1, rs2, l); }
+    void bge(uint32_t rs1, uint32_t rs2, label l) { branch(funct3_bge, rs1, rs2, l); }
+    void bltu(uint32_t rs1, uint32_t rs2, label l) { branch(funct3_bltu, rs1, rs2, l); }
+    void bgeu(uint32_t rs1, uint32_t rs2, label l) { branch(funct3_bgeu, rs1, rs2, l); }
+
+    void lb(uint32_t rd, uint32_t rs1, int32_t imm) { itype(opcode_load_imm, funct3_lb, rd, rs1, imm); }
+    void lh(uint32_t rd, uint32_t rs1, int32_t imm) { itype(opcode_load_imm, funct3_lh, rd, rs1, imm); }
+    void lw(uint32_t rd, uint32_t rs1, int32_t imm) { itype(opcode_load_imm, funct3_lw, rd, rs1, imm); }
+    void lbu(uint32_t rd, uint32_t rs1, int32_t imm) { itype(opcode_load_imm, funct3_lbu, rd, rs1, imm); }
+    void lhu(uint32_t rd, uint32_t rs1, int32_t imm) { itype(opcode_load_imm, funct3_lhu, rd, rs1, imm); }
+    void sb(uint32_t rs2, uint32_t rs1, int32_t imm) { stype(funct3_sb, rs2, rs1, imm); }
+    void sh(uint32_t rs2, uint32_t rs1, int32_t imm) { stype(funct3_sh, rs2, rs1, imm); }
+    void sw(uint32_t rs2, uint32_t rs1, int32_t imm) { stype(funct3_sw, rs2, rs1, imm); }
+
+    void addi(uint32_t rd, uint32_t rs1, int32_t imm) { itype(opcode_alu_imm, funct3_add, rd, rs1, imm); }
+    void slti(uint32_t rd, uint32_t rs1, int32_t imm) { itype(opcode_alu_imm, funct3_slt, rd, rs1, imm); }
+    void sltiu(uint32_t rd, uint32_t rs1, int32_t imm) { itype(opcode_alu_imm, funct3_sltu, rd, rs1, imm); }
+    void xori(uint32_t rd, uint32_t rs1, int32_t imm) { itype(opcode_alu_imm, funct3_xor, rd, rs1, imm); }
+    void ori(uint32_t rd, uint32_t rs1, int32_t imm) { itype(opcode_alu_imm, funct3_or, rd, rs1, imm); }
+    void andi(uint32_t rd, uint32_t rs1, int32_t imm) { itype(opcode_alu_imm, funct3_and, rd, rs1, imm); }
+    void slli(uint32_t rd, uint32_t rs1, uint32_t sh) { itype(opcode_alu_imm, funct3_sll, rd, rs1, sh & 0x1f); }
+    void srli(uint32_t rd, uint32_t rs1, uint32_t sh) { itype(opcode_alu_imm, funct3_srx, rd, rs1, sh & 0x1f); }
+    void srai(uint32_t rd, uint32_t rs1, uint32_t sh) { itype(opcode_alu_imm, funct3_srx, rd, rs1, 0x400 | (sh & 0x1f)); }
+
+    void add(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_add, funct3_add, rd, rs1, rs2); }
+    void sub(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_sub, funct3_add, rd, rs1, rs2); }
+    void sll(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(0, funct3_sll, rd, rs1, rs2); }
+    void slt(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(0, funct3_slt, rd, rs1, rs2); }
+    void sltu(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(0, funct3_sltu, rd, rs1, rs2); }
+    void xor_(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(0, funct3_xor, rd, rs1, rs2); }
+    void srl(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_srl, funct3_srx, rd, rs1, rs2); }
+    void sra(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_sra, funct3_srx, rd, rs1, rs2); }
+    void or_(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(0, funct3_or, rd, rs1, rs2); }
+    void and_(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(0, funct3_and, rd, rs1, rs2); }
+
+    void mul(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_muldiv, funct3_mul, rd, rs1, rs2); }
+    void mulh(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_muldiv, funct3_mulh, rd, rs1, rs2); }
+    void mulhsu(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_muldiv, funct3_mulhsu, rd, rs1, rs2); }
+    void mulhu(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_muldiv, funct3_mulhu, rd, rs1, rs2); }
+    void div(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_muldiv, funct3_div, rd, rs1, rs2); }
+    void divu(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_muldiv, funct3_divu, rd, rs1, rs2); }
+    void rem(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_muldiv, funct3_rem, rd, rs1, rs2); }
+    void remu(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_muldiv, funct3_remu, rd, rs1, rs2); }
+
+    void sh1add(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_shadd, funct3_sh1add, rd, rs1, rs2); }
+    void sh2add(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_shadd, funct3_sh2add, rd, rs1, rs2); }
+    void sh3add(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_shadd, funct3_sh3add, rd, rs1, rs2); }
+    void andn(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_sub, funct3_and, rd, rs1, rs2); }
+    void orn(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_sub, funct3_or, rd, rs1, rs2); }
+    void xnor(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_sub, funct3_xor, rd, rs1, rs2); }
+    void min(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_minmax, funct3_min, rd, rs1, rs2); }
+    void minu(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_minmax, funct3_minu, rd, rs1, rs2); }
+    void max(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_minmax, funct3_max, rd, rs1, rs2); }
+    void maxu(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_minmax, funct3_maxu, rd, rs1, rs2); }
+    void rol(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_rot, funct3_rol, rd, rs1, rs2); }
+    void ror(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_rot, funct3_ror, rd, rs1, rs2); }
+    void rori(uint32_t rd, uint32_t rs1, uint32_t sh) { itype(opcode_alu_imm, funct3_srx, rd, rs1, (funct7_rot << 5) | (sh & 0x1f)); }
+    void clz(uint32_t rd, uint32_t rs1) { itype(opcode_alu_imm, funct3_sll, rd, rs1, (funct7_rot << 5) | rs2_clz); }
+    void ctz(uint32_t rd, uint32_t rs1) { itype(opcode_alu_imm, funct3_sll, rd, rs1, (funct7_rot << 5) | rs2_ctz); }
+    void cpop(uint32_t rd, uint32_t rs1) { itype(opcode_alu_imm, funct3_sll, rd, rs1, (funct7_rot << 5) | rs2_cpop); }
+    void sext_b(uint32_t rd, uint32_t rs1) { itype(opcode_alu_imm, funct3_sll, rd, rs1, (funct7_rot << 5) | rs2_sextb); }
+    void sext_h(uint32_t rd, uint32_t rs1) { itype(opcode_alu_imm, funct3_sll, rd, rs1, (funct7_rot << 5) | rs2_sexth); }
+    void rev8(uint32_t rd, uint32_t rs1) { itype(opcode_alu_imm, funct3_srx, rd, rs1, (funct7_rev8 << 5) | rs2_rev8); }
+    void orc_b(uint32_t rd, uint32_t rs1) { itype(opcode_alu_imm, funct3_srx, rd, rs1, (funct7_orcb << 5) | rs2_orcb); }
+    void zext_h(uint32_t rd, uint32_t rs1) { rtype(funct7_zexth, funct3_zexth, rd, rs1, 0); }
+
+    // RV64I, only for guests run by rv64i
+    void ld(uint32_t rd, uint32_t rs1, int32_t imm) { itype(opcode_load_imm, funct3_ld, rd, rs1, imm); }
+    void lwu(uint32_t rd, uint32_t rs1, int32_t imm) { itype(opcode_load_imm, funct3_lwu, rd, rs1, imm); }
+    void sd(uint32_t rs2, uint32_t rs1, int32_t imm) { stype(funct3_sd, rs2, rs1, imm); }
+    void addiw(uint32_t rd, uint32_t rs1, int32_t imm) { itype(opcode_alu_imm_w, funct3_add, rd, rs1, imm); }
+    void slliw(uint32_t rd, uint32_t rs1, uint32_t sh) { itype(opcode_alu_imm_w, funct3_sll, rd, rs1, sh & 0x1f); }
+    void srliw(uint32_t rd, uint32_t rs1, uint32_t sh) { itype(opcode_alu_imm_w, funct3_srx, rd, rs1, sh & 0x1f); }
+    void sraiw(uint32_t rd, uint32_t rs1, uint32_t sh) { itype(opcode_alu_imm_w, funct3_srx, rd, rs1, 0x400 | (sh & 0x1f)); }
+    void addw(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_add, funct3_add, rd, rs1, rs2, opcode_rtype_w); }
+    void subw(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_sub, funct3_add, rd, rs1, rs2, opcode_rtype_w); }
+    void sllw(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(0, funct3_sll, rd, rs1, rs2, opcode_rtype_w); }
+    void srlw(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_srl, funct3_srx, rd, rs1, rs2, opcode_rtype_w); }
+    void sraw(uint32_t rd, uint32_t rs1, uint32_t rs2) { rtype(funct7_sra, funct3_srx, rd, rs1, rs2, opcode_rtype_w); }
+
+    // RVV, unmasked only, vtype(sew, lmul) makes the vtypei
+    static uint32_t vtype(uint32_t sew, uint32_t lmul);
+    void vsetvli(uint32_t rd, uint32_t rs1, uint32_t vtypei) { emit(((vtypei & 0x7ff) << 20) | (rs1 << 15) | (funct3_opcfg << 12) | (rd << 7) | opcode_op_v); }
+    void vsetivli(uint32_t rd, uint32_t avl, uint32_t vtypei) { emit(0xc0000000 | ((vtypei & 0x3ff) << 20) | ((avl & 0x1f) << 15) | (funct3_opcfg << 12) | (rd << 7) | opcode_op_v); }
+    void vsetvl(uint32_t rd, uint32_t rs1, uint32_t rs2) { emit(0x80000000 | (rs2 << 20) | (rs1 << 15) | (funct3_opcfg << 12) | (rd << 7) | opcode_op_v); }
+    void vle8(uint32_t vd, uint32_t rs1) { vmem(opcode_load_fp, funct3_vle8, vd, rs1); }
+    void vle16(uint32_t vd, uint32_t rs1) { vmem(opcode_load_fp, funct3_vle16, vd, rs1); }
+    void vle32(uint32_t vd, uint32_t rs1) { vmem(opcode_load_fp, funct3_vle32, vd, rs1); }
+    void vle64(uint32_t vd, uint32_t rs1) { vmem(opcode_load_fp, funct3_vle64, vd, rs1); }
+    void vse8(uint32_t vs3, uint32_t rs1) { vmem(opcode_store_fp, funct3_vle8, vs3, rs1); }
+    void vse16(uint32_t vs3, uint32_t rs1) { vmem(opcode_store_fp, funct3_vle16, vs3, rs1); }
+    void vse32(uint32_t vs3, uint32_t rs1) { vmem(opcode_store_fp, funct3_vle32, vs3, rs1); }
+    void vse64(uint32_t vs3, uint32_t rs1) { vmem(opcode_store_fp, funct3_vle64, vs3, rs1); }
+    void vadd_vv(uint32_t vd, uint32_t vs2, uint32_t vs1) { vop(funct6_vadd, funct3_opivv, vd, vs2, vs1); }
+    void vadd_vx(uint32_t vd, uint32_t vs2, uint32_t rs1) { vop(funct6_vadd, funct3_opivx, vd, vs2, rs1); }
+    void vadd_vi(uint32_t vd, uint32_t vs2, int32_t imm) { vop(funct6_vadd, funct3_opivi, vd, vs2, imm & 0x1f); }
+    void vsub_vv(uint32_t vd, uint32_t vs2, uint32_t vs1) { vop(funct6_vsub, funct3_opivv, vd, vs2, vs1); }
+    void vsub_vx(uint32_t vd, uint32_t vs2, uint32_t rs1) { vop(funct6_vsub, funct3_opivx, vd, vs2, rs1); }
+    void vand_vv(uint32_t vd, uint32_t vs2, uint32_t vs1) { vop(funct6_vand, funct3_opivv, vd, vs2, vs1); }
+    void vand_vx(uint32_t vd, uint32_t vs2, uint32_t rs1) { vop(funct6_vand, funct3_opivx, vd, vs2, rs1); }
+    void vand_vi(uint32_t vd, uint32_t vs2, int32_t imm) { vop(funct6_vand, funct3_opivi, vd, vs2, imm & 0x1f); }
+    void vor_vv(uint32_t vd, uint32_t vs2, uint32_t vs1) { vop(funct6_vor, funct3_opivv, vd, vs2, vs1); }
+    void vor_vx(uint32_t vd, uint32_t vs2, uint32_t rs1) { vop(funct6_vor, funct3_opivx, vd, vs2, rs1); }
+    void vor_vi(uint32_t vd, uint32_t vs2, int32_t imm) { vop(funct6_vor, funct3_opivi, vd, vs2, imm & 0x1f); }
+    void vxor_vv(uint32_t vd, uint32_t vs2, uint32_t vs1) { vop(funct6_vxor, funct3_opivv, vd, vs2, vs1); }
+    void vxor_vx(uint32_t vd, uint32_t vs2, uint32_t rs1) { vop(funct6_vxor, funct3_opivx, vd, vs2, rs1); }
+    void vxor_vi(uint32_t vd, uint32_t vs2, int32_t imm) { vop(funct6_vxor, funct3_opivi, vd, vs2, imm & 0x1f); }
+    void vmul_vv(uint32_t vd, uint32_t vs2, uint32_t vs1) { vop(funct6_vmul, funct3_opmvv, vd, vs2, vs1); }
+    void vmul_vx(uint32_t vd, uint32_t vs2, uint32_t rs1) { vop(funct6_vmul, funct3_opmvx, vd, vs2, rs1); }
+    void vredsum_vs(uint32_t vd, uint32_t vs2, uint32_t vs1) { vop(funct6_vredsum, funct3_opmvv, vd, vs2, vs1); }
+    void vredand_vs(uint32_t vd, uint32_t vs2, uint32_t vs1) { vop(funct6_vredand, funct3_opmvv, vd, vs2, vs1); }
+    void vredor_vs(uint32_t vd, uint32_t vs2, uint32_t vs1) { vop(funct6_vredor, funct3_opmvv, vd, vs2, vs1); }
+    void vredxor_vs(uint32_t vd, uint32_t vs2, uint32_t vs1) { vop(funct6_vredxor, funct3_opmvv, vd, vs2, vs1); }
+    void vredminu_vs(uint32_t vd, uint32_t vs2, uint32_t vs1) { vop(funct6_vredminu, funct3_opmvv, vd, vs2, vs1); }
+    void vredmin_vs(uint32_t vd, uint32_t vs2, uint32_t vs1) { vop(funct6_vredmin, funct3_opmvv, vd, vs2, vs1); }
+    void vredmaxu_vs(uint32_t vd, uint32_t vs2, uint32_t vs1) { vop(funct6_vredmaxu, funct3_opmvv, vd, vs2, vs1); }
+    void vredmax_vs(uint32_t vd, uint32_t vs2, uint32_t vs1) { vop(funct6_vredmax, funct3_opmvv, vd, vs2, vs1); }
+
+    // the CSR numbers and rounding modes for the csr instructions
+    using rv32i_decode::csr_fflags;
+    using rv32i_decode::csr_frm;
+    using rv32i_decode::csr_fcsr;
+    using rv32i_decode::csr_mcycle;
+    using rv32i_decode::csr_minstret;
+    using rv32i_decode::csr_mcycleh;
+    using rv32i_decode::csr_minstreth;
+    using rv32i_decode::csr_cycle;
+    using rv32i_decode::csr_instret;
+    using rv32i_decode::csr_cycleh;
+    using rv32i_decode::csr_instreth;
+    using rv32i_decode::rm_rne;
+    using rv32i_decode::rm_rtz;
+    using rv32i_decode::rm_rdn;
+    using rv32i_decode::rm_rup;
+    using rv32i_decode::rm_rmm;
+    using rv32i_decode::rm_dyn;
+    void csrrw(uint32_t rd, uint32_t csr, uint32_t rs1) { itype(opcode_system, funct3_csrrw, rd, rs1, csr); }
+    void csrrs(uint32_t rd, uint32_t csr, uint32_t rs1) { itype(opcode_system, funct3_csrrs, rd, rs1, csr); }
+    void csrrc(uint32_t rd, uint32_t csr, uint32_t rs1) { itype(opcode_system, funct3_csrrc, rd, rs1, csr); }
+    void csrrwi(uint32_t rd, uint32_t csr, uint32_t uimm) { itype(opcode_system, funct3_csrrwi, rd, uimm & 0x1f, csr); }
+    void csrrsi(uint32_t rd, uint32_t csr, uint32_t uimm) { itype(opcode_system, funct3_csrrsi, rd, uimm & 0x1f, csr); }
+    void csrrci(uint32_t rd, uint32_t csr, uint32_t uimm) { itype(opcode_system, funct3_csrrci, rd, uimm & 0x1f, csr); }
+    void ecall() { emit(insn_ecall); }
+    void ebreak() { emit(insn_ebreak); }
+
+    // pseudo instructions
+    void li(uint32_t rd, int32_t val);
+    void mv(uint32_t rd, uint32_t rs1) { addi(rd, rs1, 0); }
+    void j(label l) { jal(zero, l); }
+    void call(label l) { jal(ra, l); }
+    void ret() { jalr(zero, ra, 0); }
+
+    void word(uint32_t w) { emit(w); }
+
+    const std::vector<uint32_t> &finish();
+    bool save(const std::string &fname);
+
+private:
+    struct fixup
+    {
+        uint32_t pos;                       ///< index of the instruction word
+        label target;
+    };
+
+    void emit(uint32_t insn) { code.push_back(insn); }
+    void itype(uint32_t opcode, uint32_t funct3, uint32_t rd, uint32_t rs1, int32_t imm);
+    void stype(uint32_t funct3, uint32_t rs2, uint32_t rs1, int32_t imm);
+    void rtype(uint32_t funct7, uint32_t funct3, uint32_t rd, uint32_t rs1, uint32_t rs2, uint32_t opcode = opcode_rtype);
+    void vmem(uint32_t opcode, uint32_t width, uint32_t vd, uint32_t rs1);
+    void vop(uint32_t funct6, uint32_t funct3, uint32_t vd, uint32_t vs2, uint32_t vs1);
+    void branch(uint32_t funct3, uint32_t rs1, uint32_t rs2, label l);
+
+    static uint32_t encode_b(uint32_t insn, int32_t off);
+    static uint32_t encode_j(uint32_t insn, int32_t off);
+
+    std::vector<uint32_t> code;
+    std::vector<int64_t> labels;            ///< byte address, -1 until bound
+    std::vector<fixup> fixups;
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "rv32i_decode.h"
+#include <cstring>
 
 /**
  * decode function used to call different render types
@@ -48,6 +49,14 @@ switch(get_opcode(insn))
             case funct3_lw: return render_itype_load( insn, "lw");
             case funct3_lbu: return render_itype_load( insn, "lbu");
             case funct3_lhu: return render_itype_load( insn, "lhu");
+            case funct3_ld:
+                if(XLEN < 64)
+                    return render_illegal_insn(insn);
+                return render_itype_load( insn, "ld");
+            case funct3_lwu:
+                if(XLEN < 64)
+                    return render_illegal_insn(insn);
+                return render_itype_load( insn, "lwu");
 
         }
      assert(0 && "unrecognized funct3");  //impossible
@@ -59,6 +68,10 @@ switch(get_opcode(insn))
            case funct3_sb: return render_stype( insn,"sb");
            case funct3_sh: return render_stype( insn, "sh");
            case funct3_sw: return render_stype( insn, "sw");
+           case funct3_sd:
+                if(XLEN < 64)
+                    return render_illegal_insn(insn);
+                return render_stype( insn, "sd");
 
         }
     assert(0 && "unrecognized funct3");  //impossible
@@ -68,7 +81,22 @@ switch(get_opcode(insn))
         {
             default: return render_illegal_insn(insn);
             case funct3_add: return render_itype_alu(insn, "addi", get_imm_i(insn));
-            case funct3_sll: return render_itype_alu(insn, "slli", get_imm_i(insn)%XLEN);
+            case funct3_sll:
+                if(funct7 == funct7_rot)            // Zbb count instructions
+                {
+                    switch(get_rs2(insn))
+                    {
+                        default: return render_illegal_insn(insn);
+                        case rs2_clz: return render_unary(insn, "clz");
+                        case rs2_ctz: return render_unary(insn, "ctz");
+                        case rs2_cpop: return render_unary(insn, "cpop");
+                        case rs2_sextb: return render_unary(insn, "sext.b");
+                        case rs2_sexth: return render_unary(insn, "sext.h");
+                    }
+                }
+                if((funct7 & xlen_t::funct7_mask) != 0)
+                    return render_illegal_insn(insn);
+                return render_itype_alu(insn, "slli", get_imm_i(insn)%XLEN);
             case funct3_slt: return render_itype_alu(insn, "slti", get_imm_i(insn));
             case funct3_sltu: return render_itype_alu(insn, "sltiu", get_imm_i(insn));
             case funct3_xor: return render_itype_alu(insn, "xori", get_imm_i(insn));
@@ -77,11 +105,20 @@ switch(get_opcode(insn))
             case funct3_and: return render_itype_alu(insn, "andi", get_imm_i(insn));
 
             case funct3_srx:
-                switch(funct7)
+                switch(funct7 & xlen_t::funct7_mask)     // RV64I uses the low funct7 bit for shamt
                 {
                     default: return render_illegal_insn(insn);
                     case funct7_sra: return render_itype_alu(insn, "srai", get_imm_i(insn)%XLEN);
                     case funct7_srl: return render_itype_alu(insn, "srli", get_imm_i(insn)%XLEN);
+                    case funct7_rot: return render_itype_alu(insn, "rori", get_imm_i(insn)%XLEN);
+                    case funct7_rev8:
+                        if(get_rs2(insn) == rs2_rev8)
+                            return render_unary(insn, "rev8");
+                        return render_illegal_insn(insn);
+                    case funct7_orcb:
+                        if(get_rs2(insn) == rs2_orcb)
+                            return render_unary(insn, "orc.b");
+                        return render_illegal_insn(insn);
                 }
 
             assert(0 && "unrecognized funct7");  //impossible
@@ -90,6 +127,59 @@ switch(get_opcode(insn))
         assert(0 && "unrecognized funct3");  //impossible
 
         case opcode_rtype:
+            if(funct7 == funct7_muldiv)         // RV32M
+            {
+                switch(funct3)
+                {
+                    default: return render_illegal_insn(insn);
+                    case funct3_mul: return render_rtype(insn,"mul");
+                    case funct3_mulh: return render_rtype(insn,"mulh");
+                    case funct3_mulhsu: return render_rtype(insn,"mulhsu");
+                    case funct3_mulhu: return render_rtype(insn,"mulhu");
+                    case funct3_div: return render_rtype(insn,"div");
+                    case funct3_divu: return render_rtype(insn,"divu");
+                    case funct3_rem: return render_rtype(insn,"rem");
+                    case funct3_remu: return render_rtype(insn,"remu");
+                }
+            }
+            if(funct7 == funct7_shadd)          // Zba
+            {
+                switch(funct3)
+                {
+                    default: return render_illegal_insn(insn);
+                    case funct3_sh1add: return render_rtype(insn,"sh1add");
+                    case funct3_sh2add: return render_rtype(insn,"sh2add");
+                    case funct3_sh3add: return render_rtype(insn,"sh3add");
+                }
+            }
+            if(funct7 == funct7_minmax)         // Zbb
+            {
+                switch(funct3)
+                {
+                    default: return render_illegal_insn(insn);
+                    case funct3_min: return render_rtype(insn,"min");
+                    case funct3_minu: return render_rtype(insn,"minu");
+                    case funct3_max: return render_rtype(insn,"max");
+                    case funct3_maxu: return render_rtype(insn,"maxu");
+                }
+            }
+            if(funct7 == funct7_rot)            // Zbb
+            {
+                switch(funct3)
+                {
+                    default: return render_illegal_insn(insn);
+                    case funct3_rol: return render_rtype(insn,"rol");
+                    case funct3_ror: return render_rtype(insn,"ror");
+                }
+            }
+            if(funct7 == funct7_zexth && XLEN == 32)    // Zbb, RV64 has it in OP-32
+            {
+                if(funct3 == funct3_zexth && get_rs2(insn) == 0)
+                    return render_unary(insn, "zext.h");
+                return render_illegal_insn(insn);
+            }
+            if(funct7 != funct7_add && funct7 != funct7_sub)
+                return render_illegal_insn(insn);
             switch(funct3)
             {
                 default: return render_illegal_insn(insn);
@@ -100,12 +190,21 @@ switch(get_opcode(insn))
                         case funct7_add: return render_rtype(insn,"add");
                         case funct7_sub: return render_rtype(insn,"sub");
                     }
-                case funct3_sll: return render_rtype(insn,"sll");
-                case funct3_slt: return  render_rtype(insn,"slt");
-                case funct3_sltu: return render_rtype(insn,"sltu");
-                case funct3_xor: return  render_rtype(insn,"xor");
-                case funct3_or: return  render_rtype(insn,"or");
-                case funct3_and: return render_rtype(insn,"and");
+                case funct3_sll:
+                    if(funct7 != funct7_add)
+                        return render_illegal_insn(insn);
+                    return render_rtype(insn,"sll");
+                case funct3_slt:
+                    if(funct7 != funct7_add)
+                        return render_illegal_insn(insn);
+                    return  render_rtype(insn,"slt");
+                case funct3_sltu:
+                    if(funct7 != funct7_add)
+                        return render_illegal_insn(insn);
+                    return render_rtype(insn,"sltu");
+                case funct3_xor: return  render_rtype(insn, funct7 == funct7_sub ? "xnor" : "xor");
+                case funct3_or: return  render_rtype(insn, funct7 == funct7_sub ? "orn" : "or");
+                case funct3_and: return render_rtype(insn, funct7 == funct7_sub ? "andn" : "and");
                 case funct3_srx:
                 switch(funct7)
                 {
@@ -119,6 +218,202 @@ switch(get_opcode(insn))
             }
             assert(0 && "unrecognized funct7");  //impossible
 
+        case opcode_alu_imm_w:              // RV64I only
+            if(XLEN < 64)
+                return render_illegal_insn(insn);
+            switch(funct3)
+            {
+                default: return render_illegal_insn(insn);
+                case funct3_add: return render_itype_alu(insn, "addiw", get_imm_i(insn));
+                case funct3_sll:
+                    if(funct7 != 0)
+                        return render_illegal_insn(insn);
+                    return render_itype_alu(insn, "slliw", get_imm_i(insn)%32);
+                case funct3_srx:
+                    switch(funct7)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct7_sra: return render_itype_alu(insn, "sraiw", get_imm_i(insn)%32);
+                        case funct7_srl: return render_itype_alu(insn, "srliw", get_imm_i(insn)%32);
+                    }
+            }
+
+        case opcode_rtype_w:                // RV64I and RV64M only
+            if(XLEN < 64)
+                return render_illegal_insn(insn);
+            if(funct7 == funct7_muldiv)
+            {
+                switch(funct3)
+                {
+                    default: return render_illegal_insn(insn);
+                    case funct3_mul: return render_rtype(insn,"mulw");
+                    case funct3_div: return render_rtype(insn,"divw");
+                    case funct3_divu: return render_rtype(insn,"divuw");
+                    case funct3_rem: return render_rtype(insn,"remw");
+                    case funct3_remu: return render_rtype(insn,"remuw");
+                }
+            }
+            if(funct7 == funct7_zexth)          // Zbb
+            {
+                if(funct3 == funct3_zexth && get_rs2(insn) == 0)
+                    return render_unary(insn, "zext.h");
+                return render_illegal_insn(insn);
+            }
+            switch(funct3)
+            {
+                default: return render_illegal_insn(insn);
+                case funct3_add:
+                    switch(funct7)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct7_add: return render_rtype(insn,"addw");
+                        case funct7_sub: return render_rtype(insn,"subw");
+                    }
+                case funct3_sll:
+                    if(funct7 != 0)
+                        return render_illegal_insn(insn);
+                    return render_rtype(insn,"sllw");
+                case funct3_srx:
+                    switch(funct7)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct7_sra: return render_rtype(insn,"sraw");
+                        case funct7_srl: return render_rtype(insn,"srlw");
+                    }
+            }
+
+        case opcode_load_fp:
+            if(funct3 == funct3_flw)
+                return render_fp_load(insn);
+            if(is_vector_mem(insn))
+                return render_vmem(insn, "vle");
+            return render_illegal_insn(insn);
+
+        case opcode_store_fp:
+            if(funct3 == funct3_fsw)
+                return render_fp_store(insn);
+            if(is_vector_mem(insn))
+                return render_vmem(insn, "vse");
+            return render_illegal_insn(insn);
+
+        case opcode_op_v:
+            switch(funct3)
+            {
+                default: return render_illegal_insn(insn);
+                case funct3_opcfg: return render_vsetvl(insn);
+                case funct3_opivv:
+                case funct3_opivx:
+                case funct3_opivi:
+                    switch(get_funct6(insn))
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct6_vadd: return render_vop(insn, "vadd");
+                        case funct6_vsub:
+                            if(funct3 == funct3_opivi)          // there is no vsub.vi
+                                return render_illegal_insn(insn);
+                            return render_vop(insn, "vsub");
+                        case funct6_vand: return render_vop(insn, "vand");
+                        case funct6_vor: return render_vop(insn, "vor");
+                        case funct6_vxor: return render_vop(insn, "vxor");
+                    }
+                case funct3_opmvx:
+                    if(get_funct6(insn) == funct6_vmul)
+                        return render_vop(insn, "vmul");
+                    return render_illegal_insn(insn);
+                case funct3_opmvv:
+                    switch(get_funct6(insn))
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct6_vmul: return render_vop(insn, "vmul");
+                        case funct6_vredsum: return render_vop(insn, "vredsum");
+                        case funct6_vredand: return render_vop(insn, "vredand");
+                        case funct6_vredor: return render_vop(insn, "vredor");
+                        case funct6_vredxor: return render_vop(insn, "vredxor");
+                        case funct6_vredminu: return render_vop(insn, "vredminu");
+                        case funct6_vredmin: return render_vop(insn, "vredmin");
+                        case funct6_vredmaxu: return render_vop(insn, "vredmaxu");
+                        case funct6_vredmax: return render_vop(insn, "vredmax");
+                    }
+            }
+
+        case opcode_fmadd:
+        case opcode_fmsub:
+        case opcode_fnmsub:
+        case opcode_fnmadd:
+            if(get_fmt(insn) != fmt_s)
+                return render_illegal_insn(insn);
+            switch(get_opcode(insn))
+            {
+                default: return render_fp_r4type(insn, "fmadd.s");
+                case opcode_fmsub: return render_fp_r4type(insn, "fmsub.s");
+                case opcode_fnmsub: return render_fp_r4type(insn, "fnmsub.s");
+                case opcode_fnmadd: return render_fp_r4type(insn, "fnmadd.s");
+            }
+
+        case opcode_op_fp:
+            switch(funct7)
+            {
+                default: return render_illegal_insn(insn);
+                case funct7_fadd_s: return render_fp_rtype(insn, "fadd.s", 'f', 'f', 'f', true);
+                case funct7_fsub_s: return render_fp_rtype(insn, "fsub.s", 'f', 'f', 'f', true);
+                case funct7_fmul_s: return render_fp_rtype(insn, "fmul.s", 'f', 'f', 'f', true);
+                case funct7_fdiv_s: return render_fp_rtype(insn, "fdiv.s", 'f', 'f', 'f', true);
+                case funct7_fsqrt_s:
+                    if(get_rs2(insn) != 0)
+                        return render_illegal_insn(insn);
+                    return render_fp_rtype(insn, "fsqrt.s", 'f', 'f', 0, true);
+                case funct7_fsgnj_s:
+                    switch(funct3)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct3_fsgnj: return render_fp_rtype(insn, "fsgnj.s", 'f', 'f', 'f', false);
+                        case funct3_fsgnjn: return render_fp_rtype(insn, "fsgnjn.s", 'f', 'f', 'f', false);
+                        case funct3_fsgnjx: return render_fp_rtype(insn, "fsgnjx.s", 'f', 'f', 'f', false);
+                    }
+                case funct7_fminmax_s:
+                    switch(funct3)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct3_fmin: return render_fp_rtype(insn, "fmin.s", 'f', 'f', 'f', false);
+                        case funct3_fmax: return render_fp_rtype(insn, "fmax.s", 'f', 'f', 'f', false);
+                    }
+                case funct7_fcvt_w_s:
+                    switch(get_rs2(insn))
+                    {
+                        default: return render_illegal_insn(insn);
+                        case rs2_fcvt_w: return render_fp_rtype(insn, "fcvt.w.s", 'x', 'f', 0, true);
+                        case rs2_fcvt_wu: return render_fp_rtype(insn, "fcvt.wu.s", 'x', 'f', 0, true);
+                    }
+                case funct7_fcvt_s_w:
+                    switch(get_rs2(insn))
+                    {
+                        default: return render_illegal_insn(insn);
+                        case rs2_fcvt_w: return render_fp_rtype(insn, "fcvt.s.w", 'f', 'x', 0, true);
+                        case rs2_fcvt_wu: return render_fp_rtype(insn, "fcvt.s.wu", 'f', 'x', 0, true);
+                    }
+                case funct7_fmv_x_w:
+                    if(get_rs2(insn) != 0)
+                        return render_illegal_insn(insn);
+                    switch(funct3)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct3_fmv_x_w: return render_fp_rtype(insn, "fmv.x.w", 'x', 'f', 0, false);
+                        case funct3_fclass: return render_fp_rtype(insn, "fclass.s", 'x', 'f', 0, false);
+                    }
+                case funct7_fcmp_s:
+                    switch(funct3)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct3_feq: return render_fp_rtype(insn, "feq.s", 'x', 'f', 'f', false);
+                        case funct3_flt: return render_fp_rtype(insn, "flt.s", 'x', 'f', 'f', false);
+                        case funct3_fle: return render_fp_rtype(insn, "fle.s", 'x', 'f', 'f', false);
+                    }
+                case funct7_fmv_w_x:
+                    if(get_rs2(insn) != 0 || funct3 != 0)
+                        return render_illegal_insn(insn);
+                    return render_fp_rtype(insn, "fmv.w.x", 'f', 'x', 0, false);
+            }
+
         case opcode_system:
             switch(funct3)
            {
@@ -167,7 +462,7 @@ uint32_t rv32i_decode::get_opcode(uint32_t insn)
  ********************************************************************************/
 uint32_t rv32i_decode::get_rd(uint32_t insn)
 {
-    return ((insn & 0x00000f00) >> 7);          // extracts the rd and extend
+    return ((insn & 0x00000f80) >> 7);          // extracts the rd and extend
 
 }
 
@@ -229,6 +524,95 @@ uint32_t rv32i_decode::get_funct7(uint32_t insn)
     return ((insn & 0xfe000000) >> 25);         // extracts the funct7 from the insn and shifts it 
 }
 
+/**
+ * get the funct6 value
+ *
+* @param insn is the instruction
+ * @return uint32_t
+ *
+ * @note returns the funct6 field of a vector instruction by shifting
+ ********************************************************************************/
+uint32_t rv32i_decode::get_funct6(uint32_t insn)
+{
+    return ((insn & 0xfc000000) >> 26);         // extracts funct6
+
+}
+
+/**
+ * get the vector mask bit
+ *
+* @param insn is the instruction
+ * @return uint32_t
+ *
+ * @note returns 1 for an unmasked vector instruction and 0 when v0 is the mask
+ ********************************************************************************/
+uint32_t rv32i_decode::get_vm(uint32_t insn)
+{
+    return ((insn & 0x02000000) >> 25);         // extracts vm
+
+}
+
+/**
+ * get the element width of a vector load or store
+ *
+* @param insn is the instruction
+ * @return uint32_t the width in bits, 0 if the width field is not a vector width
+ ********************************************************************************/
+uint32_t rv32i_decode::get_veew(uint32_t insn)
+{
+    switch(get_funct3(insn))
+    {
+        default: return 0;
+        case funct3_vle8: return 8;
+        case funct3_vle16: return 16;
+        case funct3_vle32: return 32;
+        case funct3_vle64: return 64;
+    }
+
+}
+
+/**
+ * test for a unit-stride vector load or store
+ *
+* @param insn is the instruction
+ * @return bool true for vle/vse, the only vector memory instructions supported
+ *
+ * @note nf, mew and mop must be 0 and lumop must be a plain unit-stride access
+ ********************************************************************************/
+bool rv32i_decode::is_vector_mem(uint32_t insn)
+{
+    return get_veew(insn) != 0 && (insn & 0xfc000000) == 0 && get_rs2(insn) == 0;
+
+}
+
+/**
+ * get the register 3 value
+ *
+* @param insn is the instruction
+ * @return uint32_t
+ *
+ * @note returns the rs3 field of an R4 type instruction by shifting
+ ********************************************************************************/
+uint32_t rv32i_decode::get_rs3(uint32_t insn)
+{
+    return ((insn & 0xf8000000) >> 27);         // extracts rs3
+
+}
+
+/**
+ * get the floating point format value
+ *
+* @param insn is the instruction
+ * @return uint32_t
+ *
+ * @note returns the fmt field of an R4 type instruction by masking and shifting
+ ********************************************************************************/
+uint32_t rv32i_decode::get_fmt(uint32_t insn)
+{
+    return ((insn & 0x06000000) >> 25);         // extracts fmt
+
+}
+
 /**
  * get the imm i value
  *
@@ -277,7 +661,7 @@ int32_t rv32i_decode::get_imm_b(uint32_t insn)
     int32_t imm_b = (insn & 0x80000000) >> (31-12);      //extracts the signed bit 
     imm_b |= (insn & 0x7e000000) >> (25-5);                 // extracts the imm[12]
     imm_b |= (insn & 0x00000f00) >> (8-1);                  // extracts the imm[4;1]
-    imm_b |= (insn & 0x00000080) >> (11-7);                  // extracts the imm[11]
+    imm_b |= (insn & 0x00000080) << (11-7);                  // extracts the imm[11]
 
     if(insn & 0x80000000)                               // if neg 
     imm_b |= 0xffffe000;
@@ -320,7 +704,7 @@ int32_t rv32i_decode::get_imm_j(uint32_t insn)
 {
     int32_t imm_j = (insn & 0x80000000) >> (31-20); // get the first half of the imm_j
     imm_j |= (insn & 0x7fe00000) >> (25-5);
-    imm_j |= (insn & 0x00100000) >> (8-1);          // get the second half of the imm_j
+    imm_j |= (insn & 0x00100000) >> (20-11);        // get the second half of the imm_j
     imm_j |= (insn & 0x000ff000);
 
     if(insn & 0x80000000)                           // if neg 
@@ -404,7 +788,7 @@ std::string rv32i_decode::render_jal(uint32_t addr, uint32_t insn)
     std::ostringstream os;
                                     // formats output
     os << render_mnemonic("jal") << render_reg(rd) << ","
-       << to_hex0x32((imm_j));
+       << to_hex0x32(addr + imm_j);     // the target, not the offset
 
     return os.str();
 
@@ -442,29 +826,18 @@ std::string rv32i_decode::render_jalr(uint32_t insn)
 * @param mnemonic is the mnemonic of the instruction
  * @return string value to print to os
  *
- * @note renders a btype instruction to print to standard output by if it is signed or unsigned
+ * @note renders a btype instruction to print to standard output with the branch target
  ********************************************************************************/
 std::string rv32i_decode::render_btype(uint32_t addr, uint32_t insn, const char *mnemonic)
 {
     std::ostringstream os;
-    uint32_t funct3 = get_funct3(insn);
     int32_t imm_b = get_imm_b(insn);
     uint32_t rs1 = get_rs1(insn);
     uint32_t rs2 = get_rs2(insn);
 
-   if(funct3 == funct3_bltu ||funct3 == funct3_bgeu )
-    {
-        uint32_t uImm_b = (uint32_t) imm_b;
-        os << render_mnemonic(mnemonic) << render_reg(rs1) << ","
-     << render_reg(rs2) << "," << to_hex0x32(uImm_b);
-    return os.str();
-
-    }
-
-        // formats output
+        // formats output with the target, not the offset
     os << render_mnemonic(mnemonic) << render_reg(rs1) << ","
-     << render_reg(rs2) << "," << to_hex0x32(imm_b);
-
+     << render_reg(rs2) << "," << to_hex0x32(addr + imm_b);
 
     return os.str();
 }
@@ -487,7 +860,7 @@ std::string rv32i_decode::render_itype_load(uint32_t insn, const char *mnemonic)
 
         // formatting output
      os << render_mnemonic(mnemonic) << render_reg(rd) << ","
-     << render_base_disp(imm_i,rs1);
+     << render_base_disp(rs1,imm_i);
 
      return os.str();
 }
@@ -512,7 +885,7 @@ std::string rv32i_decode::render_stype(uint32_t insn, const char *mnemonic)
 
     // formatting output
     os << render_mnemonic(mnemonic) << render_reg(rs2) 
-     << "," << render_base_disp(imm_s,rs1);    
+     << "," << render_base_disp(rs1,imm_s);    
 
 
     return os.str();
@@ -571,6 +944,30 @@ std::string rv32i_decode::render_rtype(uint32_t insn, const char *mnemonic)
 
 }
 
+/**
+ * renders a one operand print format
+ *
+* @param insn is the instruction
+* @param mnemonic is the mnemonic of the instruction
+ * @return string value to print to os
+ *
+ * @note renders a rd,rs1 instruction such as clz to print to standard output
+ ********************************************************************************/
+std::string rv32i_decode::render_unary(uint32_t insn, const char *mnemonic)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+
+    std::ostringstream os;
+
+        // formatting output
+     os << render_mnemonic(mnemonic) << render_reg(rd) << ","
+     << render_reg(rs1);
+
+    return os.str();
+
+}
+
 /**
  * renders a ecall to print format
  *
@@ -612,12 +1009,12 @@ std::string rv32i_decode::render_csrrx(uint32_t insn, const char *mnemonic)
 {
     std::ostringstream os;
     uint32_t rd = get_rd(insn);
-    int32_t imm_i = (insn & 0xfff00000);
+    uint32_t csr = (insn >> 20) & 0xfff;        // the CSR number is unsigned
     uint32_t rs1 = get_rs1(insn);
 
             // formatting the output 
    os << render_mnemonic(mnemonic) << render_reg(rd) << ","
-     << hex::to_hex0x12(imm_i >> 20) << "," << render_reg(rs1);
+     << hex::to_hex0x12(csr) << "," << render_reg(rs1);
 
 
     return os.str();
@@ -637,13 +1034,13 @@ std::string rv32i_decode::render_csrrxi(uint32_t insn, const char *mnemonic)
 {
     std::ostringstream os;
     uint32_t rd = get_rd(insn);
-    int32_t imm_i = (insn & 0xfff00000);        // get imm_i with out shifting
+    uint32_t csr = (insn >> 20) & 0xfff;        // the CSR number is unsigned
     uint32_t rs1 = get_rs1(insn);
 
     
     // formats output
    os << render_mnemonic(mnemonic) << render_reg(rd) << ","
-     << hex::to_hex0x12(imm_i >> 20) << "," << std::dec << rs1;
+     << hex::to_hex0x12(csr) << "," << std::dec << rs1;
 
 
     return os.str();
@@ -651,6 +1048,99 @@ std::string rv32i_decode::render_csrrxi(uint32_t insn, const char *mnemonic)
 
 }
 
+/**
+ * renders a flw print format
+ *
+* @param insn is the instruction
+ * @return string value to print to os
+ *
+ * @note renders a flw instruction to print to standard output
+ ********************************************************************************/
+std::string rv32i_decode::render_fp_load(uint32_t insn)
+{
+    std::ostringstream os;
+    uint32_t rd = get_rd(insn);
+    int32_t imm_i = get_imm_i(insn);
+    uint32_t rs1 = get_rs1(insn);
+
+        // formatting output
+     os << render_mnemonic("flw") << render_freg(rd) << ","
+     << render_base_disp(rs1,imm_i);
+
+     return os.str();
+}
+
+/**
+ * renders a fsw print format
+ *
+* @param insn is the instruction
+ * @return string value to print to os
+ *
+ * @note renders a fsw instruction to print to standard output
+ ********************************************************************************/
+std::string rv32i_decode::render_fp_store(uint32_t insn)
+{
+    std::ostringstream os;
+    int32_t imm_s = get_imm_s(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+
+        // formatting output
+     os << render_mnemonic("fsw") << render_freg(rs2) << ","
+     << render_base_disp(rs1,imm_s);
+
+     return os.str();
+}
+
+/**
+ * renders a fused multiply add print format
+ *
+* @param insn is the instruction
+* @param mnemonic is the mnemonic of the instruction
+ * @return string value to print to os
+ *
+ * @note renders a fmadd.s type instruction with its rounding mode
+ ********************************************************************************/
+std::string rv32i_decode::render_fp_r4type(uint32_t insn, const char *mnemonic)
+{
+    std::ostringstream os;
+
+        // formatting output
+     os << render_mnemonic(mnemonic) << render_freg(get_rd(insn)) << ","
+     << render_freg(get_rs1(insn)) << "," << render_freg(get_rs2(insn)) << ","
+     << render_freg(get_rs3(insn)) << render_rm(get_funct3(insn));
+
+     return os.str();
+}
+
+/**
+ * renders a floating point r type print format
+ *
+* @param insn is the instruction
+* @param mnemonic is the mnemonic of the instruction
+* @param rd_file 'f' or 'x' for the register file of rd
+* @param rs1_file 'f' or 'x' for the register file of rs1
+* @param rs2_file 'f' or 'x' for the register file of rs2, 0 if there is no rs2
+* @param rm true if the funct3 field is a rounding mode that should be shown
+ * @return string value to print to os
+ *
+ * @note renders an OP-FP instruction to print to standard output
+ ********************************************************************************/
+std::string rv32i_decode::render_fp_rtype(uint32_t insn, const char *mnemonic, char rd_file, char rs1_file, char rs2_file, bool rm)
+{
+    std::ostringstream os;
+
+    os << render_mnemonic(mnemonic)
+       << (rd_file == 'f' ? render_freg(get_rd(insn)) : render_reg(get_rd(insn))) << ","
+       << (rs1_file == 'f' ? render_freg(get_rs1(insn)) : render_reg(get_rs1(insn)));
+    if(rs2_file)
+        os << "," << (rs2_file == 'f' ? render_freg(get_rs2(insn)) : render_reg(get_rs2(insn)));
+    if(rm)
+        os << render_rm(get_funct3(insn));
+
+    return os.str();
+}
+
 /**
  * renders a register print format
  *
@@ -667,6 +1157,205 @@ std::string rv32i_decode::render_reg(int r)
 
 }
 
+/**
+ * renders a floating point register print format
+ *
+* @param r is the register
+ * @return string value to print to os
+ *
+ * @note renders a floating point register number to print to standard output
+ ********************************************************************************/
+std::string rv32i_decode::render_freg(int r)
+{
+    std::ostringstream os;      // prints the reg r in decicaml with a f
+    os << "f" << std::dec << r;
+    return os.str();
+
+}
+
+/**
+ * renders a vector register
+ *
+* @param r is the register number
+ * @return string value to print to os
+ ********************************************************************************/
+std::string rv32i_decode::render_vreg(int r)
+{
+    std::ostringstream os;      // prints the reg r in decicaml with a v
+    os << "v" << std::dec << r;
+    return os.str();
+
+}
+
+/**
+ * renders a vtype value the way the assembler takes it
+ *
+* @param vtype is the vtype immediate
+ * @return string value to print to os
+ *
+ * @note for example e32,m1,tu,mu, fractional and reserved values print as a number
+ ********************************************************************************/
+std::string rv32i_decode::render_vtype(uint32_t vtype)
+{
+    static const char *lmul[] = { "m1", "m2", "m4", "m8", "", "mf8", "mf4", "mf2" };
+    uint32_t vsew = (vtype >> 3) & 0x7;
+
+    std::ostringstream os;
+    if(vsew > 3 || (vtype & 0x7) == 4 || (vtype >> 8) != 0)
+    {
+        os << std::dec << vtype;
+        return os.str();
+    }
+    os << "e" << std::dec << (8 << vsew) << "," << lmul[vtype & 0x7]
+        << ((vtype & 0x40) ? ",ta" : ",tu") << ((vtype & 0x80) ? ",ma" : ",mu");
+    return os.str();
+
+}
+
+/**
+ * renders the vsetvli, vsetivli and vsetvl print formats
+ *
+* @param insn is the instruction
+ * @return string value to print to os
+ ********************************************************************************/
+std::string rv32i_decode::render_vsetvl(uint32_t insn)
+{
+    std::ostringstream os;
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+
+    if(!(insn & 0x80000000))                    // vsetvli
+        os << render_mnemonic("vsetvli") << render_reg(rd) << "," << render_reg(rs1) << ","
+        << render_vtype((insn >> 20) & 0x7ff);
+    else if((insn & 0xc0000000) == 0xc0000000)  // vsetivli
+        os << render_mnemonic("vsetivli") << render_reg(rd) << "," << std::dec << rs1 << ","
+        << render_vtype((insn >> 20) & 0x3ff);
+    else
+        os << render_mnemonic("vsetvl") << render_reg(rd) << "," << render_reg(rs1) << ","
+        << render_reg(get_rs2(insn));
+
+    return os.str();
+
+}
+
+/**
+ * renders a unit-stride vector load or store print format
+ *
+* @param insn is the instruction
+* @param mnemonic is vle or vse, the width is added from the instruction
+ * @return string value to print to os
+ ********************************************************************************/
+std::string rv32i_decode::render_vmem(uint32_t insn, const char *mnemonic)
+{
+    std::ostringstream os;
+    std::ostringstream m;
+    m << mnemonic << get_veew(insn) << ".v";
+
+    os << render_mnemonic(m.str()) << render_vreg(get_rd(insn)) << ",(" << render_reg(get_rs1(insn)) << ")";
+    if(!get_vm(insn))
+        os << ",v0.t";
+
+    return os.str();
+
+}
+
+/**
+ * renders a vector arithmetic or reduction print format
+ *
+* @param insn is the instruction
+* @param mnemonic is the mnemonic without the operand suffix
+ * @return string value to print to os
+ *
+ * @note the suffix (.vv .vx .vi .vs) comes from funct3, operands are vd,vs2,vs1/rs1/imm
+ ********************************************************************************/
+std::string rv32i_decode::render_vop(uint32_t insn, const char *mnemonic)
+{
+    std::ostringstream os;
+    std::string m = mnemonic;
+    std::string src;
+
+    switch(get_funct3(insn))
+    {
+        default:
+        case funct3_opivv:
+        case funct3_opmvv:
+            m += (m.compare(0, 4, "vred") == 0) ? ".vs" : ".vv";
+            src = render_vreg(get_rs1(insn));
+            break;
+        case funct3_opivx:
+        case funct3_opmvx:
+            m += ".vx";
+            src = render_reg(get_rs1(insn));
+            break;
+        case funct3_opivi:
+            m += ".vi";
+            src = std::to_string(((int32_t)(get_rs1(insn) << 27)) >> 27);        // simm5
+            break;
+    }
+
+    os << render_mnemonic(m) << render_vreg(get_rd(insn)) << "," << render_vreg(get_rs2(insn)) << "," << src;
+    if(!get_vm(insn))
+        os << ",v0.t";
+
+    return os.str();
+
+}
+
+/**
+ * renders a rounding mode print format
+ *
+* @param rm is the rounding mode field
+ * @return string value to print to os
+ *
+ * @note dynamic rounding is the default and is not shown
+ ********************************************************************************/
+std::string rv32i_decode::render_rm(uint32_t rm)
+{
+    switch(rm)
+    {
+        default: return ",rm?";
+        case rm_rne: return ",rne";
+        case rm_rtz: return ",rtz";
+        case rm_rdn: return ",rdn";
+        case rm_rup: return ",rup";
+        case rm_rmm: return ",rmm";
+        case rm_dyn: return "";
+    }
+}
+
+/**
+ * renders a single precision value print format
+ *
+* @param bits is the IEEE 754 bit pattern
+ * @return string value to print to os
+ *
+ * @note shows the hex bits followed by the sign and value in the same way
+ * as the Assign2 IEEE 754 decoder: +0, -inf, +nan or the decimal value
+ ********************************************************************************/
+std::string rv32i_decode::render_float(uint32_t bits)
+{
+    std::ostringstream os;
+    uint32_t exp = (bits & 0x7f800000) >> 23;
+    uint32_t sig = bits & 0x007fffff;
+
+    os << to_hex0x32(bits) << " (" << (bits & 0x80000000 ? '-':'+');
+    if(exp == 0 && sig == 0)                // zero
+        os << "0";
+    else if(exp == 0xff && sig == 0)        // exponent all 1s
+        os << "inf";
+    else if(exp == 0xff)
+        os << "nan";
+    else
+    {
+        float f;
+        bits &= 0x7fffffff;
+        std::memcpy(&f, &bits, sizeof(f));
+        os << std::setprecision(9) << f;
+    }
+    os << ")";
+    return os.str();
+}
+
 /**
  * renders a register print format
  *
@@ -694,6 +1383,9 @@ std::string rv32i_decode::render_base_disp(uint32_t reg, int32_t imm)
  ********************************************************************************/
 std::string rv32i_decode::render_mnemonic(const std::string &m)
 {
+    if(m.size() >= (size_t)mnemonic_width)      // long F mnemonics still need a space
+        return m + " ";
+
     std::ostringstream os;              // sets the mnemonic width to all be the same
     os << std::left << std::setw(mnemonic_width) << m;
     return os.str();
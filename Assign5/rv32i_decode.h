@@ -4,6 +4,7 @@
 #include <string>
 #include <cassert>
 #include "hex.h"
+#include "xlen.h"
 
 class rv32i_decode : public hex
 {
@@ -25,6 +26,16 @@ protected:
     static constexpr uint32_t opcode_alu_imm        = 0b0010011;
     static constexpr uint32_t opcode_rtype          = 0b0110011; 
     static constexpr uint32_t opcode_system         = 0b1110011;
+    static constexpr uint32_t opcode_alu_imm_w      = 0b0011011;
+    static constexpr uint32_t opcode_rtype_w        = 0b0111011;
+    static constexpr uint32_t opcode_load_fp        = 0b0000111;
+    static constexpr uint32_t opcode_store_fp       = 0b0100111;
+    static constexpr uint32_t opcode_fmadd          = 0b1000011;
+    static constexpr uint32_t opcode_fmsub          = 0b1000111;
+    static constexpr uint32_t opcode_fnmsub         = 0b1001011;
+    static constexpr uint32_t opcode_fnmadd         = 0b1001111;
+    static constexpr uint32_t opcode_op_fp          = 0b1010011;
+    static constexpr uint32_t opcode_op_v           = 0b1010111;
 
     static constexpr uint32_t funct3_beq            = 0b000;
     static constexpr uint32_t funct3_bne            = 0b001;
@@ -38,10 +49,13 @@ protected:
     static constexpr uint32_t funct3_lw             = 0b010;
     static constexpr uint32_t funct3_lbu            = 0b100;
     static constexpr uint32_t funct3_lhu            = 0b101;
+    static constexpr uint32_t funct3_ld             = 0b011;
+    static constexpr uint32_t funct3_lwu            = 0b110;
 
     static constexpr uint32_t funct3_sb             = 0b000;
     static constexpr uint32_t funct3_sh             = 0b001;
     static constexpr uint32_t funct3_sw             = 0b010;
+    static constexpr uint32_t funct3_sd             = 0b011;
 
     static constexpr uint32_t funct3_add            = 0b000;
     static constexpr uint32_t funct3_sll            = 0b001;
@@ -58,6 +72,109 @@ protected:
     static constexpr uint32_t funct7_add            = 0b0000000;
     static constexpr uint32_t funct7_sub            = 0b0100000;
 
+    static constexpr uint32_t funct7_muldiv         = 0b0000001;
+
+    static constexpr uint32_t funct3_mul            = 0b000;
+    static constexpr uint32_t funct3_mulh           = 0b001;
+    static constexpr uint32_t funct3_mulhsu         = 0b010;
+    static constexpr uint32_t funct3_mulhu          = 0b011;
+    static constexpr uint32_t funct3_div            = 0b100;
+    static constexpr uint32_t funct3_divu           = 0b101;
+    static constexpr uint32_t funct3_rem            = 0b110;
+    static constexpr uint32_t funct3_remu           = 0b111;
+
+    static constexpr uint32_t funct7_shadd          = 0b0010000;
+    static constexpr uint32_t funct7_minmax         = 0b0000101;
+    static constexpr uint32_t funct7_rot            = 0b0110000;
+    static constexpr uint32_t funct7_rev8           = 0b0110100;
+    static constexpr uint32_t funct7_orcb           = 0b0010100;
+    static constexpr uint32_t funct7_zexth          = 0b0000100;
+
+    static constexpr uint32_t funct3_sh1add         = 0b010;
+    static constexpr uint32_t funct3_sh2add         = 0b100;
+    static constexpr uint32_t funct3_sh3add         = 0b110;
+    static constexpr uint32_t funct3_min            = 0b100;
+    static constexpr uint32_t funct3_minu           = 0b101;
+    static constexpr uint32_t funct3_max            = 0b110;
+    static constexpr uint32_t funct3_maxu           = 0b111;
+    static constexpr uint32_t funct3_rol            = 0b001;
+    static constexpr uint32_t funct3_ror            = 0b101;
+    static constexpr uint32_t funct3_zexth          = 0b100;
+
+    static constexpr uint32_t rs2_clz               = 0b00000;
+    static constexpr uint32_t rs2_ctz               = 0b00001;
+    static constexpr uint32_t rs2_cpop              = 0b00010;
+    static constexpr uint32_t rs2_rev8              = 0b11000;
+    static constexpr uint32_t rs2_orcb              = 0b00111;
+    static constexpr uint32_t rs2_sextb             = 0b00100;
+    static constexpr uint32_t rs2_sexth             = 0b00101;
+
+    static constexpr uint32_t funct3_flw            = 0b010;
+    static constexpr uint32_t funct3_fsw            = 0b010;
+
+    static constexpr uint32_t funct7_fadd_s         = 0b0000000;
+    static constexpr uint32_t funct7_fsub_s         = 0b0000100;
+    static constexpr uint32_t funct7_fmul_s         = 0b0001000;
+    static constexpr uint32_t funct7_fdiv_s         = 0b0001100;
+    static constexpr uint32_t funct7_fsqrt_s        = 0b0101100;
+    static constexpr uint32_t funct7_fsgnj_s        = 0b0010000;
+    static constexpr uint32_t funct7_fminmax_s      = 0b0010100;
+    static constexpr uint32_t funct7_fcvt_w_s       = 0b1100000;
+    static constexpr uint32_t funct7_fcvt_s_w       = 0b1101000;
+    static constexpr uint32_t funct7_fmv_x_w        = 0b1110000;
+    static constexpr uint32_t funct7_fcmp_s         = 0b1010000;
+    static constexpr uint32_t funct7_fmv_w_x        = 0b1111000;
+
+    static constexpr uint32_t funct3_fsgnj          = 0b000;
+    static constexpr uint32_t funct3_fsgnjn         = 0b001;
+    static constexpr uint32_t funct3_fsgnjx         = 0b010;
+    static constexpr uint32_t funct3_fmin           = 0b000;
+    static constexpr uint32_t funct3_fmax           = 0b001;
+    static constexpr uint32_t funct3_feq            = 0b010;
+    static constexpr uint32_t funct3_flt            = 0b001;
+    static constexpr uint32_t funct3_fle            = 0b000;
+    static constexpr uint32_t funct3_fmv_x_w        = 0b000;
+    static constexpr uint32_t funct3_fclass         = 0b001;
+
+    static constexpr uint32_t rs2_fcvt_w            = 0b00000;
+    static constexpr uint32_t rs2_fcvt_wu           = 0b00001;
+
+    static constexpr uint32_t fmt_s                 = 0b00;
+
+    static constexpr uint32_t rm_rne                = 0b000;
+    static constexpr uint32_t rm_rtz                = 0b001;
+    static constexpr uint32_t rm_rdn                = 0b010;
+    static constexpr uint32_t rm_rup                = 0b011;
+    static constexpr uint32_t rm_rmm                = 0b100;
+    static constexpr uint32_t rm_dyn                = 0b111;
+
+    static constexpr uint32_t funct3_opivv          = 0b000;
+    static constexpr uint32_t funct3_opmvv          = 0b010;
+    static constexpr uint32_t funct3_opivi          = 0b011;
+    static constexpr uint32_t funct3_opivx          = 0b100;
+    static constexpr uint32_t funct3_opmvx          = 0b110;
+    static constexpr uint32_t funct3_opcfg          = 0b111;
+
+    static constexpr uint32_t funct3_vle8           = 0b000;      // also the vse widths
+    static constexpr uint32_t funct3_vle16          = 0b101;
+    static constexpr uint32_t funct3_vle32          = 0b110;
+    static constexpr uint32_t funct3_vle64          = 0b111;
+
+    static constexpr uint32_t funct6_vadd           = 0b000000;
+    static constexpr uint32_t funct6_vsub           = 0b000010;
+    static constexpr uint32_t funct6_vand           = 0b001001;
+    static constexpr uint32_t funct6_vor            = 0b001010;
+    static constexpr uint32_t funct6_vxor           = 0b001011;
+    static constexpr uint32_t funct6_vmul           = 0b100101;
+    static constexpr uint32_t funct6_vredsum        = 0b000000;
+    static constexpr uint32_t funct6_vredand        = 0b000001;
+    static constexpr uint32_t funct6_vredor         = 0b000010;
+    static constexpr uint32_t funct6_vredxor        = 0b000011;
+    static constexpr uint32_t funct6_vredminu       = 0b000100;
+    static constexpr uint32_t funct6_vredmin        = 0b000101;
+    static constexpr uint32_t funct6_vredmaxu       = 0b000110;
+    static constexpr uint32_t funct6_vredmax        = 0b000111;
+
     static constexpr uint32_t insn_ecall            = 0x00000073;
     static constexpr uint32_t insn_ebreak           = 0x00100073;
 
@@ -68,19 +185,43 @@ protected:
     static constexpr uint32_t funct3_csrrsi         = 0b110;
     static constexpr uint32_t funct3_csrrci         = 0b111;
 
+    static constexpr uint32_t csr_fflags            = 0x001;
+    static constexpr uint32_t csr_frm               = 0x002;
+    static constexpr uint32_t csr_fcsr              = 0x003;
+    static constexpr uint32_t csr_mcycle            = 0xb00;
+    static constexpr uint32_t csr_minstret          = 0xb02;
+    static constexpr uint32_t csr_mcycleh           = 0xb80;
+    static constexpr uint32_t csr_minstreth         = 0xb82;
+    static constexpr uint32_t csr_cycle             = 0xc00;
+    static constexpr uint32_t csr_time              = 0xc01;
+    static constexpr uint32_t csr_instret           = 0xc02;
+    static constexpr uint32_t csr_vl                = 0xc20;
+    static constexpr uint32_t csr_vtype             = 0xc21;
+    static constexpr uint32_t csr_vlenb             = 0xc22;
+    static constexpr uint32_t csr_cycleh            = 0xc80;
+    static constexpr uint32_t csr_timeh             = 0xc81;
+    static constexpr uint32_t csr_instreth          = 0xc82;
+    static constexpr uint32_t csr_mhartid           = 0xf14;
+
     static uint32_t get_opcode(uint32_t);
     static uint32_t get_rd(uint32_t);
     static uint32_t get_funct3(uint32_t);
     static uint32_t get_rs1(uint32_t);
     static uint32_t get_rs2(uint32_t);
     static uint32_t get_funct7(uint32_t);
+    static uint32_t get_rs3(uint32_t);
+    static uint32_t get_fmt(uint32_t);
+    static uint32_t get_funct6(uint32_t);
+    static uint32_t get_vm(uint32_t);
+    static uint32_t get_veew(uint32_t);
+    static bool is_vector_mem(uint32_t);
     static int32_t get_imm_i(uint32_t);
     static int32_t get_imm_u(uint32_t);
     static int32_t get_imm_b(uint32_t);
     static int32_t get_imm_s(uint32_t);
     static int32_t get_imm_j(uint32_t);
 
-    static constexpr uint32_t XLEN = 32;
+    static constexpr uint32_t XLEN = RV_XLEN;
 
     static std::string render_illegal_insn(uint32_t);
     static std::string render_lui(uint32_t);
@@ -98,12 +239,27 @@ protected:
     static std::string render_stype(uint32_t, const char* );
     static std::string render_itype_alu(uint32_t, const char* , int32_t );
     static std::string render_rtype(uint32_t, const char* );
+    static std::string render_unary(uint32_t, const char* );
     static std::string render_ecall(uint32_t);
     static std::string render_ebreak(uint32_t);
     static std::string render_csrrx(uint32_t, const char*);
     static std::string render_csrrxi(uint32_t, const char*);
 
+    static std::string render_fp_load(uint32_t);
+    static std::string render_fp_store(uint32_t);
+    static std::string render_fp_r4type(uint32_t, const char* );
+    static std::string render_fp_rtype(uint32_t, const char*, char, char, char, bool);
+
+    static std::string render_vsetvl(uint32_t);
+    static std::string render_vmem(uint32_t, const char*);
+    static std::string render_vop(uint32_t, const char*);
+
     static std::string render_reg(int);
+    static std::string render_vreg(int);
+    static std::string render_vtype(uint32_t);
+    static std::string render_freg(int);
+    static std::string render_rm(uint32_t);
+    static std::string render_float(uint32_t);
     static std::string render_base_disp(uint32_t, int32_t);
     static std::string render_mnemonic(const std::string &);
 };
@@ -0,0 +1,535 @@
+#include <sstream>
+#include <iostream>
+#include <getopt.h>
+#include <thread>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <memory>
+#include <algorithm>
+#include "rv32i_driver.h"
+#include "memory.h"
+#include "rv32i_predecode.h"
+#include "rv32i_hart.h"
+#include "cpu_single_hart.h"
+#include "cpu_multi_hart.h"
+#include "syscalls.h"
+#include "mesi.h"
+#include "bbv.h"
+#include "memtrace.h"
+
+#ifdef RV_HEATMAP
+#define HEATMAP_OPTS "LW:"
+#else
+#define HEATMAP_OPTS ""
+#endif
+
+static const char options[] = "b:B:cCdirsNzf:j:l:m:M:n:p:q:H:R:T:w:" HEATMAP_OPTS;
+
+/**
+ * Usage function used to print useful information
+ *
+ * @param err where to print it
+ * @return void
+ *
+ * @note Shows how to use the program flags
+ ********************************************************************************/
+void rv32i_driver::usage(std::ostream &err) const
+{
+	err << "Usage : rv32i [-b bbv-file ] [-B interval ] [-c] [-C] [-d ] [ -i] [-r] [- z] [-j threads ] [-l exec - limit ] "
+        <<  "[-m hex - mem - size ] [-M mem-image ] [-R reg-image ] [-s] [-N] [-n name=addr ] [-H harts ] [-q quantum ] [-f fast-forward ] [-w window ] [-p period ] [-T trace-file ] infile" << std::endl;
+    err << "    -b write basic block vectors for hart 0 in SimPoint .bb format" << std::endl;
+    err << "    -B instructions per basic block vector (default 1000000)" << std::endl;
+	err << "    -c collapse repeated lines in the memory dump" << std::endl;
+    err << "    -C model MESI coherent L1 caches and report sharing after the run, up to 64 harts" << std::endl;
+	err << "    -d show disassembly before program execution" << std::endl;
+    err << "    -f run this many instructions with no tracing or models before the detail starts" << std::endl;
+    err << "    -H run this many harts over the same memory on one thread, each with a 0x1000 byte stack (default 1)" << std::endl;
+    err << "    -i show instruction printing during execution" << std::endl;
+    err << "    -j disassemble in bulk with this many threads (0 = one per core)" << std::endl;
+    err << "    -l maximum number of instructions to exec" << std::endl;
+    err << "    -m specify memory size (default = 0x100)" << std::endl;
+    err << "    -M write the final memory as a raw binary image" << std::endl;
+    err << "    -n run the guest memcpy/memset/memmove/strlen at hex addr natively (repeatable)" << std::endl;
+    err << "    -N run memcpy/memset/memmove/strlen natively on ecall 0x4000-0x4003" << std::endl;
+    err << "    -p with -w, start a detailed window every this many instructions" << std::endl;
+    err << "    -q instructions each hart runs before the next one's turn (default 100)" << std::endl;
+    err << "    -r show register printing during execution" << std::endl;
+    err << "    -R write the final registers and pc as a raw binary image" << std::endl;
+    err << "    -s emulate Linux system calls on ecall instead of halting" << std::endl;
+    err << "    -T write every fetch, load and store to a binary trace, read it with mtdump" << std::endl;
+    err << "    -w instructions in each detailed window, fast in between (needs -p)" << std::endl;
+    err << "    -z show a dump of the regs & memory after simulation" << std::endl;
+#ifdef RV_HEATMAP
+    err << "    -L count 64 byte lines in the heatmap as well as 4K pages" << std::endl;
+    err << "    -W instructions per working set sample (default 100000)" << std::endl;
+#endif
+}
+
+/**
+ * disaaemble function used to print instruction information
+ *
+ * @param mem the memory holding the program
+ * @param os where to print
+ * @return void
+ *
+ * @note loops through mem and calls decode to print the instructions
+ ********************************************************************************/
+static void disassemble(const memory &mem, std::ostream &os)
+{
+    uint32_t i = 0;
+    while(i != mem.get_size())          // loop to go over every bit
+    {
+        os << hex::to_hex32(i) << ": " << hex::to_hex32(mem.get32(i))
+        << "  " << rv32i_decode::decode(i,mem.get32(i)) << std::endl;
+        i += 4;                                                    // calls decode to decode an instruction
+
+    }
+
+
+}
+
+/**
+ * Renders the disassembly of the words in [first, last) into a buffer
+ *
+ * @param mem the memory holding the program
+ * @param first the address of the first word to render
+ * @param last the address one past the last word to render
+ * @param out the buffer the lines are appended to
+ * @return void
+ *
+ * @note produces the same lines as disassemble() without touching an ostream,
+ * reading the words through rv32i_predecode
+ ********************************************************************************/
+static void render_disassembly(const memory &mem, uint32_t first, uint32_t last, std::string &out)
+{
+    rv32i_predecode pd;
+    pd.predecode_region(mem, first, last - first);
+    const std::vector<uint32_t> &insns = pd.get_insns();
+
+    out.reserve(out.size() + (last - first) / 4 * 64);
+    for(size_t i = 0; i < insns.size(); ++i)
+    {
+        uint32_t addr = first + i*4;
+        uint32_t insn = insns[i];
+
+        hex::append_hex32(out, addr);
+        out += ": ";
+        hex::append_hex32(out, insn);
+        out += "  ";
+        out += rv32i_decode::decode(addr, insn);
+        out += '\n';
+    }
+}
+
+/**
+ * bulk disassemble function used to print instruction information for large images
+ *
+ * @param mem the memory holding the program
+ * @param threads number of render threads, 0 means one per core
+ * @param os where to print
+ * @return void
+ *
+ * @note splits memory into one chunk per thread, renders each chunk into its own
+ * buffer and then writes the buffers out in address order
+ ********************************************************************************/
+static void disassemble_bulk(const memory &mem, unsigned threads, std::ostream &os)
+{
+    if(threads == 0)
+        threads = std::thread::hardware_concurrency();
+    if(threads == 0)
+        threads = 1;
+
+    uint32_t words = mem.get_size() / 4;
+    uint32_t chunk = (words + threads - 1) / threads * 4;       // bytes per thread
+    if(chunk == 0)
+        return;
+
+    std::vector<std::string> bufs(threads);
+    std::vector<std::thread> workers;
+    for(unsigned t = 0; t < threads; ++t)
+    {
+        uint32_t first = t * chunk;
+        if(first >= words * 4)
+            break;
+        uint32_t last = std::min<uint64_t>((uint64_t)first + chunk, words * 4);
+        workers.emplace_back(render_disassembly, std::cref(mem), first, last, std::ref(bufs[t]));
+    }
+
+    for(size_t t = 0; t < workers.size(); ++t)      // write each chunk as soon as it is done
+    {
+        workers[t].join();
+        os.write(bufs[t].data(), bufs[t].size());
+        std::string().swap(bufs[t]);
+    }
+    os.flush();
+}
+
+/**
+ * Reads the command line
+ * @return bool false if it is wrong, the usage message has been printed
+ *
+* @param argc an int for the argument count
+* @param argv a char for the argument values
+* @param err where getopt's complaint and the usage message go
+ *
+ * @note getopt is started over each time, so a driver can be parsed after
+ * another one. Its own messages are turned off and written to err in the
+ * same words instead
+ ********************************************************************************/
+bool rv32i_driver::parse(int argc, char **argv, std::ostream &err)
+{
+    if(argc > 0)
+        prog = argv[0];
+    optind = 0;                         // 0 makes glibc forget a half read word
+    opterr = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, options)) != -1)
+    {
+        switch (opt)
+        {
+            case 'c':
+            {
+               collapse_dump = true;
+            }
+            break;
+            case 'b':
+            {
+               bbv_file = optarg;
+            }
+            break;
+            case 'B':
+            {
+               std::istringstream iss(optarg);
+               iss >> std::dec >> bbv_interval;
+               if(bbv_interval == 0)
+               {
+                  usage(err);
+                  return false;
+               }
+            }
+            break;
+            case 'T':
+            {
+               trace_file = optarg;
+            }
+            break;
+            case 'C':
+            {
+               coherence = true;
+            }
+            break;
+            case 'd':
+            {
+               show_disassembly = true;
+            }
+            break;
+            case 'i':
+            {
+                show_instructions = true;
+            }
+            break;
+            case 'r':
+            {
+              show_registers = true;
+            }
+            break;
+            case 's':
+            {
+               emulate_syscalls = true;
+            }
+            break;
+            case 'N':
+            {
+               native_ecalls = true;
+            }
+            break;
+            case 'n':
+            {
+               std::string arg(optarg);
+               size_t eq = arg.find('=');
+               if(eq == std::string::npos)
+               {
+                  usage(err);
+                  return false;
+               }
+               uint64_t addr = 0;
+               std::istringstream iss(arg.substr(eq + 1));
+               iss >> std::hex >> addr;
+               native_hooks.emplace_back(arg.substr(0, eq), addr);
+            }
+            break;
+            case 'z':
+            {
+               show_post_dump = true;
+            }
+            break;
+            case 'j':
+            {
+               std::istringstream iss(optarg);
+               iss >> std::dec >> disassembly_threads;
+               bulk_disassembly = true;
+            }
+            break;
+            case 'l':
+            {
+               std::istringstream iss(optarg);
+            	iss >> std::dec >> exec_limit;
+            }
+            break;
+            case 'm':
+        	{
+        		std::istringstream iss(optarg);
+            	iss >> std::hex >> memory_limit;
+			}
+            break;
+            case 'M':
+            {
+               mem_image = optarg;
+            }
+            break;
+            case 'f':
+            {
+               std::istringstream iss(optarg);
+               iss >> std::dec >> fast_forward;
+            }
+            break;
+            case 'w':
+            {
+               std::istringstream iss(optarg);
+               iss >> std::dec >> sample_window;
+            }
+            break;
+            case 'p':
+            {
+               std::istringstream iss(optarg);
+               iss >> std::dec >> sample_period;
+            }
+            break;
+#ifdef RV_HEATMAP
+            case 'L':
+            {
+               heat_lines = true;
+            }
+            break;
+            case 'W':
+            {
+               std::istringstream iss(optarg);
+               iss >> std::dec >> heat_window;
+               if(heat_window == 0)
+               {
+                  usage(err);
+                  return false;
+               }
+            }
+            break;
+#endif
+            case 'H':
+            {
+               std::istringstream iss(optarg);
+               iss >> std::dec >> harts;
+               if(harts == 0)
+               {
+                  usage(err);
+                  return false;
+               }
+            }
+            break;
+            case 'q':
+            {
+               std::istringstream iss(optarg);
+               iss >> std::dec >> quantum;
+            }
+            break;
+            case 'R':
+            {
+               reg_image = optarg;
+            }
+            break;
+            default: /* ’?’ */
+            if(optopt && optopt != ':' && std::strchr(options, optopt))
+                err << prog << ": option requires an argument -- '" << (char)optopt << "'" << std::endl;
+            else
+                err << prog << ": invalid option -- '" << (char)optopt << "'" << std::endl;
+			usage(err);
+            return false;
+		}
+	}
+    if (optind >= argc)
+    {
+    	usage(err);    // missing filename
+        return false;
+    }
+    if ((sample_window != 0) != (sample_period != 0) || sample_window > sample_period)
+    {
+        usage(err);    // a window needs a longer period
+        return false;
+    }
+    if (harts > 1 && (uint64_t)harts * cpu_multi_hart::default_stack_size > memory_limit)
+    {
+        err << prog << ": " << harts << " harts need " << hex::to_hex0x64((uint64_t)harts * cpu_multi_hart::default_stack_size)
+            << " bytes of memory for their stacks" << std::endl;
+        usage(err);
+        return false;
+    }
+    if (coherence && harts > mesi_model::max_harts)
+    {
+        err << prog << ": -C models at most " << mesi_model::max_harts << " harts" << std::endl;
+        usage(err);
+        return false;
+    }
+    infile = argv[optind];
+    return true;
+}
+
+/**
+ * Loads the program, runs it and prints what the options asked for
+ * @return int the guest exit status when it called exit, 1 if the program
+ * can't be loaded or an output file can't be written, otherwise 0
+ *
+* @param os where the disassembly, trace, dumps and reports go
+* @param err where the usage message and errors go
+ ********************************************************************************/
+int rv32i_driver::run(std::ostream &os, std::ostream &err) const
+{
+    memory mem(memory_limit);
+    mem.set_output(os);
+
+    if (!mem.load_file(infile))
+    {
+        usage(err);
+        return 1;
+    }
+
+    if(show_disassembly)
+    {
+        if(bulk_disassembly)
+            disassemble_bulk(mem, disassembly_threads, os);
+        else
+            disassemble(mem, os);
+    }
+
+#ifdef RV_HEATMAP
+    mem.set_heatmap(heat_lines, heat_window);
+#endif
+
+    syscalls sys(mem, (mem.get_load_size() + 7) & ~7u);
+    sys.set_output(os);
+    std::unique_ptr<mesi_model> caches;
+    bbv_collector bbv(bbv_interval);
+    mem_observer_list observers;
+    if(coherence)
+    {
+        caches.reset(new mesi_model(harts));
+        observers.add(caches.get());
+    }
+    if(!bbv_file.empty())
+    {
+        if(!bbv.open(bbv_file))
+        {
+            err << "Can't open file " << bbv_file << " for writing." << std::endl;
+            return 1;
+        }
+        observers.add(&bbv);
+    }
+    memtrace_writer trace;
+    if(!trace_file.empty())
+    {
+        if(!trace.open(trace_file))
+        {
+            err << "Can't open file " << trace_file << " for writing." << std::endl;
+            return 1;
+        }
+        observers.add(&trace);
+    }
+
+    if(harts > 1)
+    {
+        cpu_multi_hart cpus(mem, harts);
+        cpus.reset();
+        cpus.set_output(os);
+        cpus.set_quantum(quantum);
+        if(emulate_syscalls)
+            cpus.set_syscalls(&sys);
+        cpus.set_native_ecalls(native_ecalls);
+        if(!observers.empty())
+            cpus.set_observer(&observers);
+        for(const auto &h : native_hooks)
+            for(unsigned i = 0; i < harts; ++i)
+                if(!cpus.get_hart(i).add_native_hook(h.first, h.second))
+                {
+                    err << "Unknown native routine " << h.first << std::endl;
+                    usage(err);
+                    return 1;
+                }
+        cpus.set_show_instructions(show_instructions);
+        cpus.set_show_registers(show_registers);
+        cpus.set_sampling(fast_forward, sample_window, sample_period);
+
+        cpus.run(exec_limit);
+        if(caches)
+            caches->report(os);
+        bbv.finish();
+        trace.finish();
+#ifdef RV_HEATMAP
+        mem.heat_report(os);
+#endif
+
+        if(show_post_dump)
+        {
+            cpus.dump();
+            mem.dump(collapse_dump);
+        }
+
+        if(!mem_image.empty() && !mem.save_file(mem_image))
+            return 1;
+        if(!reg_image.empty() && !cpus.get_hart(0).save_registers(reg_image))
+            return 1;
+        return sys.has_exited() ? sys.get_exit_code() : 0;
+    }
+
+    cpu_single_hart cpu(mem);
+    cpu.reset();
+    cpu.set_output(os);
+
+    if(emulate_syscalls)
+        cpu.set_syscalls(&sys);
+
+    cpu.set_native_ecalls(native_ecalls);
+    if(!observers.empty())
+        cpu.set_observer(&observers);
+    for(const auto &h : native_hooks)
+        if(!cpu.add_native_hook(h.first, h.second))
+        {
+            err << "Unknown native routine " << h.first << std::endl;
+            usage(err);
+            return 1;
+        }
+
+    cpu.set_show_instructions(show_instructions);
+    cpu.set_show_registers(show_registers);
+    cpu.set_sampling(fast_forward, sample_window, sample_period);
+
+    cpu.run(exec_limit);
+    if(caches)
+        caches->report(os);
+    bbv.finish();
+    trace.finish();
+#ifdef RV_HEATMAP
+    mem.heat_report(os);
+#endif
+
+    if(show_post_dump)
+    {
+        cpu.dump();
+        mem.dump(collapse_dump);
+    }
+
+    if(!mem_image.empty() && !mem.save_file(mem_image))
+        return 1;
+    if(!reg_image.empty() && !cpu.save_registers(reg_image))
+        return 1;
+
+return sys.has_exited() ? sys.get_exit_code() : 0;
+
+}
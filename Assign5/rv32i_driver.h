@@ -0,0 +1,56 @@
+#ifndef RV32I_DRIVER_H
+#define RV32I_DRIVER_H
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include "cpu_multi_hart.h"
+
+// The rv32i command line: the options, the disassembly and the run.  main()
+// is parse() and run() on std::cout and std::cerr; rvtest runs its golden
+// cases through the same two calls with a stream that compares the output.
+//
+// parse() uses getopt, which keeps its state in globals, so two threads must
+// not parse at the same time.  run() only reads the options.
+class rv32i_driver
+{
+    public:
+        bool parse(int argc, char **argv, std::ostream &err);
+        int run(std::ostream &os, std::ostream &err) const;
+
+    private:
+        void usage(std::ostream &err) const;
+
+        std::string prog = { "rv32i" };     ///< argv[0], for the getopt messages
+        std::string infile;
+        uint32_t memory_limit = { 0x100 };
+        uint64_t exec_limit = { 0 };
+        bool show_disassembly = { false };
+        bool show_instructions = { false };
+        bool show_registers = { false };
+        bool show_post_dump = { false };
+        bool collapse_dump = { false };
+        bool bulk_disassembly = { false };
+        bool emulate_syscalls = { false };
+        bool native_ecalls = { false };
+        bool coherence = { false };
+        std::string bbv_file;
+        uint64_t bbv_interval = { 1000000 };
+        std::string trace_file;
+        uint64_t fast_forward = { 0 };
+        uint64_t sample_window = { 0 };
+        uint64_t sample_period = { 0 };
+#ifdef RV_HEATMAP
+        bool heat_lines = { false };
+        uint64_t heat_window = { 0 };
+#endif
+        std::vector<std::pair<std::string, uint64_t>> native_hooks;
+        unsigned disassembly_threads = { 0 };
+        unsigned harts = { 1 };
+        uint64_t quantum = { cpu_multi_hart::default_quantum };
+        std::string mem_image;
+        std::string reg_image;
+};
+
+#endif
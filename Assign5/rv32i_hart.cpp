@@ -1,1611 +1,3093 @@
-#include "rv32i_hart.h"
-
-/**
-* adds if illgeal instruction occured 
-*
- * @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note sets the halt tag and adds why the reason for the halt
- ********************************************************************************/
-void rv32i_hart::exec_illegal_insn ( uint32_t insn, std::ostream* pos)
-{
-   if ( pos )
-       *pos << render_illegal_insn (insn);
-
-   halt = true ;
-   halt_reason = " Illegal instruction ";
-
-}
-
-/**
- * Program ticker to exec an instruction
- * @return void
- *
-* @param hdr is a header string   
- *
- * @note simulates the execution of instructions and adds to the instruction counter
- ********************************************************************************/
-void rv32i_hart::tick(const std::string & hdr)
-{
-    if(halt)
-    return;
-
-    ++insn_counter;
-
-    if(show_registers)
-        dump(hdr);
-
-    if(pc & 0x03)
-    {
-        halt = true;
-        halt_reason = "PC alignment error";
-        return;
-    }
-
-    uint32_t insn = mem.get32(pc);
-    if(show_instructions)
-    {
-        std::cout << hdr << hex::to_hex32(pc) << ": " << hex::to_hex32(insn) << " ";
-        exec(insn, &std::cout);
-        std::cout << std::endl;
-    }
-    else 
-        exec(insn,nullptr);
-
-}
-
-/**
- * calls the register dump
- * @return void
- *
-* @param hdr is a header string  
- *
- * @note calls register files dump to print out the registers and then the pc
- ********************************************************************************/
-void rv32i_hart::dump( const std::string & hdr) const
-{
-   
-    regs.dump(hdr);
-
-    std::cout << "pc " << hex::to_hex32(pc) << std::endl;
-}
-
-/**
- * Resets all the GP varibles  
- * @return void
- *
- *
- * @note Makes all the global varibles reset to be able to be used again
- ********************************************************************************/
-void rv32i_hart::reset()
-{
-    pc = 0;
-    insn_counter = 0;
-    halt = false;
-    halt_reason = "none";
-
-}
-
-/**
- * Main exec to find methods
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note Goes through a switch to find what function is need for the instruction 
- * to be able to execute it 
- ********************************************************************************/
-void rv32i_hart::exec(uint32_t insn, std::ostream* pos)
-{
-     uint32_t funct3 = get_funct3(insn);
-    uint32_t funct7 = get_funct7(insn);
-    
-// switch goes those all possible opcodes and then has sub switchs to break down by the funct3 and then used
-// funct7 as needed to break down more
-switch(get_opcode(insn))
-{
-    default:  exec_illegal_insn(insn,pos); return;
-    case opcode_lui:  exec_lui(insn,pos); return;
-    case opcode_auipc:  exec_auipc(insn,pos); return;
-    case opcode_jal:  exec_jal(insn,pos); return;
-    case opcode_jalr:  exec_jalr(insn,pos); return;
-
-
-    case opcode_btype:
-        switch (funct3)
-        {
-            default:  exec_illegal_insn(insn,pos);return;
-            case funct3_beq:  exec_beq(insn, pos); return;
-            case funct3_bne:  exec_bne(insn, pos); return;
-            case funct3_blt:  exec_blt(insn, pos); return;
-            case funct3_bge:  exec_bge(insn, pos); return;
-            case funct3_bltu:  exec_bltu(insn, pos); return;
-            case funct3_bgeu:  exec_bgeu(insn, pos); return;
-        }
-
-        assert(0 && "unrecognized funct3");  //impossible
-
-    case opcode_load_imm:
-        switch(funct3)
-        {
-            default:  exec_illegal_insn(insn,pos);return;
-            case funct3_lb:  exec_lb( insn,pos); return;
-            case funct3_lh:  exec_lh( insn, pos); return;
-            case funct3_lw:  exec_lw( insn, pos); return;
-            case funct3_lbu:  exec_lbu( insn, pos); return;
-            case funct3_lhu:  exec_lhu( insn, pos); return;
-
-        }
-     assert(0 && "unrecognized funct3");  //impossible
-
-      case opcode_stype:
-        switch(funct3)
-        {
-            default:  exec_illegal_insn(insn,pos);return;
-           case funct3_sb:  exec_sb( insn,pos); return;
-           case funct3_sh:  exec_sh( insn, pos); return;
-           case funct3_sw:  exec_sw( insn, pos); return;
-
-        }
-    assert(0 && "unrecognized funct3");  //impossible
-
-    case opcode_alu_imm:
-        switch (funct3)
-        {
-            default:  exec_illegal_insn(insn,pos);return;
-            case funct3_add:  exec_addi(insn, pos, get_imm_i(insn)); return;
-            case funct3_sll:  exec_slli(insn, pos, get_imm_i(insn)%XLEN); return;
-            case funct3_slt:  exec_slti(insn, pos, get_imm_i(insn)); return;
-            case funct3_sltu:  exec_sltiu(insn, pos, get_imm_i(insn)); return;
-            case funct3_xor:  exec_xori(insn, pos, get_imm_i(insn)); return;
-        
-            case funct3_or:  exec_ori(insn, pos, get_imm_i(insn)); return;
-            case funct3_and:  exec_andi(insn, pos, get_imm_i(insn)); return;
-
-            case funct3_srx:
-                switch(funct7)
-                {
-                    default:  exec_illegal_insn(insn,pos);return;
-                    case funct7_sra:  exec_srai(insn, pos, get_imm_i(insn)%XLEN); return;
-                    case funct7_srl:  exec_srli(insn, pos, get_imm_i(insn)%XLEN); return;
-                }
-
-            assert(0 && "unrecognized funct7");  //impossible
-        }
-
-        assert(0 && "unrecognized funct3");  //impossible
-
-        case opcode_rtype:
-            switch(funct3)
-            {
-                default:  exec_illegal_insn(insn,pos);return;
-                case funct3_add: 
-                    switch(funct7)
-                    {
-                        default:  exec_illegal_insn(insn,pos);return;
-                        case funct7_add:  exec_add(insn,pos); return;
-                        case funct7_sub:  exec_sub(insn,pos); return;
-                    }
-                case funct3_sll:  exec_sll(insn,pos); return;
-                case funct3_slt:   exec_slt(insn,pos); return;
-                case funct3_sltu:  exec_sltu(insn,pos); return;
-                case funct3_xor:   exec_xor(insn,pos); return;
-                case funct3_or:   exec_or(insn,pos); return;
-                case funct3_and:  exec_and(insn,pos); return;
-                case funct3_srx:
-                switch(funct7)
-                {
-                    default: return exec_illegal_insn(insn,pos);return;
-                    case funct7_sra:   exec_sra(insn,pos); return;
-                    case funct7_srl:   exec_srl(insn,pos); return;
-                }
-               
-
-                assert(0 && "unrecognized funct7");  //impossible
-            }
-            assert(0 && "unrecognized funct7");  //impossible
-
-        case opcode_system:
-            switch(funct3)
-           {
-                case 0b000:
-                    switch(get_imm_i(insn))
-                    {
-                        case 0: exec_ecall(insn,pos); return;
-                        case 1: exec_ebreak(insn,pos); return;
-                    }
-               
-                case funct3_csrrw:  exec_csrrw(insn, pos); return;
-                case funct3_csrrs:  exec_csrrs(insn, pos); return;
-                case funct3_csrrc:  exec_csrrc (insn, pos); return;
-                case funct3_csrrwi:  exec_csrrwi(insn, pos); return;
-                case funct3_csrrsi:  exec_csrrsi(insn, pos); return;
-                case funct3_csrrci:  exec_csrrci(insn, pos); return;
-                assert(0 && "unrecognized funct3");  //impossible
-            }
-
-assert(0 && "unrecognized get_opcode(insn)"); // It should be //impossible to ever get here!
-
-}
-
-}
-
-/**
- * prints a exec lui  
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a lui instruction and adds 4 to PC and sets the
- * value in the register
- ********************************************************************************/
-void rv32i_hart::exec_lui(uint32_t insn,std::ostream* pos)
-{
-    uint32_t rd = get_rd(insn);
-    int32_t imm_u = get_imm_u(insn);
-
-   if ( pos )
-  {
-     std::string s = render_lui(insn);
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = " << hex::to_hex32(imm_u);
-
-  }
-  regs.set(rd, imm_u);
-  pc += 4;
-    
-}
-
-/**
- * prints a exec auipc  
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a auipc instruction and adds 4 to PC and sets the
- * value in the register
- ********************************************************************************/
-void rv32i_hart::exec_auipc(uint32_t insn,std::ostream* pos)
-{
-    uint32_t rd = get_rd(insn);
-    int32_t imm_u = get_imm_u(insn);
-
-    // simulates the instruction
-    int32_t val = pc + imm_u;
-    
-                
-    if ( pos )
-  {
-    std::string s = render_auipc(insn);
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = " << hex::to_hex32(pc) << " + " << hex::to_hex32(imm_u) << 
-    " = " << hex::to_hex32(val);
-
-  }
-  // sets the register rd to the value
-    regs.set(rd,val);
-  pc += 4;
- 
-}
-
-
-/**
- * exec a jal instruction 
- ** @return void
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a jal instruction and adds 4 to PC and sets the
- * value in the register
- ********************************************************************************/
-///@parm pc The memory pcess where the insn is stored.
-void rv32i_hart::exec_jal(uint32_t insn,std::ostream* pos)
-{
-    
-    uint32_t rd = get_rd(insn);
-    int32_t imm_j = get_imm_j(insn);
-
-    // simulates the instruction
-    int32_t val = pc + 4;
- 
-                 
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-       std::string s = render_jal(rd,insn);
-   *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = " << hex::to_hex32(pc) << ", + " << hex::to_hex32(imm_j) << 
-    " pc = " << hex::to_hex32(val) << " + " << hex::to_hex32(pc) << " = " << hex::to_hex32(val);
-    }
-
-    // sets the register rd to the value
-    regs.set(rd,val);
-     pc += imm_j;
-    
-}
-
-/**
- * exec a jalr instruction 
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a jalr instruction and adds (regs.get(rs1)+imm_i) & ~1 to PC and sets the
- * value in the register
- ********************************************************************************/
-void rv32i_hart::exec_jalr(uint32_t insn,std::ostream* pos)
-{
-    uint32_t rd = get_rd(insn);
-    int32_t imm_i = get_imm_i(insn);
-    uint32_t rs1 = get_rs1(insn);
-
-   // simulates the instruction
-    int32_t val = pc + 4;
-
-                
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-   std::string s = render_jalr(insn);
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = " << hex::to_hex32(pc) << ", + " << hex::to_hex32(imm_i) << 
-    " pc = (" << hex::to_hex32(val) << " + " << hex::to_hex32(pc) << ") & 0xfffffffe = " << hex::to_hex32(val);
-
-    }
-    // sets the register rd to the value
-    regs.set(rd,val);
-    pc = (regs.get(rs1)+imm_i) & ~1;
-   
-}
-
-
-/**
- * exec a beq instruction 
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a beq instruction and adds(regs.get(rs1) == regs.get(rs2)) ? imm_b : 4);to PC
- ********************************************************************************/
-void rv32i_hart::exec_beq(uint32_t insn, std::ostream* pos)
-{
-    int32_t imm_b = get_imm_b(insn);
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-    uint32_t rs2 = get_rs2(insn); 
-
-                
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_btype(rd,insn,"beq");
-     *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// pc += " << " pc += (" << hex::to_hex32(rs1) << " == " << hex::to_hex32(rs2) << 
-    " ? " << hex::to_hex32(imm_b) << " : 4 " << " = "  
-    << hex::to_hex32(pc );
-
-    }
-
-    pc += (int32_t)((regs.get(rs1) == regs.get(rs2)) ? imm_b : 4);
-
-  
-}
-
-/**
- * exec a bge instruction 
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a bge instruction and adds(regs.get(rs1) >= regs.get(rs2)) ? imm_b : 4);to PC
- ********************************************************************************/
-void rv32i_hart::exec_bge(uint32_t insn, std::ostream* pos)
-{    
-    int32_t imm_b = get_imm_b(insn);
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-    uint32_t rs2 = get_rs2(insn);  
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-   std::string s = render_btype(rd,insn,"bge");
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// pc += " << " pc += (" << hex::to_hex32(rs1) << " >= " << hex::to_hex32(rs2) << 
-    " ? " << hex::to_hex32(imm_b) << " : 4 " << " = "  
-    << hex::to_hex32(pc );
-
-    }
-
-    pc += (int32_t)((regs.get(rs1) >= regs.get(rs2)) ? imm_b : 4);
-
-}
-
-/**
- * exec a bgeu instruction 
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a bgeu instruction and adds(regs.get(rs1) >= regs.get(rs2)) ? imm_b : 4);to PC for
- * an unsigned 
- ********************************************************************************/
-void rv32i_hart::exec_bgeu(uint32_t insn, std::ostream* pos)
-{
-    int32_t imm_b = get_imm_b(insn);
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-    uint32_t rs2 = get_rs2(insn);  
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-   std::string s = render_btype(rd,insn,"bgeu");
-     *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// pc += " << " pc += (" << hex::to_hex32(rs1) << " >=U " << hex::to_hex32(rs2) << 
-    " ? " << hex::to_hex32(imm_b) << " : 4 " << " = "  
-    << hex::to_hex32(pc );
-
-    }
-
-     pc += (uint32_t)((regs.get(rs1) >= regs.get(rs2)) ? imm_b : 4);
-
-}
-
-/**
- * exec a blt instruction 
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a blt instruction and adds(regs.get(rs1) < regs.get(rs2)) ? imm_b : 4);to PC
- ********************************************************************************/
-void rv32i_hart::exec_blt(uint32_t insn, std::ostream* pos)
-{
-    int32_t imm_b = get_imm_b(insn);
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-    uint32_t rs2 = get_rs2(insn);  
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-   std::string s = render_btype(rd,insn,"blt");
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// pc += " << " pc += (" << hex::to_hex32(rs1) << " < " << hex::to_hex32(rs2) << 
-    " ? " << hex::to_hex32(imm_b) << " : 4 " << " = "  
-    << hex::to_hex32(pc );
-
-    }
-
-     pc += (int32_t)((regs.get(rs1) < regs.get(rs2)) ? imm_b : 4);
-
-}
-
-/**
- * exec a bltu instruction 
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a beq instruction and adds(regs.get(rs1) < regs.get(rs2)) ? imm_b : 4);to PC for 
- * unsigned
- ********************************************************************************/
-void rv32i_hart::exec_bltu(uint32_t insn, std::ostream* pos)
-{
-    int32_t imm_b = get_imm_b(insn);
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-    uint32_t rs2 = get_rs2(insn); 
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-   std::string s = render_btype(rd,insn,"bltu");
-     *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// pc += " << " pc += (" << hex::to_hex32(rs1) << " <U " << hex::to_hex32(rs2) << 
-    " ? " << hex::to_hex32(imm_b) << " : 4 " << " = "  
-    << hex::to_hex32(pc );
-
-    }
-
-    pc += (uint32_t)(regs.get(rs1) < regs.get(rs2)) ? imm_b : 4;
-
-}
-
-/**
- * exec a bne instruction 
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a bne instruction and adds(regs.get(rs1) != regs.get(rs2)) ? imm_b : 4);to PC
- ********************************************************************************/
-void rv32i_hart::exec_bne(uint32_t insn, std::ostream* pos)
-{
-    int32_t imm_b = get_imm_b(insn);
-    uint32_t rd = get_rd(insn);
-    int32_t rs1 = get_rs1(insn);
-    int32_t rs2 = get_rs2(insn);  
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-        std::string s = render_btype(rd,insn,"bne");
-     *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// pc += " << " pc += (" << hex::to_hex32(rs1) << " != " << hex::to_hex32(rs2) << 
-    " ? " << hex::to_hex32(imm_b) << " : 4 " << " = "  
-    << hex::to_hex32(pc);
-
-    }
-
-     pc += (int32_t)((regs.get(rs1) != regs.get(rs2)) ? imm_b : 4);
-
-}
-
-
-
-/**
- * exec a load instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a lb instruction and adds 4 to PC
- ********************************************************************************/
-void rv32i_hart::exec_lb(uint32_t insn, std::ostream* pos)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-    uint32_t imm_i = get_imm_i(insn);
-
-    mem.set8(regs.get(rs1),imm_i);
-    // simulates the instruction
-    int32_t val = (mem.get8_sx(regs.get(rs1)+imm_i));
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-   std::string s = render_itype_load(insn,"lb");
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = sx(m8(" << hex::to_hex32(rs1) << " + " << hex::to_hex32(imm_i)
-    << ")) = " << hex::to_hex32(val);
-
-    }
-    regs.set(rd, val);
-    pc+=4;
-    
-}
-
-/**
- * exec a load instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a lh instruction and adds 4 to PC
- ********************************************************************************/
-void rv32i_hart::exec_lh(uint32_t insn, std::ostream* pos)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-    uint32_t imm_i = get_imm_i(insn);
-    
-    mem.set16(regs.get(rs1),imm_i);
-    // simulates the instruction
-    int32_t val = (mem.get16_sx(regs.get(rs1)+imm_i));
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_itype_load(insn,"lh");
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = sx(m16(" << hex::to_hex32(rs1) << " + " << hex::to_hex32(imm_i)
-    << ")) = " << hex::to_hex32(val);
-
-    }
-    regs.set(rd, val);
-    pc+=4;
-        
-}
-
-/**
- * exec a load instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a lw instruction and adds 4 to PC
- ********************************************************************************/
-void rv32i_hart::exec_lw(uint32_t insn, std::ostream* pos)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-    uint32_t imm_i = get_imm_i(insn);
-    
-    mem.set32(regs.get(rs1),imm_i);
-    // simulates the instruction
-    int32_t val = (mem.get32(regs.get(rs1)+imm_i));
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_itype_load(insn,"lw");
-   *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = sx(m32(" << hex::to_hex32(rs1) << " + " << hex::to_hex32(imm_i)
-    << ")) = " << hex::to_hex32(val);
-
-    }
-    regs.set(rd, val);
-    pc+=4;
-}
-
-/**
- * exec a load instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a lbu instruction and adds 4 to PC
- ********************************************************************************/
-void rv32i_hart::exec_lbu(uint32_t insn, std::ostream* pos)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-    uint32_t imm_i = get_imm_i(insn);
-
-    mem.set8(regs.get(rs1),imm_i);
-    // simulates the instruction
-    int32_t val = (mem.get8_sx(regs.get(rs1)+imm_i));
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_itype_load(insn,"lbu");
-   *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = zx(m8(" << hex::to_hex32(rs1) << " + " << hex::to_hex32(imm_i)
-    << ")) = " << hex::to_hex32(val);
-
-    }
-    regs.set(rd, val);
-    pc+=4;
-}
-
-/**
- * exec a load instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a lhu instruction and adds 4 to PC
- ********************************************************************************/
-void rv32i_hart::exec_lhu(uint32_t insn, std::ostream* pos)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-    uint32_t imm_i = get_imm_i(insn);
-
-    mem.set16(regs.get(rs1),imm_i);
-    // simulates the instruction
-    int32_t val = (mem.get16_sx(regs.get(rs1)+imm_i));
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_itype_load(insn,"lhu");
-   *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = zx(m16(" << hex::to_hex32(rs1) << " + " << hex::to_hex32(imm_i)
-    << ")) = " << hex::to_hex32(val);
-
-    }
-    regs.set(rd, val);
-    pc+=4;
-
-}
- 
-
-/**
- * exec a s type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a sb instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_sb(uint32_t insn, std::ostream* pos)
-{
-    uint32_t rs1 = get_rs1(insn);
-    uint32_t imm_s = get_imm_s(insn);
-    uint32_t rd = get_rd(insn);
-
-    mem.set8(regs.get(rs1),imm_s);
-   int32_t rs2 = (regs.get(rs1)+imm_s);
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_stype(insn, "sb ");
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// m8(" << hex::to_hex32(rs1) << " + " << hex::to_hex32(imm_s)
-    << ") = " << hex::to_hex32(rs2);
-
-    }
-    regs.set(rd, rs2);
-    pc+=4;
-
-
-}
-/**
- * exec a s type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a sh instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_sh(uint32_t insn, std::ostream* pos)
-{
-    uint32_t rs1 = get_rs1(insn);
-    uint32_t imm_s = get_imm_s(insn);
-    uint32_t rd = get_rd(insn);
-
-    mem.set16(regs.get(rs1),imm_s);
-   int32_t rs2 = (regs.get(rs1)+imm_s);
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_stype(insn, "sh ");
-   *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// m16(" << hex::to_hex32(rs1) << " + " << hex::to_hex32(imm_s)
-    << ") = " << hex::to_hex32(rs2);
-
-    }
-    regs.set(rd, rs2);
-    pc+=4;
-
-}
-
-/**
- * exec a s type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a sw instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_sw(uint32_t insn, std::ostream* pos)
-{
-   uint32_t rs1 = get_rs1(insn);
-    uint32_t imm_s = get_imm_s(insn);
-    uint32_t rd = get_rd(insn);
-
-    mem.set32(regs.get(rs1),imm_s);
-   int32_t rs2 = (regs.get(rs1)+imm_s);
-
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_stype(insn, "sw ");
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// m32(" << hex::to_hex32(rs1) << " + " << hex::to_hex32(imm_s)
-    << ") = " << hex::to_hex32(rs2);
-
-    }
-    regs.set(rd, rs2);
-    pc+=4;
-
-
-}
-
-/**
- * exec a i type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a addi instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_addi(uint32_t insn, std::ostream* pos, int32_t imm_i)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-
-    // simulates the instruction
-    int32_t val = (regs.get(rs1) + imm_i);
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_rtype(insn, "slt ");
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = " << hex::to_hex0x32 (regs.get (rs1) ) << " + "
-    << hex::to_hex0x32 (imm_i) << " = " << hex::to_hex0x32 (val);
-
-    }
-    // sets the register rd to the value
-    regs.set(rd,val);
-    pc+=4;
-}
-
-/**
- * exec a i type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a slti instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_slti(uint32_t insn, std::ostream* pos, int32_t imm_i)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-
-    // simulates the instruction
-    int32_t val =  ((regs.get(rs1) < imm_i) ? 1 : 0);       // ifregs.get(rs1) is less than rs2 print 1 or 0
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-   std::string s = render_rtype(insn, "slt ");
-      *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = (" << hex::to_hex0x32 (regs.get (rs1) ) << " < " << 
-    hex::to_hex32(imm_i) << ") ? 1 : 0 = " << hex::to_hex0x32 (val);
-
-    }
-    // sets the register rd to the value
-    regs.set(rd,val);
-    pc+=4;
-}
-
-/**
- * exec a i type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a sltiu instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_sltiu(uint32_t insn, std::ostream* pos, int32_t imm_i)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-
-    // simulates the instruction
-    int32_t val =  ((regs.get(rs1) < imm_i) ? 1 : 0);       // ifregs.get(rs1) is less than rs2 print 1 or 0
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_rtype(insn, "slt ");
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = (" << hex::to_hex0x32 (regs.get (rs1) ) << " <U " << 
-    hex::to_hex32(imm_i) << ") ? 1 : 0 = " << hex::to_hex0x32 (val);
-
-    }
-    // sets the register rd to the value
-    regs.set(rd,val);
-    pc+=4;
-}
-
-/**
- * exec a i type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a xori instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_xori(uint32_t insn, std::ostream* pos, int32_t imm_i)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-
-    // simulates the instruction
-    int32_t val =  (regs.get(rs1) ^ imm_i );            //xor
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_rtype(insn, "slt ");
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = " << hex::to_hex0x32 (regs.get (rs1) ) << " ^ " << 
-    hex::to_hex32(imm_i) << " = " << hex::to_hex0x32 (val);
-
-    }
-    // sets the register rd to the value
-    regs.set(rd,val);
-    pc+=4;
-}
-
-/**
- * exec a i type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a ori instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_ori(uint32_t insn, std::ostream* pos, int32_t imm_i)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-
-    // simulates the instruction
-    int32_t val =  (regs.get(rs1) | imm_i);         // reg =regs.get(rs1) or imm_i
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-   std::string s = render_rtype(insn, "slt ");
-   *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = " << hex::to_hex0x32 (regs.get (rs1) ) << " | " << 
-    hex::to_hex32(imm_i) << " = " << hex::to_hex0x32 (val);
-
-    }
-    // sets the register rd to the value
-    regs.set(rd,val);
-    pc+=4;
-}
-
-/**
- * exec a i type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a andi instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_andi(uint32_t insn, std::ostream* pos, int32_t imm_i)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-
-    // simulates the instruction
-    int32_t val =  (regs.get(rs1) & imm_i);         // reg =regs.get(rs1) & imm_i
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_rtype(insn, "slt ");
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = " << hex::to_hex0x32 (regs.get (rs1) ) << " & " << 
-    hex::to_hex32(imm_i) << " = " << hex::to_hex0x32 (val);
-
-    }
-    // sets the register rd to the value
-    regs.set(rd,val);
-    pc+=4;
-}
-
-/**
- * exec a i type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a slli instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_slli(uint32_t insn, std::ostream* pos, int32_t imm_i)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-
-    // simulates the instruction
-    int32_t val =  (regs.get(rs1) << imm_i);        // shif
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_rtype(insn, "slt ");
-   *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = " << hex::to_hex0x32 (regs.get (rs1) ) << " << " << 
-    hex::to_hex32(imm_i) << " = " << hex::to_hex0x32 (val);
-
-    }
-    // sets the register rd to the value
-    regs.set(rd,val);
-    pc+=4;
-}
-
-/**
- * exec a i type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a srli instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_srli(uint32_t insn, std::ostream* pos, int32_t imm_i)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-
-    // simulates the instruction
-    int32_t val =  (regs.get(rs1) << imm_i);
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_rtype(insn, "slt ");
-   *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = " << hex::to_hex0x32 (regs.get (rs1) ) << " >> " << 
-    hex::to_hex32(imm_i) << " = " << hex::to_hex0x32 (val);
-    }
-    // sets the register rd to the value
-    regs.set(rd,val);
-    pc+=4;
-}
-
-/**
- * exec a i type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a srai instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_srai(uint32_t insn, std::ostream* pos, int32_t imm_i)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-
-    // simulates the instruction
-    int32_t val =  (regs.get(rs1) >> imm_i);
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-   std::string s = render_rtype(insn, "slt ");
-   *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = " << hex::to_hex0x32 (regs.get (rs1) ) << " >> " << 
-    hex::to_hex32(imm_i) << " = " << hex::to_hex0x32 (val); 
-
-    }
-    // sets the register rd to the value
-    regs.set(rd,val);
-    pc+=4;
-}
- 
-/**
- * exec a r type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a add instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-   
-void rv32i_hart::exec_add(uint32_t insn, std::ostream* pos)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-    uint32_t rs2 = get_rs2(insn);
-
-    // simulates the instruction
-    int32_t val =  regs.get(rs1) + regs.get(rs2);
-
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_rtype(insn, "slt ");
-   *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = " << hex::to_hex0x32 (regs.get (rs1) ) << " + "
-    << hex::to_hex0x32 (rs2) << " = " << hex::to_hex0x32 (val);
-
-    }
-    // sets the register rd to the value
-    regs.set(rd,val);
-    pc+=4;
-}
-
-/**
- * exec a r type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a sub instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_sub(uint32_t insn, std::ostream* pos)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-    uint32_t rs2 = get_rs2(insn);
-
-    // simulates the instruction
-    int32_t val = regs.get(rs1) - regs.get(rs2);
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_rtype(insn, "slt ");
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = " << hex::to_hex0x32 (regs.get (rs1) ) << " - "
-    << hex::to_hex0x32 (rs2) << " = " << hex::to_hex0x32 (val);
-
-    }
-
-    // sets the register rd to the value
-    regs.set(rd,val);
-    pc+=4;
-
-}
-
-/**
- * exec a r type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a and instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_and(uint32_t insn, std::ostream* pos)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-    uint32_t rs2 = get_rs2(insn);
-
-    // simulates the instruction
-    int32_t val = regs.get(rs1) & regs.get(rs2);
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_rtype(insn, "slt ");
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = " << hex::to_hex0x32 (regs.get (rs1) ) << " & "
-    << hex::to_hex0x32 (rs2) << " = " << hex::to_hex0x32 (val);
-
-    }
-    // sets the register rd to the value
-    regs.set(rd,val);
-    pc+=4;
-
-}
-
-/**
-* exec a r type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a addi instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_or(uint32_t insn, std::ostream* pos)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-    uint32_t rs2 = get_rs2(insn);
-
-    // simulates the instruction
-    int32_t val = regs.get(rs1) | regs.get(rs2);
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-   std::string s = render_rtype(insn, "slt ");
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = " << hex::to_hex0x32 (regs.get (rs1) ) << " | "
-    << hex::to_hex0x32 (rs2) << " = " << hex::to_hex0x32 (val);
-
-    }
-    // sets the register rd to the value
-    regs.set(rd,val);
-    pc+=4;
-}
-
-/**
-* exec a r type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a sll instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_sll(uint32_t insn, std::ostream* pos)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-    uint32_t rs2 = get_rs2(insn);
-
-    // simulates the instruction
-    int32_t val = (regs.get(rs1) << (regs.get(rs2) % XLEN));
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_rtype(insn, "slt ");
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = " << hex::to_hex0x32 (regs.get (rs1) ) << " << " << 
-    XLEN << " = " << hex::to_hex0x32 (val);
-
-    }
-    // sets the register rd to the value
-    regs.set(rd,val);
-    pc+=4;
-}
-/**
-* exec a r type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a slt instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_slt(uint32_t insn, std::ostream* pos)
-{
-   uint32_t rd = get_rd(insn);
-   uint32_t rs1 = get_rs1(insn);
-   uint32_t rs2 = get_rs2(insn);
-
-   // simulates the instruction
-    int32_t val = (regs.get(rs1) < regs.get(rs2)) ? 1 : 0;
-
-   if ( pos )
-  {
-    std::string s = render_rtype(insn, "slt ");
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = (" << hex::to_hex0x32 (regs.get (rs1) ) << " < " << 
-    hex::to_hex0x32 (regs.get(rs2)) << ") ? 1 : 0 = " << hex::to_hex0x32 (val);
-  }
-  regs.set(rd, val);
-  pc += 4;
-
-}
-
-/**
-* exec a r type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a sltu instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_sltu(uint32_t insn, std::ostream* pos)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-    uint32_t rs2 = get_rs2(insn);
-
-    // simulates the instruction
-    int32_t val = ((regs.get(rs1)< regs.get(rs2))? 1: 0);
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_rtype(insn, "slt ");
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = (" << hex::to_hex0x32 (regs.get (rs1) ) << " <U " << 
-    hex::to_hex0x32 (regs.get(rs2)) << ") ? 1 : 0 = " << hex::to_hex0x32 (val);
-
-    }
-    // sets the register rd to the value
-    regs.set(rd,val);
-    pc+=4;
-}
-
-/**
-* exec a r type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a srl instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_srl(uint32_t insn, std::ostream* pos)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-    uint32_t rs2 = get_rs2(insn);
-
-    // simulates the instruction
-    int32_t val = (regs.get(rs1) >> (regs.get(rs2) % XLEN));
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_rtype(insn, "slt ");
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = " << hex::to_hex0x32 (regs.get (rs1) ) << " >> " << 
-    XLEN << " = " << hex::to_hex0x32 (val);
-
-    }
-    // sets the register rd to the value
-    regs.set(rd,val);
-    pc+=4;
-}
-
-/**
-* exec a r type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a sra instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_sra(uint32_t insn, std::ostream* pos)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-    uint32_t rs2 = get_rs2(insn);
-
-    // simulates the instruction
-    int32_t val = (regs.get(rs1) >> (regs.get(rs2) % XLEN));
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_rtype(insn, "slt ");
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = " << hex::to_hex0x32 (regs.get (rs1) ) << " >> " << 
-    XLEN << " = " << hex::to_hex0x32 (val);
-
-    }
-    // sets the register rd to the value
-    regs.set(rd,val);
-    pc+=4;
-}
-
-/**
-* exec a r type instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a xor instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_xor(uint32_t insn, std::ostream* pos)
-{
-    uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-    uint32_t rs2 = get_rs2(insn);
-
-    // simulates the instruction
-    int32_t val = regs.get(rs1) ^ regs.get(rs2);
-
-   // adds the rendered values plus a commented version of it to be printed
-    if ( pos )
-    {
-    std::string s = render_rtype(insn, "slt ");
-    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
-    *pos << "// " << render_reg(rd) << " = " << hex::to_hex0x32 (regs.get (rs1) ) << " ^ " << 
-    hex::to_hex32(rs2) << " = " << hex::to_hex0x32 (val);
-
-    }
-    // sets the register rd to the value
-    regs.set(rd,val);
-    pc+=4;
-}
-
-/**
-* exec a ecall instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a ecall instruction and halts the program 
- ********************************************************************************/
-void rv32i_hart::exec_ecall(uint32_t insn , std::ostream* pos)
-{
-    if(pos)
-    {
-        std::string s = render_ecall(insn);
-        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
-        *pos << "// HALT ";
-    }
-    halt = true;
-    halt_reason = " ECALL instruction ";
-
-}
-
-/**
-* exec a ebreak instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a ebreak instruction and halts the program 
- ********************************************************************************/
-void rv32i_hart::exec_ebreak(uint32_t insn , std::ostream* pos)
-{
-    if(pos)
-    {
-        std::string s = render_ebreak(insn);
-        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
-        *pos << "// HALT ";
-    }
-    halt = true;
-    halt_reason = " EBREAK instruction ";
-}
-
-/**
-* exec a csrrw instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a csrrw instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-
-void rv32i_hart::exec_csrrw(uint32_t insn, std::ostream* pos)
-{
-    //uint32_t rd = get_rd(insn);
-    
-    
-    int32_t imm_i = (insn & 0xfff00000);
-
-    pc >>= (imm_i % XLEN);     /// shifting mod bits
-
-}
-
-/**
-* exec a csrrw instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a csrrw instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_csrrs(uint32_t insn, std::ostream* pos)
-{
-   // uint32_t rd = get_rd(insn);
-    uint32_t rs1 = get_rs1(insn);
-    
-    int32_t imm_i = (insn & 0xfff00000);
-
-    pc = regs.get(rs1) - imm_i;      //sub
-
-}
- 
-
-/**
-* exec a csrrw instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a csrrw instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_csrrc(uint32_t insn, std::ostream* pos)
-{
-   // uint32_t rd = get_rd(insn);
-    
-    
-    int32_t imm_i = (insn & 0xfff00000);
-    uint32_t rs1 = get_rs1(insn);
-
-    pc = regs.get(rs1) + imm_i;      // add 
-
-}
-   
-
-/**
-* exec a csrrw instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a csrrw instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_csrrwi(uint32_t insn, std::ostream* pos)
-{
-   // uint32_t rd = get_rd(insn);
-    
-    
-    int32_t imm_i = (insn & 0xfff00000);        // get imm_i with out shifting
-    uint32_t rs1 = get_rs1(insn);
-
-    pc = regs.get(rs1) + imm_i;              // add and mask the last 12 bits
-}
-
-/**
-* exec a csrrw instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a csrrw instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_csrrsi(uint32_t insn, std::ostream* pos)
-{
-    //uint32_t rd = get_rd(insn);
-    
-    
-    int32_t imm_i = (insn & 0xfff00000);        // get imm_i with out shifting
-    uint32_t rs1 = get_rs1(insn);
-
-    pc = regs.get(rs1) + imm_i;              // add 
-
-}
-
-/**
-* exec a csrrw instruction
- * @return void
- *
-* @param insn the instruction needed to exec 
-* @param pos  ostream to be able to print   
- *
- * @note simulates the execution of a csrrw instruction and adds 4 to PC and sets the value in the register
- ********************************************************************************/
-void rv32i_hart::exec_csrrci(uint32_t insn, std::ostream* pos)
-{
-   // uint32_t rd = get_rd(insn);
-    
-    
-    int32_t imm_i = (insn & 0xfff00000);        // get imm_i with out shifting
-
-    pc >>= (imm_i % XLEN);        // shift 
-
-}
+#include "rv32i_hart.h"
+#include "syscalls.h"
+#include <fstream>
+#include <climits>
+#include <limits>
+
+/**
+* adds if illgeal instruction occured 
+*
+ * @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note sets the halt tag and adds why the reason for the halt
+ ********************************************************************************/
+void rv32i_hart::exec_illegal_insn ( uint32_t insn, std::ostream* pos)
+{
+   if ( pos )
+       *pos << render_illegal_insn (insn);
+
+   halt = true ;
+   halt_reason = "Illegal instruction";
+
+}
+
+/**
+ * Program ticker to exec an instruction
+ * @return void
+ *
+* @param hdr is a header string   
+ *
+ * @note simulates the execution of instructions and adds to the instruction counter
+ ********************************************************************************/
+void rv32i_hart::tick(const std::string & hdr)
+{
+    if(halt)
+    return;
+
+    if(sample_left && --sample_left == 0)
+        next_sample();
+
+    if(show_registers)
+        dump(hdr);
+
+    if(pc & 0x03)                   // a misaligned fetch is not counted
+    {
+        halt = true;
+        halt_reason = "PC alignment error";
+        return;
+    }
+
+    ++insn_counter;
+
+    uint32_t insn = mem.get32(pc);
+    observe(pc, 4, mem_observer::fetch);
+    if(!native_hooks.empty())
+    {
+        auto it = native_hooks.find(pc);
+        if(it != native_hooks.end())                // run the routine and return to ra
+        {
+            std::ostream *pos = show_instructions ? out : nullptr;
+            if(pos)
+                *out << hdr << xlen_t::to_hex(pc) << ": " << hex::to_hex32(insn) << "  ";
+            exec_native(it->second, pos);
+            if(pos)
+                *out << std::endl;
+            pc = regs.get(1) & ~(reg_t)1;
+            return;
+        }
+    }
+
+    if(show_instructions)
+    {
+        *out << hdr << xlen_t::to_hex(pc) << ": " << hex::to_hex32(insn) << "  ";
+        exec(insn, out);
+        *out << std::endl;
+    }
+    else 
+        exec(insn,nullptr);
+
+}
+
+/**
+ * Runs the first instructions fast, then in detail, optionally alternating
+ * @return void
+ *
+* @param fast_forward instructions to run with no tracing and no models first
+* @param window instructions in each detailed window
+* @param period instructions from the start of one window to the next, 0 to
+ * stay detailed after the first window starts
+ *
+ * @note fast mode turns off -i, -r and the observer and puts them back when
+ * a window starts. The switch is a countdown checked once per tick
+ ********************************************************************************/
+void rv32i_hart::set_sampling(uint64_t fast_forward, uint64_t window, uint64_t period)
+{
+    sample_window = window;
+    sample_period = period > window ? period : 0;
+    sampling = fast_forward || sample_period;
+    fast = fast_forward > 0;
+    mode_start = insn_counter;
+    fast_insns = 0;
+    detail_windows = fast ? 0 : 1;
+    if(fast)
+        sample_left = fast_forward + 1;
+    else
+        sample_left = sample_period ? window + 1 : 0;
+    apply_mode();
+}
+
+/**
+ * Switches between fast and detailed when the current stretch is used up
+ * @return void
+ ********************************************************************************/
+void rv32i_hart::next_sample()
+{
+    if(fast)
+    {
+        fast_insns += insn_counter - mode_start;
+        fast = false;
+        ++detail_windows;
+        sample_left = sample_period ? sample_window : 0;
+    }
+    else
+    {
+        fast = true;
+        mode_start = insn_counter;
+        sample_left = sample_period - sample_window;
+    }
+    apply_mode();
+}
+
+/**
+ * Turns the tracing and the observer on or off for the current mode
+ * @return void
+ ********************************************************************************/
+void rv32i_hart::apply_mode()
+{
+    show_instructions = detail.show_instructions && !fast;
+    show_registers = detail.show_registers && !fast;
+    observer = fast ? nullptr : detail.observer;
+}
+
+/**
+ * calls the register dump
+ * @return void
+ *
+* @param hdr is a header string  
+ *
+ * @note calls register files dump to print out the registers and then the pc
+ ********************************************************************************/
+void rv32i_hart::dump( const std::string & hdr) const
+{
+   
+    regs.dump(hdr, *out);
+    if(fp_used)
+        fregs.dump(hdr, *out);
+    if(v_used)
+        vregs.dump(hdr, *out);
+
+    *out << hdr << " pc " << xlen_t::to_hex(pc) << std::endl;
+}
+
+/**
+ * Writes the registers as a raw binary image
+ * @return bool false if the file could not be written
+ *
+* @param fname the name of the file to write
+ *
+ * @note writes x0 to x31 followed by the pc, each as an XLEN-bit little-endian word
+ ********************************************************************************/
+bool rv32i_hart::save_registers(const std::string &fname) const
+{
+    std::ofstream outfile(fname, std::ios::out|std::ios::binary|std::ios::trunc);
+    if(!outfile.is_open())
+    {
+        std::cerr << "Can't open file " <<  fname << " for writing." << std::endl;
+        return false;
+    }
+
+    regs.save(outfile);
+    char b[XLEN/8];
+    for(size_t i = 0; i < sizeof(b); ++i)
+        b[i] = (char)(pc >> (i*8));
+    outfile.write(b, sizeof(b));
+
+    if(!outfile)
+    {
+        std::cerr << "Error writing " << fname << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Copies the state a lockstep run compares
+ * @return void
+ *
+* @param st filled with the pc, the x registers, the last store and the halt flag
+ *
+ * @note registers are zero extended so RV32 and RV64 states have the same layout
+ ********************************************************************************/
+void rv32i_hart::get_state(cosim_state &st) const
+{
+    st.pc = pc;
+    for(uint32_t r = 0; r < 32; ++r)
+        st.x[r] = (reg_t)regs.get(r);
+    st.write_addr = mem.get_last_write_addr();
+    st.write_val = mem.get_last_write_val();
+    st.write_len = mem.get_last_write_len();
+    st.halted = halt;
+}
+
+/**
+ * Copies the hart state into snap
+ * @return void
+ *
+* @param snap gets the state
+ *
+ * @note memory is not part of the hart, the caller saves it
+ ********************************************************************************/
+void rv32i_hart::save_snapshot(snapshot &snap) const
+{
+    snap.regs = regs;
+    snap.fregs = fregs;
+    snap.vregs = vregs;
+    snap.pc = pc;
+    snap.insn_counter = insn_counter;
+    snap.cycle_offset = cycle_offset;
+    snap.instret_offset = instret_offset;
+    snap.halt = halt;
+    snap.halt_reason = halt_reason;
+    snap.fp_used = fp_used;
+    snap.v_used = v_used;
+}
+
+/**
+ * Puts back a state saved by save_snapshot
+ * @return void
+ *
+* @param snap the saved state
+ ********************************************************************************/
+void rv32i_hart::restore_snapshot(const snapshot &snap)
+{
+    regs = snap.regs;
+    fregs = snap.fregs;
+    vregs = snap.vregs;
+    pc = snap.pc;
+    insn_counter = snap.insn_counter;
+    cycle_offset = snap.cycle_offset;
+    instret_offset = snap.instret_offset;
+    halt = snap.halt;
+    halt_reason = snap.halt_reason;
+    fp_used = snap.fp_used;
+    v_used = snap.v_used;
+}
+
+/**
+ * Resets all the GP varibles  
+ * @return void
+ *
+ *
+ * @note Makes all the global varibles reset to be able to be used again
+ ********************************************************************************/
+void rv32i_hart::reset()
+{
+    pc = 0;
+    insn_counter = 0;
+    halt = false;
+    halt_reason = "none";
+    fregs.reset();
+    fp_used = false;
+    vregs.reset();
+    v_used = false;
+    cycle_offset = 0;
+    instret_offset = 0;
+    time_base = std::chrono::steady_clock::now();
+
+}
+
+/**
+ * Main exec to find methods
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note Goes through a switch to find what function is need for the instruction 
+ * to be able to execute it 
+ ********************************************************************************/
+void rv32i_hart::exec(uint32_t insn, std::ostream* pos)
+{
+     uint32_t funct3 = get_funct3(insn);
+    uint32_t funct7 = get_funct7(insn);
+    
+// switch goes those all possible opcodes and then has sub switchs to break down by the funct3 and then used
+// funct7 as needed to break down more
+switch(get_opcode(insn))
+{
+    default:  exec_illegal_insn(insn,pos); return;
+    case opcode_lui:  exec_lui(insn,pos); return;
+    case opcode_auipc:  exec_auipc(insn,pos); return;
+    case opcode_jal:  exec_jal(insn,pos); return;
+    case opcode_jalr:  exec_jalr(insn,pos); return;
+
+
+    case opcode_btype:
+        switch (funct3)
+        {
+            default:  exec_illegal_insn(insn,pos);return;
+            case funct3_beq:  exec_beq(insn, pos); return;
+            case funct3_bne:  exec_bne(insn, pos); return;
+            case funct3_blt:  exec_blt(insn, pos); return;
+            case funct3_bge:  exec_bge(insn, pos); return;
+            case funct3_bltu:  exec_bltu(insn, pos); return;
+            case funct3_bgeu:  exec_bgeu(insn, pos); return;
+        }
+
+        assert(0 && "unrecognized funct3");  //impossible
+
+    case opcode_load_imm:
+        switch(funct3)
+        {
+            default:  exec_illegal_insn(insn,pos);return;
+            case funct3_lb:  exec_lb( insn,pos); return;
+            case funct3_lh:  exec_lh( insn, pos); return;
+            case funct3_lw:  exec_lw( insn, pos); return;
+            case funct3_lbu:  exec_lbu( insn, pos); return;
+            case funct3_lhu:  exec_lhu( insn, pos); return;
+            case funct3_ld:
+                if(XLEN < 64)
+                {
+                    exec_illegal_insn(insn,pos); return;
+                }
+                exec_ld( insn, pos); return;
+            case funct3_lwu:
+                if(XLEN < 64)
+                {
+                    exec_illegal_insn(insn,pos); return;
+                }
+                exec_lwu( insn, pos); return;
+
+        }
+     assert(0 && "unrecognized funct3");  //impossible
+
+      case opcode_stype:
+        switch(funct3)
+        {
+            default:  exec_illegal_insn(insn,pos);return;
+           case funct3_sb:  exec_sb( insn,pos); return;
+           case funct3_sh:  exec_sh( insn, pos); return;
+           case funct3_sw:  exec_sw( insn, pos); return;
+           case funct3_sd:
+                if(XLEN < 64)
+                {
+                    exec_illegal_insn(insn,pos); return;
+                }
+                exec_sd( insn, pos); return;
+
+        }
+    assert(0 && "unrecognized funct3");  //impossible
+
+    case opcode_alu_imm:
+        switch (funct3)
+        {
+            default:  exec_illegal_insn(insn,pos);return;
+            case funct3_add:  exec_addi(insn, pos, get_imm_i(insn)); return;
+            case funct3_sll:
+                if(funct7 == funct7_rot)            // Zbb count instructions
+                {
+                    switch(get_rs2(insn))
+                    {
+                        default:  exec_illegal_insn(insn,pos);return;
+                        case rs2_clz:  exec_clz(insn, pos); return;
+                        case rs2_ctz:  exec_ctz(insn, pos); return;
+                        case rs2_cpop:  exec_cpop(insn, pos); return;
+                        case rs2_sextb:  exec_sext_b(insn, pos); return;
+                        case rs2_sexth:  exec_sext_h(insn, pos); return;
+                    }
+                }
+                if((funct7 & xlen_t::funct7_mask) != 0)
+                {
+                    exec_illegal_insn(insn,pos); return;
+                }
+                exec_slli(insn, pos, get_imm_i(insn)%XLEN); return;
+            case funct3_slt:  exec_slti(insn, pos, get_imm_i(insn)); return;
+            case funct3_sltu:  exec_sltiu(insn, pos, get_imm_i(insn)); return;
+            case funct3_xor:  exec_xori(insn, pos, get_imm_i(insn)); return;
+        
+            case funct3_or:  exec_ori(insn, pos, get_imm_i(insn)); return;
+            case funct3_and:  exec_andi(insn, pos, get_imm_i(insn)); return;
+
+            case funct3_srx:
+                switch(funct7 & xlen_t::funct7_mask)     // RV64I uses the low funct7 bit for shamt
+                {
+                    default:  exec_illegal_insn(insn,pos);return;
+                    case funct7_sra:  exec_srai(insn, pos, get_imm_i(insn)%XLEN); return;
+                    case funct7_srl:  exec_srli(insn, pos, get_imm_i(insn)%XLEN); return;
+                    case funct7_rot:  exec_rori(insn, pos, get_imm_i(insn)%XLEN); return;
+                    case funct7_rev8:
+                        if(get_rs2(insn) == rs2_rev8)
+                        {
+                            exec_rev8(insn, pos); return;
+                        }
+                        exec_illegal_insn(insn,pos);return;
+                    case funct7_orcb:
+                        if(get_rs2(insn) == rs2_orcb)
+                        {
+                            exec_orc_b(insn, pos); return;
+                        }
+                        exec_illegal_insn(insn,pos);return;
+                }
+
+            assert(0 && "unrecognized funct7");  //impossible
+        }
+
+        assert(0 && "unrecognized funct3");  //impossible
+
+        case opcode_rtype:
+            if(funct7 == funct7_muldiv)         // RV32M
+            {
+                switch(funct3)
+                {
+                    default:  exec_illegal_insn(insn,pos);return;
+                    case funct3_mul:  exec_mul(insn,pos); return;
+                    case funct3_mulh:  exec_mulh(insn,pos); return;
+                    case funct3_mulhsu:  exec_mulhsu(insn,pos); return;
+                    case funct3_mulhu:  exec_mulhu(insn,pos); return;
+                    case funct3_div:  exec_div(insn,pos); return;
+                    case funct3_divu:  exec_divu(insn,pos); return;
+                    case funct3_rem:  exec_rem(insn,pos); return;
+                    case funct3_remu:  exec_remu(insn,pos); return;
+                }
+            }
+            if(funct7 == funct7_shadd)          // Zba
+            {
+                switch(funct3)
+                {
+                    default:  exec_illegal_insn(insn,pos);return;
+                    case funct3_sh1add:  exec_sh1add(insn,pos); return;
+                    case funct3_sh2add:  exec_sh2add(insn,pos); return;
+                    case funct3_sh3add:  exec_sh3add(insn,pos); return;
+                }
+            }
+            if(funct7 == funct7_minmax)         // Zbb
+            {
+                switch(funct3)
+                {
+                    default:  exec_illegal_insn(insn,pos);return;
+                    case funct3_min:  exec_min(insn,pos); return;
+                    case funct3_minu:  exec_minu(insn,pos); return;
+                    case funct3_max:  exec_max(insn,pos); return;
+                    case funct3_maxu:  exec_maxu(insn,pos); return;
+                }
+            }
+            if(funct7 == funct7_rot)            // Zbb
+            {
+                switch(funct3)
+                {
+                    default:  exec_illegal_insn(insn,pos);return;
+                    case funct3_rol:  exec_rol(insn,pos); return;
+                    case funct3_ror:  exec_ror(insn,pos); return;
+                }
+            }
+            if(funct7 == funct7_zexth && XLEN == 32)    // Zbb, RV64 has it in OP-32
+            {
+                if(funct3 == funct3_zexth && get_rs2(insn) == 0)
+                {
+                    exec_zext_h(insn,pos); return;
+                }
+                exec_illegal_insn(insn,pos); return;
+            }
+            if(funct7 != funct7_add && funct7 != funct7_sub)
+            {
+                exec_illegal_insn(insn,pos); return;
+            }
+            switch(funct3)
+            {
+                default:  exec_illegal_insn(insn,pos);return;
+                case funct3_add: 
+                    switch(funct7)
+                    {
+                        default:  exec_illegal_insn(insn,pos);return;
+                        case funct7_add:  exec_add(insn,pos); return;
+                        case funct7_sub:  exec_sub(insn,pos); return;
+                    }
+                case funct3_sll:
+                    if(funct7 != funct7_add)
+                    {
+                        exec_illegal_insn(insn,pos); return;
+                    }
+                    exec_sll(insn,pos); return;
+                case funct3_slt:
+                    if(funct7 != funct7_add)
+                    {
+                        exec_illegal_insn(insn,pos); return;
+                    }
+                    exec_slt(insn,pos); return;
+                case funct3_sltu:
+                    if(funct7 != funct7_add)
+                    {
+                        exec_illegal_insn(insn,pos); return;
+                    }
+                    exec_sltu(insn,pos); return;
+                case funct3_xor:
+                    if(funct7 == funct7_sub)
+                    {
+                        exec_xnor(insn,pos); return;
+                    }
+                    exec_xor(insn,pos); return;
+                case funct3_or:
+                    if(funct7 == funct7_sub)
+                    {
+                        exec_orn(insn,pos); return;
+                    }
+                    exec_or(insn,pos); return;
+                case funct3_and:
+                    if(funct7 == funct7_sub)
+                    {
+                        exec_andn(insn,pos); return;
+                    }
+                    exec_and(insn,pos); return;
+                case funct3_srx:
+                switch(funct7)
+                {
+                    default: return exec_illegal_insn(insn,pos);return;
+                    case funct7_sra:   exec_sra(insn,pos); return;
+                    case funct7_srl:   exec_srl(insn,pos); return;
+                }
+               
+
+                assert(0 && "unrecognized funct7");  //impossible
+            }
+            assert(0 && "unrecognized funct7");  //impossible
+
+        case opcode_alu_imm_w:              // RV64I only
+            if(XLEN < 64)
+            {
+                exec_illegal_insn(insn,pos); return;
+            }
+            switch(funct3)
+            {
+                default:  exec_illegal_insn(insn,pos); return;
+                case funct3_add:  exec_addiw(insn,pos); return;
+                case funct3_sll:
+                    if(funct7 != 0)
+                    {
+                        exec_illegal_insn(insn,pos); return;
+                    }
+                    exec_slliw(insn,pos); return;
+                case funct3_srx:
+                    switch(funct7)
+                    {
+                        default:  exec_illegal_insn(insn,pos); return;
+                        case funct7_sra:  exec_sraiw(insn,pos); return;
+                        case funct7_srl:  exec_srliw(insn,pos); return;
+                    }
+            }
+
+        case opcode_rtype_w:                // RV64I and RV64M only
+            if(XLEN < 64)
+            {
+                exec_illegal_insn(insn,pos); return;
+            }
+            if(funct7 == funct7_muldiv)
+            {
+                switch(funct3)
+                {
+                    default:  exec_illegal_insn(insn,pos); return;
+                    case funct3_mul:  exec_mulw(insn,pos); return;
+                    case funct3_div:  exec_divw(insn,pos); return;
+                    case funct3_divu:  exec_divuw(insn,pos); return;
+                    case funct3_rem:  exec_remw(insn,pos); return;
+                    case funct3_remu:  exec_remuw(insn,pos); return;
+                }
+            }
+            if(funct7 == funct7_zexth)          // Zbb
+            {
+                if(funct3 == funct3_zexth && get_rs2(insn) == 0)
+                {
+                    exec_zext_h(insn,pos); return;
+                }
+                exec_illegal_insn(insn,pos); return;
+            }
+            switch(funct3)
+            {
+                default:  exec_illegal_insn(insn,pos); return;
+                case funct3_add:
+                    switch(funct7)
+                    {
+                        default:  exec_illegal_insn(insn,pos); return;
+                        case funct7_add:  exec_addw(insn,pos); return;
+                        case funct7_sub:  exec_subw(insn,pos); return;
+                    }
+                case funct3_sll:
+                    if(funct7 != 0)
+                    {
+                        exec_illegal_insn(insn,pos); return;
+                    }
+                    exec_sllw(insn,pos); return;
+                case funct3_srx:
+                    switch(funct7)
+                    {
+                        default:  exec_illegal_insn(insn,pos); return;
+                        case funct7_sra:  exec_sraw(insn,pos); return;
+                        case funct7_srl:  exec_srlw(insn,pos); return;
+                    }
+            }
+
+        case opcode_op_v:  exec_vector(insn,pos); return;
+
+        case opcode_load_fp:
+            if(is_vector_mem(insn))
+            {
+                exec_vle(insn,pos); return;
+            }
+            exec_fp(insn,pos); return;
+        case opcode_store_fp:
+            if(is_vector_mem(insn))
+            {
+                exec_vse(insn,pos); return;
+            }
+            exec_fp(insn,pos); return;
+        case opcode_fmadd:
+        case opcode_fmsub:
+        case opcode_fnmsub:
+        case opcode_fnmadd:
+        case opcode_op_fp:  exec_fp(insn,pos); return;
+
+        case opcode_system:
+            switch(funct3)
+           {
+                case 0b000:
+                    switch(get_imm_i(insn))
+                    {
+                        case 0: exec_ecall(insn,pos); return;
+                        case 1: exec_ebreak(insn,pos); return;
+                    }
+               
+                case funct3_csrrw:  exec_csrrw(insn, pos); return;
+                case funct3_csrrs:  exec_csrrs(insn, pos); return;
+                case funct3_csrrc:  exec_csrrc (insn, pos); return;
+                case funct3_csrrwi:  exec_csrrwi(insn, pos); return;
+                case funct3_csrrsi:  exec_csrrsi(insn, pos); return;
+                case funct3_csrrci:  exec_csrrci(insn, pos); return;
+                assert(0 && "unrecognized funct3");  //impossible
+            }
+
+assert(0 && "unrecognized get_opcode(insn)"); // It should be //impossible to ever get here!
+
+}
+
+}
+
+/**
+ * prints a exec lui  
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a lui instruction and adds 4 to PC and sets the
+ * value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_lui(uint32_t insn,std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    int32_t imm_u = get_imm_u(insn);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_lui(insn);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x(imm_u);
+
+    }
+    regs.set(rd, imm_u);
+    pc += 4;
+}
+
+/**
+ * prints a exec auipc  
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a auipc instruction and adds 4 to PC and sets the
+ * value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_auipc(uint32_t insn,std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    int32_t imm_u = get_imm_u(insn);
+
+    // simulates the instruction
+    reg_t val = pc + imm_u;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_auipc(insn);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x(pc) << " + " << xlen_t::to_hex0x(imm_u)
+    << " = " << xlen_t::to_hex0x(val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd, val);
+    pc += 4;
+}
+
+
+/**
+ * exec a jal instruction 
+ ** @return void
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a jal instruction and adds 4 to PC and sets the
+ * value in the register
+ ********************************************************************************/
+///@parm pc The memory pcess where the insn is stored.
+void rv32i_hart::exec_jal(uint32_t insn,std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    int32_t imm_j = get_imm_j(insn);
+
+    // simulates the instruction
+    reg_t val = pc + 4;
+    reg_t target = pc + imm_j;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_jal(pc,insn);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x(val) << ",  pc = " << xlen_t::to_hex0x(pc)
+    << " + " << xlen_t::to_hex0x(imm_j) << " = " << xlen_t::to_hex0x(target);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd, val);
+    pc = target;
+}
+
+/**
+ * exec a jalr instruction 
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a jalr instruction and adds (regs.get(rs1)+imm_i) & ~1 to PC and sets the
+ * value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_jalr(uint32_t insn,std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    int32_t imm_i = get_imm_i(insn);
+    uint32_t rs1 = get_rs1(insn);
+
+    // simulates the instruction, rs1 is read before rd is written
+    reg_t val = pc + 4;
+    reg_t target = (regs.get(rs1) + imm_i) & ~(reg_t)1;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_jalr(insn);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x(val) << ",  pc = (" << xlen_t::to_hex0x(imm_i)
+    << " + " << xlen_t::to_hex0x(regs.get(rs1)) << ") & " << xlen_t::to_hex0x(~(reg_t)1) << " = " << xlen_t::to_hex0x(target);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd, val);
+    pc = target;
+}
+
+
+/**
+ * exec a beq instruction 
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a beq instruction and adds(regs.get(rs1) == regs.get(rs2)) ? imm_b : 4);to PC
+ ********************************************************************************/
+void rv32i_hart::exec_beq(uint32_t insn, std::ostream* pos)
+{
+    int32_t imm_b = get_imm_b(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+
+    // simulates the instruction
+    reg_t target = pc + (regs.get(rs1) == regs.get(rs2) ? imm_b : 4);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_btype(pc,insn,"beq");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// pc += (" << xlen_t::to_hex0x(regs.get(rs1)) << " == " << xlen_t::to_hex0x(regs.get(rs2))
+    << " ? " << xlen_t::to_hex0x(imm_b) << " : 4) = " << xlen_t::to_hex0x(target);
+
+    }
+    pc = target;
+}
+
+/**
+ * exec a bge instruction 
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a bge instruction and adds(regs.get(rs1) >= regs.get(rs2)) ? imm_b : 4);to PC
+ ********************************************************************************/
+void rv32i_hart::exec_bge(uint32_t insn, std::ostream* pos)
+{
+    int32_t imm_b = get_imm_b(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+
+    // simulates the instruction
+    reg_t target = pc + (regs.get(rs1) >= regs.get(rs2) ? imm_b : 4);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_btype(pc,insn,"bge");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// pc += (" << xlen_t::to_hex0x(regs.get(rs1)) << " >= " << xlen_t::to_hex0x(regs.get(rs2))
+    << " ? " << xlen_t::to_hex0x(imm_b) << " : 4) = " << xlen_t::to_hex0x(target);
+
+    }
+    pc = target;
+}
+
+/**
+ * exec a bgeu instruction 
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a bgeu instruction and adds(regs.get(rs1) >= regs.get(rs2)) ? imm_b : 4);to PC for
+ * an unsigned 
+ ********************************************************************************/
+void rv32i_hart::exec_bgeu(uint32_t insn, std::ostream* pos)
+{
+    int32_t imm_b = get_imm_b(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+
+    // simulates the instruction
+    reg_t target = pc + ((reg_t)regs.get(rs1) >= (reg_t)regs.get(rs2) ? imm_b : 4);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_btype(pc,insn,"bgeu");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// pc += (" << xlen_t::to_hex0x(regs.get(rs1)) << " >=U " << xlen_t::to_hex0x(regs.get(rs2))
+    << " ? " << xlen_t::to_hex0x(imm_b) << " : 4) = " << xlen_t::to_hex0x(target);
+
+    }
+    pc = target;
+}
+
+/**
+ * exec a blt instruction 
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a blt instruction and adds(regs.get(rs1) < regs.get(rs2)) ? imm_b : 4);to PC
+ ********************************************************************************/
+void rv32i_hart::exec_blt(uint32_t insn, std::ostream* pos)
+{
+    int32_t imm_b = get_imm_b(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+
+    // simulates the instruction
+    reg_t target = pc + (regs.get(rs1) < regs.get(rs2) ? imm_b : 4);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_btype(pc,insn,"blt");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// pc += (" << xlen_t::to_hex0x(regs.get(rs1)) << " < " << xlen_t::to_hex0x(regs.get(rs2))
+    << " ? " << xlen_t::to_hex0x(imm_b) << " : 4) = " << xlen_t::to_hex0x(target);
+
+    }
+    pc = target;
+}
+
+/**
+ * exec a bltu instruction 
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a beq instruction and adds(regs.get(rs1) < regs.get(rs2)) ? imm_b : 4);to PC for 
+ * unsigned
+ ********************************************************************************/
+void rv32i_hart::exec_bltu(uint32_t insn, std::ostream* pos)
+{
+    int32_t imm_b = get_imm_b(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+
+    // simulates the instruction
+    reg_t target = pc + ((reg_t)regs.get(rs1) < (reg_t)regs.get(rs2) ? imm_b : 4);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_btype(pc,insn,"bltu");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// pc += (" << xlen_t::to_hex0x(regs.get(rs1)) << " <U " << xlen_t::to_hex0x(regs.get(rs2))
+    << " ? " << xlen_t::to_hex0x(imm_b) << " : 4) = " << xlen_t::to_hex0x(target);
+
+    }
+    pc = target;
+}
+
+/**
+ * exec a bne instruction 
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a bne instruction and adds(regs.get(rs1) != regs.get(rs2)) ? imm_b : 4);to PC
+ ********************************************************************************/
+void rv32i_hart::exec_bne(uint32_t insn, std::ostream* pos)
+{
+    int32_t imm_b = get_imm_b(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+
+    // simulates the instruction
+    reg_t target = pc + (regs.get(rs1) != regs.get(rs2) ? imm_b : 4);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_btype(pc,insn,"bne");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// pc += (" << xlen_t::to_hex0x(regs.get(rs1)) << " != " << xlen_t::to_hex0x(regs.get(rs2))
+    << " ? " << xlen_t::to_hex0x(imm_b) << " : 4) = " << xlen_t::to_hex0x(target);
+
+    }
+    pc = target;
+}
+
+
+
+/**
+ * exec a load instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a lb instruction and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_lb(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    int32_t imm_i = get_imm_i(insn);
+
+    // simulates the instruction
+    reg_t addr = regs.get(rs1) + imm_i;
+    sreg_t val = mem.get8_sx(addr);
+    observe(addr, 1, mem_observer::load);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_itype_load(insn,"lb");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = sx(m8(" << xlen_t::to_hex0x(regs.get(rs1)) << " + " << xlen_t::to_hex0x(imm_i)
+    << ")) = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a load instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a lh instruction and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_lh(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    int32_t imm_i = get_imm_i(insn);
+
+    // simulates the instruction
+    reg_t addr = regs.get(rs1) + imm_i;
+    sreg_t val = mem.get16_sx(addr);
+    observe(addr, 2, mem_observer::load);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_itype_load(insn,"lh");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = sx(m16(" << xlen_t::to_hex0x(regs.get(rs1)) << " + " << xlen_t::to_hex0x(imm_i)
+    << ")) = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a load instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a lw instruction and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_lw(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    int32_t imm_i = get_imm_i(insn);
+
+    // simulates the instruction
+    reg_t addr = regs.get(rs1) + imm_i;
+    sreg_t val = mem.get32_sx(addr);
+    observe(addr, 4, mem_observer::load);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_itype_load(insn,"lw");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = sx(m32(" << xlen_t::to_hex0x(regs.get(rs1)) << " + " << xlen_t::to_hex0x(imm_i)
+    << ")) = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a load instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a lbu instruction and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_lbu(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    int32_t imm_i = get_imm_i(insn);
+
+    // simulates the instruction
+    reg_t addr = regs.get(rs1) + imm_i;
+    sreg_t val = mem.get8(addr);
+    observe(addr, 1, mem_observer::load);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_itype_load(insn,"lbu");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = zx(m8(" << xlen_t::to_hex0x(regs.get(rs1)) << " + " << xlen_t::to_hex0x(imm_i)
+    << ")) = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a load instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a lhu instruction and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_lhu(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    int32_t imm_i = get_imm_i(insn);
+
+    // simulates the instruction
+    reg_t addr = regs.get(rs1) + imm_i;
+    sreg_t val = mem.get16(addr);
+    observe(addr, 2, mem_observer::load);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_itype_load(insn,"lhu");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = zx(m16(" << xlen_t::to_hex0x(regs.get(rs1)) << " + " << xlen_t::to_hex0x(imm_i)
+    << ")) = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd, val);
+    pc+=4;
+}
+ 
+
+/**
+ * exec a s type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a sb instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_sb(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    int32_t imm_s = get_imm_s(insn);
+
+    // simulates the instruction
+    reg_t addr = regs.get(rs1) + imm_s;
+    uint8_t val = regs.get(rs2);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_stype(insn, "sb");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// m8(" << xlen_t::to_hex0x(regs.get(rs1)) << " + " << xlen_t::to_hex0x(imm_s)
+    << ") = " << xlen_t::to_hex0x(val);
+
+    }
+    mem.set8(addr, val);
+    observe(addr, 1, mem_observer::store);
+    pc+=4;
+}
+/**
+ * exec a s type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a sh instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_sh(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    int32_t imm_s = get_imm_s(insn);
+
+    // simulates the instruction
+    reg_t addr = regs.get(rs1) + imm_s;
+    uint16_t val = regs.get(rs2);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_stype(insn, "sh");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// m16(" << xlen_t::to_hex0x(regs.get(rs1)) << " + " << xlen_t::to_hex0x(imm_s)
+    << ") = " << xlen_t::to_hex0x(val);
+
+    }
+    mem.set16(addr, val);
+    observe(addr, 2, mem_observer::store);
+    pc+=4;
+}
+
+/**
+ * exec a s type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a sw instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_sw(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    int32_t imm_s = get_imm_s(insn);
+
+    // simulates the instruction
+    reg_t addr = regs.get(rs1) + imm_s;
+    uint32_t val = regs.get(rs2);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_stype(insn, "sw");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// m32(" << xlen_t::to_hex0x(regs.get(rs1)) << " + " << xlen_t::to_hex0x(imm_s)
+    << ") = " << xlen_t::to_hex0x(val);
+
+    }
+    mem.set32(addr, val);
+    observe(addr, 4, mem_observer::store);
+    pc+=4;
+}
+
+/**
+ * exec a i type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a addi instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_addi(uint32_t insn, std::ostream* pos, int32_t imm_i)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+
+    // simulates the instruction
+    sreg_t val = regs.get(rs1) + imm_i;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_itype_alu(insn,"addi",imm_i);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x(regs.get(rs1)) << " + " << xlen_t::to_hex0x(imm_i) << " = " << xlen_t::to_hex0x(val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+ * exec a i type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a slti instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_slti(uint32_t insn, std::ostream* pos, int32_t imm_i)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+
+    // simulates the instruction
+    sreg_t val = (regs.get(rs1) < imm_i) ? 1 : 0;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_itype_alu(insn,"slti",imm_i);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << "(" << xlen_t::to_hex0x(regs.get(rs1)) << " < " << std::dec << imm_i << ") ? 1 : 0" << " = " << xlen_t::to_hex0x(val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+ * exec a i type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a sltiu instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_sltiu(uint32_t insn, std::ostream* pos, int32_t imm_i)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+
+    // simulates the instruction
+    sreg_t val = ((reg_t)regs.get(rs1) < (reg_t)(sreg_t)imm_i) ? 1 : 0;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_itype_alu(insn,"sltiu",imm_i);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << "(" << xlen_t::to_hex0x(regs.get(rs1)) << " <U " << std::dec << imm_i << ") ? 1 : 0" << " = " << xlen_t::to_hex0x(val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+ * exec a i type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a xori instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_xori(uint32_t insn, std::ostream* pos, int32_t imm_i)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+
+    // simulates the instruction
+    sreg_t val = regs.get(rs1) ^ imm_i;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_itype_alu(insn,"xori",imm_i);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x(regs.get(rs1)) << " ^ " << xlen_t::to_hex0x(imm_i) << " = " << xlen_t::to_hex0x(val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+ * exec a i type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a ori instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_ori(uint32_t insn, std::ostream* pos, int32_t imm_i)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+
+    // simulates the instruction
+    sreg_t val = regs.get(rs1) | imm_i;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_itype_alu(insn,"ori",imm_i);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x(regs.get(rs1)) << " | " << xlen_t::to_hex0x(imm_i) << " = " << xlen_t::to_hex0x(val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+ * exec a i type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a andi instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_andi(uint32_t insn, std::ostream* pos, int32_t imm_i)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+
+    // simulates the instruction
+    sreg_t val = regs.get(rs1) & imm_i;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_itype_alu(insn,"andi",imm_i);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x(regs.get(rs1)) << " & " << xlen_t::to_hex0x(imm_i) << " = " << xlen_t::to_hex0x(val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+ * exec a i type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a slli instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_slli(uint32_t insn, std::ostream* pos, int32_t imm_i)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+
+    // simulates the instruction
+    sreg_t val = (reg_t)regs.get(rs1) << imm_i;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_itype_alu(insn,"slli",imm_i);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x(regs.get(rs1)) << " << " << std::dec << imm_i << " = " << xlen_t::to_hex0x(val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+ * exec a i type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a srli instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_srli(uint32_t insn, std::ostream* pos, int32_t imm_i)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+
+    // simulates the instruction
+    sreg_t val = (reg_t)regs.get(rs1) >> imm_i;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_itype_alu(insn,"srli",imm_i);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x(regs.get(rs1)) << " >> " << std::dec << imm_i << " = " << xlen_t::to_hex0x(val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+ * exec a i type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a srai instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_srai(uint32_t insn, std::ostream* pos, int32_t imm_i)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+
+    // simulates the instruction
+    sreg_t val = regs.get(rs1) >> imm_i;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_itype_alu(insn,"srai",imm_i);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x(regs.get(rs1)) << " >> " << std::dec << imm_i << " = " << xlen_t::to_hex0x(val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+ 
+/**
+ * exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a add instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+   
+void rv32i_hart::exec_add(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+
+    // simulates the instruction
+    sreg_t val = regs.get(rs1) + regs.get(rs2);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn,"add");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x(regs.get(rs1)) << " + " << xlen_t::to_hex0x(regs.get(rs2)) << " = " << xlen_t::to_hex0x(val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+ * exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a sub instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_sub(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+
+    // simulates the instruction
+    sreg_t val = regs.get(rs1) - regs.get(rs2);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn,"sub");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x(regs.get(rs1)) << " - " << xlen_t::to_hex0x(regs.get(rs2)) << " = " << xlen_t::to_hex0x(val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+ * exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a and instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_and(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+
+    // simulates the instruction
+    sreg_t val = regs.get(rs1) & regs.get(rs2);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn,"and");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x(regs.get(rs1)) << " & " << xlen_t::to_hex0x(regs.get(rs2)) << " = " << xlen_t::to_hex0x(val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a addi instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_or(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+
+    // simulates the instruction
+    sreg_t val = regs.get(rs1) | regs.get(rs2);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn,"or");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x(regs.get(rs1)) << " | " << xlen_t::to_hex0x(regs.get(rs2)) << " = " << xlen_t::to_hex0x(val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a sll instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_sll(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t shamt = regs.get(rs2) & xlen_t::shamt_mask;
+
+    // simulates the instruction
+    sreg_t val = (reg_t)regs.get(rs1) << shamt;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn,"sll");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x(regs.get(rs1)) << " << " << std::dec << shamt << " = " << xlen_t::to_hex0x(val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a slt instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_slt(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+
+    // simulates the instruction
+    sreg_t val = (regs.get(rs1) < regs.get(rs2)) ? 1 : 0;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn,"slt");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << "(" << xlen_t::to_hex0x(regs.get(rs1)) << " < " << xlen_t::to_hex0x(regs.get(rs2)) << ") ? 1 : 0" << " = " << xlen_t::to_hex0x(val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a sltu instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_sltu(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+
+    // simulates the instruction
+    sreg_t val = ((reg_t)regs.get(rs1) < (reg_t)regs.get(rs2)) ? 1 : 0;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn,"sltu");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << "(" << xlen_t::to_hex0x(regs.get(rs1)) << " <U " << xlen_t::to_hex0x(regs.get(rs2)) << ") ? 1 : 0" << " = " << xlen_t::to_hex0x(val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a srl instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_srl(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t shamt = regs.get(rs2) & xlen_t::shamt_mask;
+
+    // simulates the instruction
+    sreg_t val = (reg_t)regs.get(rs1) >> shamt;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn,"srl");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x(regs.get(rs1)) << " >> " << std::dec << shamt << " = " << xlen_t::to_hex0x(val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a sra instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_sra(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t shamt = regs.get(rs2) & xlen_t::shamt_mask;
+
+    // simulates the instruction
+    sreg_t val = regs.get(rs1) >> shamt;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn,"sra");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x(regs.get(rs1)) << " >> " << std::dec << shamt << " = " << xlen_t::to_hex0x(val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a xor instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_xor(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+
+    // simulates the instruction
+    sreg_t val = regs.get(rs1) ^ regs.get(rs2);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn,"xor");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x(regs.get(rs1)) << " ^ " << xlen_t::to_hex0x(regs.get(rs2)) << " = " << xlen_t::to_hex0x(val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a mul instruction, the low 32 bits of rs1 * rs2, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_mul(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    sreg_t a = regs.get(rs1);
+    sreg_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = (reg_t)a * (reg_t)b;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "mul");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x (a) << " * " << 
+    xlen_t::to_hex0x (b) << " = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a mulh instruction, the high 32 bits of signed rs1 * signed rs2, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_mulh(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    sreg_t a = regs.get(rs1);
+    sreg_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = ((sdreg_t)a * (sdreg_t)b) >> XLEN;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "mulh");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x (a) << " * " << 
+    xlen_t::to_hex0x (b) << " = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a mulhsu instruction, the high 32 bits of signed rs1 * unsigned rs2, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_mulhsu(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    sreg_t a = regs.get(rs1);
+    sreg_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = ((sdreg_t)a * (sdreg_t)(reg_t)b) >> XLEN;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "mulhsu");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x (a) << " *SU " << 
+    xlen_t::to_hex0x (b) << " = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a mulhu instruction, the high 32 bits of unsigned rs1 * unsigned rs2, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_mulhu(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    sreg_t a = regs.get(rs1);
+    sreg_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = ((udreg_t)(reg_t)a * (udreg_t)(reg_t)b) >> XLEN;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "mulhu");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x (a) << " *U " << 
+    xlen_t::to_hex0x (b) << " = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a div instruction, signed rs1 / rs2. Divide by zero gives -1 and overflow gives rs1, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_div(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    sreg_t a = regs.get(rs1);
+    sreg_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val;
+    if(b == 0)
+        val = -1;                                   // divide by zero
+    else if(a == std::numeric_limits<sreg_t>::min() && b == -1)
+        val = a;                                    // overflow
+    else
+        val = a / b;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "div");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x (a) << " / " << 
+    xlen_t::to_hex0x (b) << " = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a divu instruction, unsigned rs1 / rs2. Divide by zero gives all ones, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_divu(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    sreg_t a = regs.get(rs1);
+    sreg_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val;
+    if(b == 0)
+        val = -1;                                   // divide by zero
+    else
+        val = (reg_t)a / (reg_t)b;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "divu");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x (a) << " /U " << 
+    xlen_t::to_hex0x (b) << " = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a rem instruction, signed rs1 % rs2. Divide by zero gives rs1 and overflow gives 0, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_rem(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    sreg_t a = regs.get(rs1);
+    sreg_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val;
+    if(b == 0)
+        val = a;                                    // divide by zero
+    else if(a == std::numeric_limits<sreg_t>::min() && b == -1)
+        val = 0;                                    // overflow
+    else
+        val = a % b;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "rem");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x (a) << " % " << 
+    xlen_t::to_hex0x (b) << " = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a remu instruction, unsigned rs1 % rs2. Divide by zero gives rs1, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_remu(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    sreg_t a = regs.get(rs1);
+    sreg_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val;
+    if(b == 0)
+        val = a;                                    // divide by zero
+    else
+        val = (reg_t)a % (reg_t)b;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "remu");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x (a) << " %U " << 
+    xlen_t::to_hex0x (b) << " = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a sh1add instruction, (rs1 << 1) + rs2, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_sh1add(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    reg_t a = regs.get(rs1);
+    reg_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = (a << 1) + b;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "sh1add");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x (a) << " << 1 + " << 
+    xlen_t::to_hex0x (b) << " = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a sh2add instruction, (rs1 << 2) + rs2, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_sh2add(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    reg_t a = regs.get(rs1);
+    reg_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = (a << 2) + b;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "sh2add");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x (a) << " << 2 + " << 
+    xlen_t::to_hex0x (b) << " = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a sh3add instruction, (rs1 << 3) + rs2, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_sh3add(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    reg_t a = regs.get(rs1);
+    reg_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = (a << 3) + b;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "sh3add");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x (a) << " << 3 + " << 
+    xlen_t::to_hex0x (b) << " = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a andn instruction, rs1 & ~rs2, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_andn(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    reg_t a = regs.get(rs1);
+    reg_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = a & ~b;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "andn");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x (a) << " & ~" << 
+    xlen_t::to_hex0x (b) << " = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a orn instruction, rs1 | ~rs2, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_orn(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    reg_t a = regs.get(rs1);
+    reg_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = a | ~b;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "orn");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x (a) << " | ~" << 
+    xlen_t::to_hex0x (b) << " = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a xnor instruction, ~(rs1 ^ rs2), adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_xnor(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    reg_t a = regs.get(rs1);
+    reg_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = ~(a ^ b);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "xnor");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x (a) << " ^~ " << 
+    xlen_t::to_hex0x (b) << " = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a min instruction, the signed minimum of rs1 and rs2, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_min(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    reg_t a = regs.get(rs1);
+    reg_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = (int32_t)a < (int32_t)b ? a : b;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "min");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x (a) << " min " << 
+    xlen_t::to_hex0x (b) << " = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a minu instruction, the unsigned minimum of rs1 and rs2, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_minu(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    reg_t a = regs.get(rs1);
+    reg_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = (a < b) ? a : b;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "minu");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x (a) << " minU " << 
+    xlen_t::to_hex0x (b) << " = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a max instruction, the signed maximum of rs1 and rs2, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_max(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    reg_t a = regs.get(rs1);
+    reg_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = (int32_t)a > (int32_t)b ? a : b;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "max");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x (a) << " max " << 
+    xlen_t::to_hex0x (b) << " = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a maxu instruction, the unsigned maximum of rs1 and rs2, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_maxu(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    reg_t a = regs.get(rs1);
+    reg_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = (a > b) ? a : b;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "maxu");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x (a) << " maxU " << 
+    xlen_t::to_hex0x (b) << " = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a rol instruction, rs1 rotated left by rs2 % XLEN, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_rol(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    reg_t a = regs.get(rs1);
+    reg_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = rotate_left(a, b % XLEN);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "rol");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x (a) << " rol " << 
+    xlen_t::to_hex0x (b) << " = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a ror instruction, rs1 rotated right by rs2 % XLEN, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_ror(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    reg_t a = regs.get(rs1);
+    reg_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = rotate_left(a, (XLEN - b % XLEN) % XLEN);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "ror");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x (a) << " ror " << 
+    xlen_t::to_hex0x (b) << " = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a one operand instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a clz instruction, the number of leading zero bits in rs1, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_clz(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    reg_t a = regs.get(rs1);
+
+    // simulates the instruction
+    sreg_t val = (a == 0) ? XLEN : __builtin_clzll(a) - (64 - XLEN);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_unary(insn, "clz");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << "clz(" << xlen_t::to_hex0x (a) << ") = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a one operand instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a ctz instruction, the number of trailing zero bits in rs1, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_ctz(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    reg_t a = regs.get(rs1);
+
+    // simulates the instruction
+    sreg_t val = (a == 0) ? XLEN : __builtin_ctzll(a);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_unary(insn, "ctz");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << "ctz(" << xlen_t::to_hex0x (a) << ") = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a one operand instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a cpop instruction, the number of set bits in rs1, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_cpop(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    reg_t a = regs.get(rs1);
+
+    // simulates the instruction
+    sreg_t val = __builtin_popcountll(a);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_unary(insn, "cpop");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << "cpop(" << xlen_t::to_hex0x (a) << ") = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a one operand instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a rev8 instruction, rs1 with its bytes reversed, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_rev8(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    reg_t a = regs.get(rs1);
+
+    // simulates the instruction
+    sreg_t val = (XLEN == 64) ? __builtin_bswap64(a) : __builtin_bswap32(a);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_unary(insn, "rev8");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << "rev8(" << xlen_t::to_hex0x (a) << ") = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a one operand instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a orc.b instruction, each byte of rs1 set to 0xff if it is not zero, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_orc_b(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    reg_t a = regs.get(rs1);
+
+    // simulates the instruction
+    reg_t t = (((a & (reg_t)0x7f7f7f7f7f7f7f7full) + (reg_t)0x7f7f7f7f7f7f7f7full) | a) & (reg_t)0x8080808080808080ull;     // high bit set in non zero bytes
+    sreg_t val = (t >> 7) * 0xff;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_unary(insn, "orc.b");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << "orc.b(" << xlen_t::to_hex0x (a) << ") = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a one operand instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a sext.b instruction, the low byte of rs1 sign extended, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_sext_b(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    reg_t a = regs.get(rs1);
+
+    // simulates the instruction
+    sreg_t val = (int8_t)a;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_unary(insn, "sext.b");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << "sext.b(" << xlen_t::to_hex0x (a) << ") = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a one operand instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a sext.h instruction, the low halfword of rs1 sign extended, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_sext_h(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    reg_t a = regs.get(rs1);
+
+    // simulates the instruction
+    sreg_t val = (int16_t)a;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_unary(insn, "sext.h");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << "sext.h(" << xlen_t::to_hex0x (a) << ") = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+* exec a one operand instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a zext.h instruction, the low halfword of rs1 zero extended, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_zext_h(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    reg_t a = regs.get(rs1);
+
+    // simulates the instruction
+    sreg_t val = (uint16_t)a;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_unary(insn, "zext.h");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << "zext.h(" << xlen_t::to_hex0x (a) << ") = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+ * exec a i type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+* @param imm_i the rotate amount
+ *
+ * @note simulates the execution of a rori instruction and adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_rori(uint32_t insn, std::ostream* pos, int32_t imm_i)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    reg_t a = regs.get(rs1);
+
+    // simulates the instruction
+    sreg_t val = rotate_left(a, (XLEN - imm_i) % XLEN);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_itype_alu(insn, "rori", imm_i);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << xlen_t::to_hex0x (a) << " ror " << 
+    std::dec << imm_i << " = " << xlen_t::to_hex0x (val);
+
+    }
+    // sets the register rd to the value
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+ * rotate a register value left
+ * @return reg_t the rotated value
+ *
+* @param val the value to rotate
+* @param shamt the number of bits to rotate by, 0 to XLEN-1
+ *
+ * @note written so the compiler turns it into a single host rotate
+ ********************************************************************************/
+rv32i_hart::reg_t rv32i_hart::rotate_left(reg_t val, uint32_t shamt)
+{
+    return (val << shamt) | (val >> ((XLEN - shamt) % XLEN));
+}
+
+/**
+* exec a ecall instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note halts the program, or with system call emulation turned on runs the
+ * call in a7 and adds 4 to PC. exit halts the program. The native routine
+ * numbers are checked first when they are turned on
+ ********************************************************************************/
+void rv32i_hart::exec_ecall(uint32_t insn , std::ostream* pos)
+{
+    if(native_ecalls && exec_native(regs.get(17), pos))
+    {
+        pc+=4;
+        return;
+    }
+
+    if(sys)
+    {
+        reg_t num = regs.get(17);
+        bool exited = sys->call(regs);
+        if(pos)
+        {
+            std::string s = render_ecall(insn);
+            *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+            *pos << "// syscall " << std::dec << num;
+            if(!exited)
+                *pos << ", a0 = " << xlen_t::to_hex0x(regs.get(10));
+        }
+        if(exited)
+        {
+            halt = true;
+            halt_reason = "exit(" + std::to_string(sys->get_exit_code()) + ")";
+            return;
+        }
+        pc+=4;
+        return;
+    }
+
+    if(pos)
+    {
+        std::string s = render_ecall(insn);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+        *pos << "// HALT";
+    }
+    halt = true;
+    halt_reason = "ECALL instruction";
+
+}
+
+/**
+* exec a ebreak instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a ebreak instruction and halts the program 
+ ********************************************************************************/
+void rv32i_hart::exec_ebreak(uint32_t insn , std::ostream* pos)
+{
+    if(pos)
+    {
+        std::string s = render_ebreak(insn);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+        *pos << "// HALT";
+    }
+    halt = true;
+    halt_reason = "EBREAK instruction";
+}
+
+/**
+ * read a CSR
+ * @return bool false if the CSR does not exist, the instruction is then illegal
+ *
+* @param csr the CSR number
+* @param val set to the value of the CSR
+ *
+ * @note every instruction takes one cycle, so cycle and instret count the
+ * instructions retired before this one. time counts microseconds since reset
+ ********************************************************************************/
+bool rv32i_hart::csr_read(uint32_t csr, reg_t &val)
+{
+    uint64_t retired = insn_counter - 1;           // tick() already counted this one
+    uint64_t usec = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - time_base).count();
+
+    switch(csr)
+    {
+        default:  return false;
+        case csr_fflags:  val = fregs.get_fflags(); return true;
+        case csr_frm:  val = fregs.get_frm(); return true;
+        case csr_fcsr:  val = fregs.get_fcsr(); return true;
+        case csr_mcycle:
+        case csr_cycle:  val = retired + cycle_offset; return true;
+        case csr_minstret:
+        case csr_instret:  val = retired + instret_offset; return true;
+        case csr_time:  val = usec; return true;
+        case csr_vl:  val = vregs.get_vl(); return true;
+        case csr_vtype:  val = vregs.get_vtype(); return true;
+        case csr_vlenb:  val = vregisterfile::vlenb; return true;
+        case csr_mhartid:  val = mhartid; return true;
+        case csr_mcycleh:
+        case csr_cycleh:  if(XLEN > 32) return false; val = (retired + cycle_offset) >> 32; return true;
+        case csr_minstreth:
+        case csr_instreth:  if(XLEN > 32) return false; val = (retired + instret_offset) >> 32; return true;
+        case csr_timeh:  if(XLEN > 32) return false; val = usec >> 32; return true;
+    }
+}
+
+/**
+ * write a CSR
+ * @return bool false if the CSR does not exist or is read-only
+ *
+* @param csr the CSR number
+* @param val the new value
+ *
+ * @note a counter written here holds that value at the next instruction and
+ * counts up from there, the writing instruction itself is not counted
+ ********************************************************************************/
+bool rv32i_hart::csr_write(uint32_t csr, reg_t val)
+{
+    switch(csr)
+    {
+        default:  return false;                     // includes the read-only 0xc00-0xfff block
+        case csr_fflags:  fregs.set_fflags(val); fp_used = true; return true;
+        case csr_frm:  fregs.set_frm(val); fp_used = true; return true;
+        case csr_fcsr:  fregs.set_fcsr(val); fp_used = true; return true;
+        case csr_mcycle:
+            if(XLEN < 64)
+                val = (((insn_counter + cycle_offset) >> 32) << 32) | (uint32_t)val;
+            cycle_offset = (uint64_t)val - insn_counter;
+            return true;
+        case csr_minstret:
+            if(XLEN < 64)
+                val = (((insn_counter + instret_offset) >> 32) << 32) | (uint32_t)val;
+            instret_offset = (uint64_t)val - insn_counter;
+            return true;
+        case csr_mcycleh:
+            if(XLEN > 32) return false;
+            cycle_offset = (((uint64_t)val << 32) | (uint32_t)(insn_counter + cycle_offset)) - insn_counter;
+            return true;
+        case csr_minstreth:
+            if(XLEN > 32) return false;
+            instret_offset = (((uint64_t)val << 32) | (uint32_t)(insn_counter + instret_offset)) - insn_counter;
+            return true;
+    }
+}
+
+/**
+* exec any of the six csr instructions
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+* @param src the value of rs1 or the zero extended uimm
+ *
+ * @note rd gets the old value of the CSR. csrrs/csrrc with rs1 (or uimm) = 0 do
+ * not write so they can read read-only CSRs, adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_csr(uint32_t insn, std::ostream* pos, reg_t src)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t funct3 = get_funct3(insn);
+    uint32_t csr = (insn >> 20) & 0xfff;
+    bool write = ((funct3 & 0x3) == funct3_csrrw) || get_rs1(insn) != 0;
+
+    // simulates the instruction
+    reg_t old = 0;
+    if(!csr_read(csr, old))
+    {
+        exec_illegal_insn(insn,pos); return;
+    }
+    reg_t val = old;
+    switch(funct3 & 0x3)
+    {
+        case funct3_csrrw:  val = src; break;
+        case funct3_csrrs:  val = old | src; break;
+        case funct3_csrrc:  val = old & ~src; break;
+    }
+    if(write && !csr_write(csr, val))
+    {
+        exec_illegal_insn(insn,pos); return;
+    }
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    static const char *mnemonics[] = { "", "csrrw", "csrrs", "csrrc", "", "csrrwi", "csrrsi", "csrrci" };
+    std::string s = (funct3 & 0x4) ? render_csrrxi(insn, mnemonics[funct3]) : render_csrrx(insn, mnemonics[funct3]);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << std::dec << old;
+    if(write)
+        *pos << ", " << hex::to_hex0x12(csr) << " = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd, old);
+    pc+=4;
+}
+
+/**
+* exec a csrrw instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note rd = csr, csr = rs1
+ ********************************************************************************/
+void rv32i_hart::exec_csrrw(uint32_t insn, std::ostream* pos)
+{
+    exec_csr(insn, pos, regs.get(get_rs1(insn)));
+}
+
+/**
+* exec a csrrs instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note rd = csr, csr |= rs1
+ ********************************************************************************/
+void rv32i_hart::exec_csrrs(uint32_t insn, std::ostream* pos)
+{
+    exec_csr(insn, pos, regs.get(get_rs1(insn)));
+}
+
+/**
+* exec a csrrc instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note rd = csr, csr &= ~rs1
+ ********************************************************************************/
+void rv32i_hart::exec_csrrc(uint32_t insn, std::ostream* pos)
+{
+    exec_csr(insn, pos, regs.get(get_rs1(insn)));
+}
+
+/**
+* exec a csrrwi instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note rd = csr, csr = uimm
+ ********************************************************************************/
+void rv32i_hart::exec_csrrwi(uint32_t insn, std::ostream* pos)
+{
+    exec_csr(insn, pos, get_rs1(insn));
+}
+
+/**
+* exec a csrrsi instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note rd = csr, csr |= uimm
+ ********************************************************************************/
+void rv32i_hart::exec_csrrsi(uint32_t insn, std::ostream* pos)
+{
+    exec_csr(insn, pos, get_rs1(insn));
+}
+
+/**
+* exec a csrrci instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note rd = csr, csr &= ~uimm
+ ********************************************************************************/
+void rv32i_hart::exec_csrrci(uint32_t insn, std::ostream* pos)
+{
+    exec_csr(insn, pos, get_rs1(insn));
+}
@@ -3,21 +3,75 @@
 #include "rv32i_decode.h"
 #include "memory.h"
 #include "registerfile.h"
+#include "fregisterfile.h"
+#include "vregisterfile.h"
+#include "cosim.h"
+#include "mem_observer.h"
+#include <chrono>
+#include <unordered_map>
+
+class syscalls;
 
 class rv32i_hart : public rv32i_decode
 {
    public:
        rv32i_hart ( memory &m) : mem(m) {}
-       void set_show_instructions (bool b) { show_instructions = b; }
-       void set_show_registers (bool b) { show_registers = b; }
+       void set_show_instructions (bool b) { detail.show_instructions = b; apply_mode(); }
+       void set_show_registers (bool b) { detail.show_registers = b; apply_mode(); }
+       void set_output (std::ostream &os) { out = &os; }
        bool is_halted () const { return halt; }
        const std::string &get_halt_reason () const { return halt_reason; }
        uint64_t get_insn_counter () const { return insn_counter; }
+       uint64_t get_pc () const { return pc; }
+       void set_pc (uint64_t val) { pc = val; }
+       uint64_t get_reg (uint32_t r) const { return (reg_t)regs.get(r); }
+       void set_reg (uint32_t r, uint64_t val) { regs.set(r, val); }
        void set_mhartid (int i) { mhartid = i; }
+       void set_syscalls (syscalls *s) { sys = s; }
+       void set_native_ecalls (bool b) { native_ecalls = b; }
+       void set_observer (mem_observer *o) { detail.observer = o; apply_mode(); }
+       void set_sampling (uint64_t fast_forward, uint64_t window, uint64_t period);
+       bool is_sampling () const { return sampling; }
+       uint64_t get_fast_insns () const { return fast_insns + (fast ? insn_counter - mode_start : 0); }
+       uint64_t get_detail_windows () const { return detail_windows; }
+       bool add_native_hook (const std::string &name, uint64_t addr);
+
+       // ecall numbers (a7) that run a library routine natively when enabled
+       static constexpr uint32_t native_ecall_base       = 0x4000;
+       static constexpr uint32_t native_ecall_memcpy     = native_ecall_base + 0;
+       static constexpr uint32_t native_ecall_memset     = native_ecall_base + 1;
+       static constexpr uint32_t native_ecall_memmove    = native_ecall_base + 2;
+       static constexpr uint32_t native_ecall_strlen     = native_ecall_base + 3;
 
       void tick ( const std::string & hdr ="");
       void dump ( const std::string & hdr ="") const;
+      bool save_registers ( const std::string &fname) const;
       void reset ();
+      void get_state ( cosim_state &st) const;
+
+      // everything a run can change in the hart, so it can be put back later
+      struct snapshot
+      {
+          registerfile regs;
+          fregisterfile fregs;
+          vregisterfile vregs;
+          uint64_t pc;
+          uint64_t insn_counter;
+          uint64_t cycle_offset;
+          uint64_t instret_offset;
+          bool halt;
+          std::string halt_reason;
+          bool fp_used;
+          bool v_used;
+      };
+      void save_snapshot ( snapshot &snap) const;
+      void restore_snapshot ( const snapshot &snap);
+
+  protected:
+      typedef xlen_t::uword_t reg_t;          ///< register values, XLEN bits
+      typedef xlen_t::sword_t sreg_t;
+      typedef xlen_t::udword_t udreg_t;       ///< 2*XLEN bits for the high multiplies
+      typedef xlen_t::sdword_t sdreg_t;
 
   private:
       static constexpr int instruction_width              = 35;
@@ -48,6 +102,25 @@ class rv32i_hart : public rv32i_decode
       void exec_sh(uint32_t, std::ostream*);
       void exec_sw(uint32_t, std::ostream*);
 
+      // RV64I only
+      void exec_ld(uint32_t, std::ostream*);
+      void exec_lwu(uint32_t, std::ostream*);
+      void exec_sd(uint32_t, std::ostream*);
+      void exec_addiw(uint32_t, std::ostream*);
+      void exec_slliw(uint32_t, std::ostream*);
+      void exec_srliw(uint32_t, std::ostream*);
+      void exec_sraiw(uint32_t, std::ostream*);
+      void exec_addw(uint32_t, std::ostream*);
+      void exec_subw(uint32_t, std::ostream*);
+      void exec_sllw(uint32_t, std::ostream*);
+      void exec_srlw(uint32_t, std::ostream*);
+      void exec_sraw(uint32_t, std::ostream*);
+      void exec_mulw(uint32_t, std::ostream*);
+      void exec_divw(uint32_t, std::ostream*);
+      void exec_divuw(uint32_t, std::ostream*);
+      void exec_remw(uint32_t, std::ostream*);
+      void exec_remuw(uint32_t, std::ostream*);
+
       void exec_addi(uint32_t, std::ostream*, int32_t);
       void exec_slti(uint32_t, std::ostream*, int32_t);
       void exec_sltiu(uint32_t, std::ostream*, int32_t);
@@ -69,6 +142,83 @@ class rv32i_hart : public rv32i_decode
       void exec_sra(uint32_t, std::ostream*);
       void exec_xor(uint32_t, std::ostream*);
 
+      void exec_mul(uint32_t, std::ostream*);
+      void exec_mulh(uint32_t, std::ostream*);
+      void exec_mulhsu(uint32_t, std::ostream*);
+      void exec_mulhu(uint32_t, std::ostream*);
+      void exec_div(uint32_t, std::ostream*);
+      void exec_divu(uint32_t, std::ostream*);
+      void exec_rem(uint32_t, std::ostream*);
+      void exec_remu(uint32_t, std::ostream*);
+
+      void exec_sh1add(uint32_t, std::ostream*);
+      void exec_sh2add(uint32_t, std::ostream*);
+      void exec_sh3add(uint32_t, std::ostream*);
+      void exec_andn(uint32_t, std::ostream*);
+      void exec_orn(uint32_t, std::ostream*);
+      void exec_xnor(uint32_t, std::ostream*);
+      void exec_min(uint32_t, std::ostream*);
+      void exec_minu(uint32_t, std::ostream*);
+      void exec_max(uint32_t, std::ostream*);
+      void exec_maxu(uint32_t, std::ostream*);
+      void exec_rol(uint32_t, std::ostream*);
+      void exec_ror(uint32_t, std::ostream*);
+      void exec_rori(uint32_t, std::ostream*, int32_t);
+      void exec_clz(uint32_t, std::ostream*);
+      void exec_ctz(uint32_t, std::ostream*);
+      void exec_cpop(uint32_t, std::ostream*);
+      void exec_rev8(uint32_t, std::ostream*);
+      void exec_orc_b(uint32_t, std::ostream*);
+      void exec_sext_b(uint32_t, std::ostream*);
+      void exec_sext_h(uint32_t, std::ostream*);
+      void exec_zext_h(uint32_t, std::ostream*);
+
+      static reg_t rotate_left(reg_t, uint32_t);
+
+      // RV32F, in rv32i_hart_fp.cpp
+      void exec_fp(uint32_t, std::ostream*);
+      uint32_t fp_rm(uint32_t) const;
+      bool fp_start(uint32_t);
+      void fp_finish();
+      void exec_flw(uint32_t, std::ostream*);
+      void exec_fsw(uint32_t, std::ostream*);
+      void exec_fmadd_s(uint32_t, std::ostream*);
+      void exec_fmsub_s(uint32_t, std::ostream*);
+      void exec_fnmsub_s(uint32_t, std::ostream*);
+      void exec_fnmadd_s(uint32_t, std::ostream*);
+      void exec_fadd_s(uint32_t, std::ostream*);
+      void exec_fsub_s(uint32_t, std::ostream*);
+      void exec_fmul_s(uint32_t, std::ostream*);
+      void exec_fdiv_s(uint32_t, std::ostream*);
+      void exec_fsqrt_s(uint32_t, std::ostream*);
+      void exec_fsgnj_s(uint32_t, std::ostream*);
+      void exec_fsgnjn_s(uint32_t, std::ostream*);
+      void exec_fsgnjx_s(uint32_t, std::ostream*);
+      void exec_fmin_s(uint32_t, std::ostream*);
+      void exec_fmax_s(uint32_t, std::ostream*);
+      void exec_fcvt_w_s(uint32_t, std::ostream*);
+      void exec_fcvt_wu_s(uint32_t, std::ostream*);
+      void exec_fcvt_s_w(uint32_t, std::ostream*);
+      void exec_fcvt_s_wu(uint32_t, std::ostream*);
+      void exec_fmv_x_w(uint32_t, std::ostream*);
+      void exec_fmv_w_x(uint32_t, std::ostream*);
+      void exec_feq_s(uint32_t, std::ostream*);
+      void exec_flt_s(uint32_t, std::ostream*);
+      void exec_fle_s(uint32_t, std::ostream*);
+      void exec_fclass_s(uint32_t, std::ostream*);
+
+      // RVV subset, in rv32i_hart_v.cpp
+      void exec_vector(uint32_t, std::ostream*);
+      bool v_check(uint32_t) const;
+      void exec_vsetvl(uint32_t, std::ostream*);
+      void exec_vle(uint32_t, std::ostream*);
+      void exec_vse(uint32_t, std::ostream*);
+      void exec_varith(uint32_t, std::ostream*);
+      void exec_vreduce(uint32_t, std::ostream*);
+
+
+      // native library routines, in rv32i_hart_native.cpp
+      bool exec_native(uint32_t, std::ostream*);
 
       void exec_ecall(uint32_t,std::ostream*);
       void exec_ebreak(uint32_t , std::ostream*);
@@ -80,20 +230,62 @@ class rv32i_hart : public rv32i_decode
       void exec_csrrwi(uint32_t, std::ostream*);
       void exec_csrrsi(uint32_t, std::ostream*);
       void exec_csrrci(uint32_t, std::ostream*);
+      void exec_csr(uint32_t, std::ostream*, reg_t);
+      void apply_mode();
+      void next_sample();
+
+      // tells the heatmap and the observer, if there is one, about a guest memory access
+      void observe(reg_t addr, uint32_t len, mem_observer::kind k) const
+      {
+          mem.touch(addr, len, k);
+          if(observer)
+              observer->access(mhartid, addr, len, k);
+      }
+
+      bool csr_read(uint32_t, reg_t &);
+      bool csr_write(uint32_t, reg_t);
 
       bool halt = { false };
       std::string halt_reason = { "none" };
  
       uint64_t insn_counter = { 0 };
-      uint32_t pc = { 0 };
+      reg_t pc = { 0 };
       uint32_t mhartid = { 0 };
+      uint64_t cycle_offset = { 0 };      ///< mcycle = insn_counter + cycle_offset
+      uint64_t instret_offset = { 0 };    ///< minstret = insn_counter + instret_offset
+      std::chrono::steady_clock::time_point time_base = { std::chrono::steady_clock::now() };
 
       bool show_instructions = { false };
       bool show_registers = { false };
+      bool fp_used = { false };           ///< only dump the f registers once F code has run
+      bool v_used = { false };            ///< only dump the v registers once V code has run
+      bool native_ecalls = { false };
+      std::unordered_map<reg_t, uint32_t> native_hooks;     ///< entry address -> native_ecall_*
+      mem_observer *observer = { nullptr };
+
+      // the tracing and models asked for, in effect only while not fast
+      struct
+      {
+          bool show_instructions;
+          bool show_registers;
+          mem_observer *observer;
+      } detail = { false, false, nullptr };
+      bool fast = { false };              ///< running with no tracing and no models
+      bool sampling = { false };
+      uint64_t sample_left = { 0 };       ///< ticks until the next switch, 0 for none
+      uint64_t sample_window = { 0 };
+      uint64_t sample_period = { 0 };
+      uint64_t mode_start = { 0 };        ///< insn_counter when fast last started
+      uint64_t fast_insns = { 0 };
+      uint64_t detail_windows = { 0 };
 
   protected:
       registerfile regs;
+      fregisterfile fregs;
+      vregisterfile vregs;
       memory& mem;
+      syscalls *sys = { nullptr };        ///< emulates Linux system calls on ecall, or halt if null
+      std::ostream *out = { &std::cout }; ///< where the trace, dumps and summary go
  };
 
 #endif
\ No newline at end of file
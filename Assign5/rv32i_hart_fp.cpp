@@ -0,0 +1,1260 @@
+#include "rv32i_hart.h"
+#include <cfenv>
+#include <cmath>
+#include <climits>
+#include <cstring>
+
+// The single precision (RV32F) part of rv32i_hart.  The arithmetic runs on the
+// host FPU with the host rounding mode set from the instruction and the host
+// exception flags folded into fflags afterwards, so this file is built with
+// -frounding-math to keep the compiler from moving FP code across those calls.
+
+static constexpr uint32_t canonical_nan = 0x7fc00000;
+
+/**
+ * test for a signaling NaN
+ * @return bool true if bits is a signaling NaN
+ *
+* @param bits the IEEE 754 bit pattern
+ ********************************************************************************/
+static bool is_snan(uint32_t bits)
+{
+    return (bits & 0x7f800000) == 0x7f800000 && (bits & 0x007fffff) && !(bits & 0x00400000);
+}
+
+/**
+ * test for any NaN
+ * @return bool true if bits is a NaN
+ *
+* @param bits the IEEE 754 bit pattern
+ ********************************************************************************/
+static bool is_nan(uint32_t bits)
+{
+    return (bits & 0x7f800000) == 0x7f800000 && (bits & 0x007fffff);
+}
+
+/**
+ * bit pattern of a host float with any NaN replaced by the canonical NaN
+ * @return uint32_t
+ *
+* @param f the host value
+ ********************************************************************************/
+static uint32_t to_bits(float f)
+{
+    if(std::isnan(f))
+        return canonical_nan;
+
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+/**
+ * The rounding mode an instruction uses
+ * @return uint32_t rm, or frm when rm is dynamic
+ *
+* @param insn the instruction needed to exec 
+ ********************************************************************************/
+uint32_t rv32i_hart::fp_rm(uint32_t insn) const
+{
+    uint32_t rm = get_funct3(insn);
+    if(rm == rm_dyn)
+        rm = fregs.get_frm();
+    return rm;
+}
+
+/**
+ * Set up the host FPU for an instruction with a rounding mode field
+ * @return bool false if the rounding mode is reserved
+ *
+* @param insn the instruction needed to exec 
+ *
+ * @note selects the host rounding mode from rm (or frm when rm is dynamic) and
+ * clears the host exception flags.  RMM has no host equivalent and uses
+ * round to nearest even, except in the float to int conversions, which round
+ * ties away themselves.
+ ********************************************************************************/
+bool rv32i_hart::fp_start(uint32_t insn)
+{
+    uint32_t rm = fp_rm(insn);
+
+    int mode;
+    switch(rm)
+    {
+        default: return false;
+        case rm_rne: mode = FE_TONEAREST; break;
+        case rm_rtz: mode = FE_TOWARDZERO; break;
+        case rm_rdn: mode = FE_DOWNWARD; break;
+        case rm_rup: mode = FE_UPWARD; break;
+        case rm_rmm: mode = FE_TONEAREST; break;    // no host mode, ties go to even, not away
+    }
+    std::fesetround(mode);
+    std::feclearexcept(FE_ALL_EXCEPT);
+    return true;
+}
+
+/**
+ * Fold the host exception flags into fflags and restore the host FPU
+ * @return void
+ ********************************************************************************/
+void rv32i_hart::fp_finish()
+{
+    int ex = std::fetestexcept(FE_ALL_EXCEPT);
+    uint32_t flags = 0;
+
+    if(ex & FE_INEXACT)
+        flags |= fregisterfile::fflags_nx;
+    if(ex & FE_UNDERFLOW)
+        flags |= fregisterfile::fflags_uf;
+    if(ex & FE_OVERFLOW)
+        flags |= fregisterfile::fflags_of;
+    if(ex & FE_DIVBYZERO)
+        flags |= fregisterfile::fflags_dz;
+    if(ex & FE_INVALID)
+        flags |= fregisterfile::fflags_nv;
+    fregs.raise_fflags(flags);
+
+    std::feclearexcept(FE_ALL_EXCEPT);
+    std::fesetround(FE_TONEAREST);
+}
+
+/**
+ * Main exec for the floating point opcodes
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note Goes through a switch to find what function is need for the instruction 
+ * to be able to execute it 
+ ********************************************************************************/
+void rv32i_hart::exec_fp(uint32_t insn, std::ostream* pos)
+{
+    uint32_t funct3 = get_funct3(insn);
+    uint32_t funct7 = get_funct7(insn);
+
+    fp_used = true;
+
+switch(get_opcode(insn))
+{
+    default:  exec_illegal_insn(insn,pos); return;
+
+    case opcode_load_fp:
+        if(funct3 == funct3_flw)
+        {
+            exec_flw(insn, pos); return;
+        }
+        exec_illegal_insn(insn,pos); return;
+
+    case opcode_store_fp:
+        if(funct3 == funct3_fsw)
+        {
+            exec_fsw(insn, pos); return;
+        }
+        exec_illegal_insn(insn,pos); return;
+
+    case opcode_fmadd:  exec_fmadd_s(insn, pos); return;
+    case opcode_fmsub:  exec_fmsub_s(insn, pos); return;
+    case opcode_fnmsub:  exec_fnmsub_s(insn, pos); return;
+    case opcode_fnmadd:  exec_fnmadd_s(insn, pos); return;
+
+    case opcode_op_fp:
+        switch(funct7)
+        {
+            default:  exec_illegal_insn(insn,pos); return;
+            case funct7_fadd_s:  exec_fadd_s(insn, pos); return;
+            case funct7_fsub_s:  exec_fsub_s(insn, pos); return;
+            case funct7_fmul_s:  exec_fmul_s(insn, pos); return;
+            case funct7_fdiv_s:  exec_fdiv_s(insn, pos); return;
+            case funct7_fsqrt_s:
+                if(get_rs2(insn) != 0)
+                {
+                    exec_illegal_insn(insn,pos); return;
+                }
+                exec_fsqrt_s(insn, pos); return;
+            case funct7_fsgnj_s:
+                switch(funct3)
+                {
+                    default:  exec_illegal_insn(insn,pos); return;
+                    case funct3_fsgnj:  exec_fsgnj_s(insn, pos); return;
+                    case funct3_fsgnjn:  exec_fsgnjn_s(insn, pos); return;
+                    case funct3_fsgnjx:  exec_fsgnjx_s(insn, pos); return;
+                }
+            case funct7_fminmax_s:
+                switch(funct3)
+                {
+                    default:  exec_illegal_insn(insn,pos); return;
+                    case funct3_fmin:  exec_fmin_s(insn, pos); return;
+                    case funct3_fmax:  exec_fmax_s(insn, pos); return;
+                }
+            case funct7_fcvt_w_s:
+                switch(get_rs2(insn))
+                {
+                    default:  exec_illegal_insn(insn,pos); return;
+                    case rs2_fcvt_w:  exec_fcvt_w_s(insn, pos); return;
+                    case rs2_fcvt_wu:  exec_fcvt_wu_s(insn, pos); return;
+                }
+            case funct7_fcvt_s_w:
+                switch(get_rs2(insn))
+                {
+                    default:  exec_illegal_insn(insn,pos); return;
+                    case rs2_fcvt_w:  exec_fcvt_s_w(insn, pos); return;
+                    case rs2_fcvt_wu:  exec_fcvt_s_wu(insn, pos); return;
+                }
+            case funct7_fmv_x_w:
+                if(get_rs2(insn) != 0)
+                {
+                    exec_illegal_insn(insn,pos); return;
+                }
+                switch(funct3)
+                {
+                    default:  exec_illegal_insn(insn,pos); return;
+                    case funct3_fmv_x_w:  exec_fmv_x_w(insn, pos); return;
+                    case funct3_fclass:  exec_fclass_s(insn, pos); return;
+                }
+            case funct7_fcmp_s:
+                switch(funct3)
+                {
+                    default:  exec_illegal_insn(insn,pos); return;
+                    case funct3_feq:  exec_feq_s(insn, pos); return;
+                    case funct3_flt:  exec_flt_s(insn, pos); return;
+                    case funct3_fle:  exec_fle_s(insn, pos); return;
+                }
+            case funct7_fmv_w_x:
+                if(get_rs2(insn) != 0 || funct3 != 0)
+                {
+                    exec_illegal_insn(insn,pos); return;
+                }
+                exec_fmv_w_x(insn, pos); return;
+        }
+}
+
+}
+
+/**
+ * exec a flw instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note loads 32 bits from memory into a floating point register and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_flw(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    int32_t imm_i = get_imm_i(insn);
+
+    // simulates the instruction
+    reg_t addr = regs.get(rs1) + imm_i;
+    uint32_t val = mem.get32(addr);
+    observe(addr, 4, mem_observer::load);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_load(insn);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_freg(rd) << " = m32(" << xlen_t::to_hex0x(regs.get(rs1)) << " + " << xlen_t::to_hex0x(imm_i)
+    << ") = " << render_float(val);
+
+    }
+    fregs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a fsw instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note stores a floating point register into 32 bits of memory and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_fsw(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    int32_t imm_s = get_imm_s(insn);
+
+    // simulates the instruction
+    reg_t addr = regs.get(rs1) + imm_s;
+    uint32_t val = fregs.get(rs2);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_store(insn);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// m32(" << xlen_t::to_hex0x(regs.get(rs1)) << " + " << xlen_t::to_hex0x(imm_s)
+    << ") = " << render_float(val);
+
+    }
+    mem.set32(addr, val);
+    observe(addr, 4, mem_observer::store);
+    pc+=4;
+}
+
+/**
+ * exec a floating point r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a fadd.s instruction on the host FPU, adds 4 to PC
+ * and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_fadd_s(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+
+    if(!fp_start(insn))
+    {
+        exec_illegal_insn(insn,pos); return;
+    }
+
+    // simulates the instruction
+    float a = fregs.get_float(rs1);
+    float b = fregs.get_float(rs2);
+    volatile float r = a + b;
+    uint32_t val = to_bits(r);
+    fp_finish();
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_rtype(insn, "fadd.s", 'f', 'f', 'f', true);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_freg(rd) << " = " << render_float(fregs.get(rs1)) << " + " << 
+    render_float(fregs.get(rs2)) << " = " << render_float(val);
+
+    }
+    fregs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a floating point r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a fsub.s instruction on the host FPU, adds 4 to PC
+ * and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_fsub_s(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+
+    if(!fp_start(insn))
+    {
+        exec_illegal_insn(insn,pos); return;
+    }
+
+    // simulates the instruction
+    float a = fregs.get_float(rs1);
+    float b = fregs.get_float(rs2);
+    volatile float r = a - b;
+    uint32_t val = to_bits(r);
+    fp_finish();
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_rtype(insn, "fsub.s", 'f', 'f', 'f', true);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_freg(rd) << " = " << render_float(fregs.get(rs1)) << " - " << 
+    render_float(fregs.get(rs2)) << " = " << render_float(val);
+
+    }
+    fregs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a floating point r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a fmul.s instruction on the host FPU, adds 4 to PC
+ * and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_fmul_s(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+
+    if(!fp_start(insn))
+    {
+        exec_illegal_insn(insn,pos); return;
+    }
+
+    // simulates the instruction
+    float a = fregs.get_float(rs1);
+    float b = fregs.get_float(rs2);
+    volatile float r = a * b;
+    uint32_t val = to_bits(r);
+    fp_finish();
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_rtype(insn, "fmul.s", 'f', 'f', 'f', true);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_freg(rd) << " = " << render_float(fregs.get(rs1)) << " * " << 
+    render_float(fregs.get(rs2)) << " = " << render_float(val);
+
+    }
+    fregs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a floating point r type instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a fdiv.s instruction on the host FPU, adds 4 to PC
+ * and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_fdiv_s(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+
+    if(!fp_start(insn))
+    {
+        exec_illegal_insn(insn,pos); return;
+    }
+
+    // simulates the instruction
+    float a = fregs.get_float(rs1);
+    float b = fregs.get_float(rs2);
+    volatile float r = a / b;
+    uint32_t val = to_bits(r);
+    fp_finish();
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_rtype(insn, "fdiv.s", 'f', 'f', 'f', true);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_freg(rd) << " = " << render_float(fregs.get(rs1)) << " / " << 
+    render_float(fregs.get(rs2)) << " = " << render_float(val);
+
+    }
+    fregs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a fsqrt.s instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a fsqrt.s instruction on the host FPU, adds 4 to PC
+ * and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_fsqrt_s(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+
+    if(!fp_start(insn))
+    {
+        exec_illegal_insn(insn,pos); return;
+    }
+
+    // simulates the instruction
+    volatile float r = std::sqrt(fregs.get_float(rs1));
+    uint32_t val = to_bits(r);
+    fp_finish();
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_rtype(insn, "fsqrt.s", 'f', 'f', 0, true);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_freg(rd) << " = sqrt(" << render_float(fregs.get(rs1)) << ") = " << render_float(val);
+
+    }
+    fregs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a fused multiply add instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a fmadd.s instruction, a * b + c with a single
+ * rounding, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_fmadd_s(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t rs3 = get_rs3(insn);
+
+    if(get_fmt(insn) != fmt_s || !fp_start(insn))
+    {
+        exec_illegal_insn(insn,pos); return;
+    }
+
+    // simulates the instruction
+    float a = fregs.get_float(rs1);
+    float b = fregs.get_float(rs2);
+    float c = fregs.get_float(rs3);
+    volatile float r = std::fmaf(a, b, c);
+    uint32_t val = to_bits(r);
+    fp_finish();
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_r4type(insn, "fmadd.s");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_freg(rd) << " = " << render_float(fregs.get(rs1)) << " * " << 
+    render_float(fregs.get(rs2)) << " + " << render_float(fregs.get(rs3)) << " = " << render_float(val);
+
+    }
+    fregs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a fused multiply add instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a fmsub.s instruction, a * b - c with a single
+ * rounding, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_fmsub_s(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t rs3 = get_rs3(insn);
+
+    if(get_fmt(insn) != fmt_s || !fp_start(insn))
+    {
+        exec_illegal_insn(insn,pos); return;
+    }
+
+    // simulates the instruction
+    float a = fregs.get_float(rs1);
+    float b = fregs.get_float(rs2);
+    float c = fregs.get_float(rs3);
+    volatile float r = std::fmaf(a, b, -c);
+    uint32_t val = to_bits(r);
+    fp_finish();
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_r4type(insn, "fmsub.s");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_freg(rd) << " = " << render_float(fregs.get(rs1)) << " * " << 
+    render_float(fregs.get(rs2)) << " - " << render_float(fregs.get(rs3)) << " = " << render_float(val);
+
+    }
+    fregs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a fused multiply add instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a fnmsub.s instruction, -(a * b) + c with a single
+ * rounding, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_fnmsub_s(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t rs3 = get_rs3(insn);
+
+    if(get_fmt(insn) != fmt_s || !fp_start(insn))
+    {
+        exec_illegal_insn(insn,pos); return;
+    }
+
+    // simulates the instruction
+    float a = fregs.get_float(rs1);
+    float b = fregs.get_float(rs2);
+    float c = fregs.get_float(rs3);
+    volatile float r = std::fmaf(-a, b, c);
+    uint32_t val = to_bits(r);
+    fp_finish();
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_r4type(insn, "fnmsub.s");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_freg(rd) << " = " << "-" << render_float(fregs.get(rs1)) << " * " << 
+    render_float(fregs.get(rs2)) << " + " << render_float(fregs.get(rs3)) << " = " << render_float(val);
+
+    }
+    fregs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a fused multiply add instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a fnmadd.s instruction, -(a * b) - c with a single
+ * rounding, adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_fnmadd_s(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t rs3 = get_rs3(insn);
+
+    if(get_fmt(insn) != fmt_s || !fp_start(insn))
+    {
+        exec_illegal_insn(insn,pos); return;
+    }
+
+    // simulates the instruction
+    float a = fregs.get_float(rs1);
+    float b = fregs.get_float(rs2);
+    float c = fregs.get_float(rs3);
+    volatile float r = std::fmaf(-a, b, -c);
+    uint32_t val = to_bits(r);
+    fp_finish();
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_r4type(insn, "fnmadd.s");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_freg(rd) << " = " << "-" << render_float(fregs.get(rs1)) << " * " << 
+    render_float(fregs.get(rs2)) << " - " << render_float(fregs.get(rs3)) << " = " << render_float(val);
+
+    }
+    fregs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a sign injection instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a fsgnj.s instruction, rs1 with the sign of rs2,
+ * adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_fsgnj_s(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t a = fregs.get(rs1);
+    uint32_t b = fregs.get(rs2);
+
+    // simulates the instruction
+    uint32_t val = (a & 0x7fffffff) | (b & 0x80000000);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_rtype(insn, "fsgnj.s", 'f', 'f', 'f', false);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_freg(rd) << " = fsgnj(" << render_float(a) << ", " << 
+    render_float(b) << ") = " << render_float(val);
+
+    }
+    fregs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a sign injection instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a fsgnjn.s instruction, rs1 with the opposite of the sign of rs2,
+ * adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_fsgnjn_s(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t a = fregs.get(rs1);
+    uint32_t b = fregs.get(rs2);
+
+    // simulates the instruction
+    uint32_t val = (a & 0x7fffffff) | (~b & 0x80000000);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_rtype(insn, "fsgnjn.s", 'f', 'f', 'f', false);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_freg(rd) << " = fsgnjn(" << render_float(a) << ", " << 
+    render_float(b) << ") = " << render_float(val);
+
+    }
+    fregs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a sign injection instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note simulates the execution of a fsgnjx.s instruction, rs1 with the sign of rs1 xor the sign of rs2,
+ * adds 4 to PC and sets the value in the register
+ ********************************************************************************/
+void rv32i_hart::exec_fsgnjx_s(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t a = fregs.get(rs1);
+    uint32_t b = fregs.get(rs2);
+
+    // simulates the instruction
+    uint32_t val = (a & 0x7fffffff) | ((a ^ b) & 0x80000000);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_rtype(insn, "fsgnjx.s", 'f', 'f', 'f', false);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_freg(rd) << " = fsgnjx(" << render_float(a) << ", " << 
+    render_float(b) << ") = " << render_float(val);
+
+    }
+    fregs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a fmin.s instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note a NaN operand gives the other operand, two NaNs give the canonical NaN,
+ * -0 is taken as less than +0 and a signaling NaN raises invalid
+ ********************************************************************************/
+void rv32i_hart::exec_fmin_s(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t a = fregs.get(rs1);
+    uint32_t b = fregs.get(rs2);
+
+    // simulates the instruction
+    uint32_t val;
+    if(is_snan(a) || is_snan(b))
+        fregs.raise_fflags(fregisterfile::fflags_nv);
+
+    if(is_nan(a) && is_nan(b))
+        val = canonical_nan;
+    else if(is_nan(a))
+        val = b;
+    else if(is_nan(b))
+        val = a;
+    else if(((a | b) & 0x7fffffff) == 0)        // +0 and -0
+        val = (a & 0x80000000) ? a : b;
+    else
+        val = (fregs.get_float(rs1) < fregs.get_float(rs2)) ? a : b;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_rtype(insn, "fmin.s", 'f', 'f', 'f', false);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_freg(rd) << " = min(" << render_float(a) << ", " << 
+    render_float(b) << ") = " << render_float(val);
+
+    }
+    fregs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a fmax.s instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note a NaN operand gives the other operand, two NaNs give the canonical NaN,
+ * -0 is taken as less than +0 and a signaling NaN raises invalid
+ ********************************************************************************/
+void rv32i_hart::exec_fmax_s(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t a = fregs.get(rs1);
+    uint32_t b = fregs.get(rs2);
+
+    // simulates the instruction
+    uint32_t val;
+    if(is_snan(a) || is_snan(b))
+        fregs.raise_fflags(fregisterfile::fflags_nv);
+
+    if(is_nan(a) && is_nan(b))
+        val = canonical_nan;
+    else if(is_nan(a))
+        val = b;
+    else if(is_nan(b))
+        val = a;
+    else if(((a | b) & 0x7fffffff) == 0)        // +0 and -0
+        val = (a & 0x80000000) ? b : a;
+    else
+        val = (fregs.get_float(rs1) > fregs.get_float(rs2)) ? a : b;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_rtype(insn, "fmax.s", 'f', 'f', 'f', false);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_freg(rd) << " = max(" << render_float(a) << ", " << 
+    render_float(b) << ") = " << render_float(val);
+
+    }
+    fregs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a fcvt.w.s instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note rounds with the instruction rounding mode and saturates out of range
+ * values and NaN, raising invalid, as the spec requires
+ ********************************************************************************/
+void rv32i_hart::exec_fcvt_w_s(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+
+    if(!fp_start(insn))
+    {
+        exec_illegal_insn(insn,pos); return;
+    }
+
+    // simulates the instruction
+    float f = fregs.get_float(rs1);
+    volatile float r = (fp_rm(insn) == rm_rmm) ? std::round(f) : std::rint(f);
+    std::feclearexcept(FE_ALL_EXCEPT);
+
+    int32_t val;
+    if(std::isnan(f) || r >= 2147483648.0f)
+    {
+        val = INT32_MAX;
+        fregs.raise_fflags(fregisterfile::fflags_nv);
+    }
+    else if(r < -2147483648.0f)
+    {
+        val = INT32_MIN;
+        fregs.raise_fflags(fregisterfile::fflags_nv);
+    }
+    else
+    {
+        val = (int32_t)r;
+        if(r != f)
+            fregs.raise_fflags(fregisterfile::fflags_nx);
+    }
+    fp_finish();
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_rtype(insn, "fcvt.w.s", 'x', 'f', 0, true);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = (int32_t)" << render_float(fregs.get(rs1)) << " = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a fcvt.wu.s instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note rounds with the instruction rounding mode and saturates out of range
+ * values and NaN, raising invalid, as the spec requires
+ ********************************************************************************/
+void rv32i_hart::exec_fcvt_wu_s(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+
+    if(!fp_start(insn))
+    {
+        exec_illegal_insn(insn,pos); return;
+    }
+
+    // simulates the instruction
+    float f = fregs.get_float(rs1);
+    volatile float r = (fp_rm(insn) == rm_rmm) ? std::round(f) : std::rint(f);
+    std::feclearexcept(FE_ALL_EXCEPT);
+
+    uint32_t val;
+    if(std::isnan(f) || r >= 4294967296.0f)
+    {
+        val = UINT32_MAX;
+        fregs.raise_fflags(fregisterfile::fflags_nv);
+    }
+    else if(r < 0.0f)
+    {
+        val = 0;
+        fregs.raise_fflags(fregisterfile::fflags_nv);
+    }
+    else
+    {
+        val = (uint32_t)r;
+        if(r != f)
+            fregs.raise_fflags(fregisterfile::fflags_nx);
+    }
+    fp_finish();
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_rtype(insn, "fcvt.wu.s", 'x', 'f', 0, true);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = (uint32_t)" << render_float(fregs.get(rs1)) << " = " << xlen_t::to_hex0x((int32_t)val);
+
+    }
+    regs.set(rd, (int32_t)val);       // RV64 sign extends the 32-bit result
+    pc+=4;
+}
+
+/**
+ * exec a fcvt.s.w instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note converts a signed integer register with the instruction rounding mode
+ ********************************************************************************/
+void rv32i_hart::exec_fcvt_s_w(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+
+    if(!fp_start(insn))
+    {
+        exec_illegal_insn(insn,pos); return;
+    }
+
+    // simulates the instruction
+    volatile int32_t x = regs.get(rs1);
+    volatile float r = (float)x;
+    uint32_t val = to_bits(r);
+    fp_finish();
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_rtype(insn, "fcvt.s.w", 'f', 'x', 0, true);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_freg(rd) << " = (float)" << xlen_t::to_hex0x(regs.get(rs1)) << " = " << render_float(val);
+
+    }
+    fregs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a fcvt.s.wu instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note converts an unsigned integer register with the instruction rounding mode
+ ********************************************************************************/
+void rv32i_hart::exec_fcvt_s_wu(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+
+    if(!fp_start(insn))
+    {
+        exec_illegal_insn(insn,pos); return;
+    }
+
+    // simulates the instruction
+    volatile uint32_t x = regs.get(rs1);
+    volatile float r = (float)x;
+    uint32_t val = to_bits(r);
+    fp_finish();
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_rtype(insn, "fcvt.s.wu", 'f', 'x', 0, true);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_freg(rd) << " = (float)" << xlen_t::to_hex0x(regs.get(rs1)) << " = " << render_float(val);
+
+    }
+    fregs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a fmv.x.w instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note copies the bits of a floating point register to an integer register
+ ********************************************************************************/
+void rv32i_hart::exec_fmv_x_w(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+
+    // simulates the instruction
+    int32_t val = fregs.get(rs1);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_rtype(insn, "fmv.x.w", 'x', 'f', 0, false);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = " << render_float(val);
+
+    }
+    regs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a fmv.w.x instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note copies the bits of an integer register to a floating point register
+ ********************************************************************************/
+void rv32i_hart::exec_fmv_w_x(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+
+    // simulates the instruction
+    uint32_t val = regs.get(rs1);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_rtype(insn, "fmv.w.x", 'f', 'x', 0, false);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_freg(rd) << " = " << render_float(val);
+
+    }
+    fregs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a fclass.s instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note sets exactly one of the 10 class bits in rd
+ ********************************************************************************/
+void rv32i_hart::exec_fclass_s(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t a = fregs.get(rs1);
+
+    // simulates the instruction
+    bool neg = a & 0x80000000;
+    uint32_t exp = (a & 0x7f800000) >> 23;
+    uint32_t sig = a & 0x007fffff;
+    int32_t val;
+
+    if(exp == 0xff && sig != 0)
+        val = (sig & 0x00400000) ? (1 << 9) : (1 << 8);        // quiet or signaling NaN
+    else if(exp == 0xff)
+        val = neg ? (1 << 0) : (1 << 7);                        // infinity
+    else if(exp == 0 && sig == 0)
+        val = neg ? (1 << 3) : (1 << 4);                        // zero
+    else if(exp == 0)
+        val = neg ? (1 << 2) : (1 << 5);                        // subnormal
+    else
+        val = neg ? (1 << 1) : (1 << 6);                        // normal
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_rtype(insn, "fclass.s", 'x', 'f', 0, false);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = class(" << render_float(a) << ") = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a feq.s instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note writes 1 to rd if rs1 == rs2 and 0 otherwise, the compare is quiet: only a signaling NaN raises invalid
+ ********************************************************************************/
+void rv32i_hart::exec_feq_s(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t a = fregs.get(rs1);
+    uint32_t b = fregs.get(rs2);
+
+    // simulates the instruction
+    if(is_snan(a) || is_snan(b))
+        fregs.raise_fflags(fregisterfile::fflags_nv);
+    int32_t val = (!is_nan(a) && !is_nan(b) && fregs.get_float(rs1) == fregs.get_float(rs2)) ? 1 : 0;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_rtype(insn, "feq.s", 'x', 'f', 'f', false);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = (" << render_float(a) << " == " << 
+    render_float(b) << ") ? 1 : 0 = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a flt.s instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note writes 1 to rd if rs1 < rs2 and 0 otherwise, the compare is signaling: any NaN raises invalid
+ ********************************************************************************/
+void rv32i_hart::exec_flt_s(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t a = fregs.get(rs1);
+    uint32_t b = fregs.get(rs2);
+
+    // simulates the instruction
+    if(is_nan(a) || is_nan(b))
+        fregs.raise_fflags(fregisterfile::fflags_nv);
+    int32_t val = (!is_nan(a) && !is_nan(b) && fregs.get_float(rs1) < fregs.get_float(rs2)) ? 1 : 0;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_rtype(insn, "flt.s", 'x', 'f', 'f', false);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = (" << render_float(a) << " < " << 
+    render_float(b) << ") ? 1 : 0 = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a fle.s instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note writes 1 to rd if rs1 <= rs2 and 0 otherwise, the compare is signaling: any NaN raises invalid
+ ********************************************************************************/
+void rv32i_hart::exec_fle_s(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t a = fregs.get(rs1);
+    uint32_t b = fregs.get(rs2);
+
+    // simulates the instruction
+    if(is_nan(a) || is_nan(b))
+        fregs.raise_fflags(fregisterfile::fflags_nv);
+    int32_t val = (!is_nan(a) && !is_nan(b) && fregs.get_float(rs1) <= fregs.get_float(rs2)) ? 1 : 0;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_fp_rtype(insn, "fle.s", 'x', 'f', 'f', false);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = (" << render_float(a) << " <= " << 
+    render_float(b) << ") ? 1 : 0 = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd, val);
+    pc+=4;
+}
@@ -0,0 +1,89 @@
+#include "rv32i_hart.h"
+
+// Guest library routines run on the memory backing store with host block
+// operations instead of interpreting their byte loops.  They are reached
+// either through a reserved ecall number in a7 or by hooking the entry
+// address of the guest's own copy, given on the command line with
+// -n name=addr, in which case the hart returns to ra as the guest routine
+// would have.
+
+/**
+ * hook a guest routine by its entry address
+ * @return bool false if the routine name is not one of the native ones
+ *
+* @param name memcpy, memset, memmove or strlen
+* @param addr the entry address of the guest routine
+ ********************************************************************************/
+bool rv32i_hart::add_native_hook(const std::string &name, uint64_t addr)
+{
+    uint32_t num;
+    if(name == "memcpy")
+        num = native_ecall_memcpy;
+    else if(name == "memset")
+        num = native_ecall_memset;
+    else if(name == "memmove")
+        num = native_ecall_memmove;
+    else if(name == "strlen")
+        num = native_ecall_strlen;
+    else
+        return false;
+
+    native_hooks[(reg_t)addr] = num;
+    return true;
+}
+
+/**
+ * run a native library routine with its arguments in a0-a2
+ * @return bool false if num is not a native routine, nothing is done then
+ *
+* @param num one of native_ecall_*
+* @param pos  ostream to be able to print   
+ *
+ * @note the result goes in a0 like the C routine returns it. The caller moves
+ * the PC on
+ ********************************************************************************/
+bool rv32i_hart::exec_native(uint32_t num, std::ostream* pos)
+{
+    reg_t a0 = regs.get(10);
+    reg_t a1 = regs.get(11);
+    reg_t a2 = regs.get(12);
+    reg_t ret = a0;
+    const char *name;
+
+    // simulates the routine
+    switch(num)
+    {
+        default:  return false;
+        case native_ecall_memcpy:                   // the guest may not rely on overlap either way
+        case native_ecall_memmove:
+            name = (num == native_ecall_memcpy) ? "memcpy" : "memmove";
+            mem.move_block(a0, a1, a2);
+            observe(a1, a2, mem_observer::load);
+            observe(a0, a2, mem_observer::store);
+            break;
+        case native_ecall_memset:
+            name = "memset";
+            mem.fill_block(a0, (uint8_t)a1, a2);
+            observe(a0, a2, mem_observer::store);
+            break;
+        case native_ecall_strlen:
+            name = "strlen";
+            ret = mem.find_byte(a0, 0);
+            observe(a0, ret + 1, mem_observer::load);
+            break;
+    }
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_mnemonic("native") + name;
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(10) << " = " << name << "(" << xlen_t::to_hex0x(a0);
+    if(num != native_ecall_strlen)
+        *pos << ", " << xlen_t::to_hex0x(a1) << ", " << xlen_t::to_hex0x(a2);
+    *pos << ") = " << xlen_t::to_hex0x(ret);
+
+    }
+    regs.set(10, ret);
+    return true;
+}
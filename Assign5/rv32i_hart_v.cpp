@@ -0,0 +1,585 @@
+#include "rv32i_hart.h"
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
+// The vector (RVV subset) part of rv32i_hart.  Element loops run one host
+// vector register (16 bytes) at a time with SSE2, or SSE4.1 where it has the
+// instruction, and whatever is left over runs through the scalar loop.  Only
+// unmasked instructions with whole register groups (LMUL 1 to 8) are supported
+// and elements past vl are left undisturbed.
+
+enum vop { vop_add, vop_sub, vop_and, vop_or, vop_xor, vop_mul, vop_min, vop_minu, vop_max, vop_maxu };
+
+/**
+ * apply a vector operation to one pair of elements
+ * @return T the result
+ *
+* @param op the operation
+* @param a the vs2 element (or the running result of a reduction)
+* @param b the vs1, rs1 or immediate element
+ ********************************************************************************/
+template <typename T>
+static T v_elem(vop op, T a, T b)
+{
+    typedef typename std::make_signed<T>::type S;
+
+    switch(op)
+    {
+        default:
+        case vop_add: return a + b;
+        case vop_sub: return a - b;
+        case vop_and: return a & b;
+        case vop_or: return a | b;
+        case vop_xor: return a ^ b;
+        case vop_mul: return (T)((uint64_t)a * (uint64_t)b);       // low SEW bits
+        case vop_min: return ((S)a < (S)b) ? a : b;
+        case vop_minu: return (a < b) ? a : b;
+        case vop_max: return ((S)a > (S)b) ? a : b;
+        case vop_maxu: return (a > b) ? a : b;
+    }
+}
+
+/**
+ * render an element value at its element width for the trace
+ * @return std::string hex with 0x prefix
+ *
+* @param x the element value
+* @param sew the element width in bits
+ ********************************************************************************/
+static std::string v_hex(uint64_t x, uint32_t sew)
+{
+    if(sew == 64)
+        return hex::to_hex0x64(x);
+    return hex::to_hex0x32(x & (0xffffffffu >> (32 - sew)));
+}
+
+#if defined(__SSE2__)
+
+/**
+ * lane-wise add and subtract for each element width
+ ********************************************************************************/
+template <typename T> static __m128i simd_add(__m128i, __m128i);
+template <> __m128i simd_add<uint8_t>(__m128i a, __m128i b) { return _mm_add_epi8(a, b); }
+template <> __m128i simd_add<uint16_t>(__m128i a, __m128i b) { return _mm_add_epi16(a, b); }
+template <> __m128i simd_add<uint32_t>(__m128i a, __m128i b) { return _mm_add_epi32(a, b); }
+template <> __m128i simd_add<uint64_t>(__m128i a, __m128i b) { return _mm_add_epi64(a, b); }
+
+template <typename T> static __m128i simd_sub(__m128i, __m128i);
+template <> __m128i simd_sub<uint8_t>(__m128i a, __m128i b) { return _mm_sub_epi8(a, b); }
+template <> __m128i simd_sub<uint16_t>(__m128i a, __m128i b) { return _mm_sub_epi16(a, b); }
+template <> __m128i simd_sub<uint32_t>(__m128i a, __m128i b) { return _mm_sub_epi32(a, b); }
+template <> __m128i simd_sub<uint64_t>(__m128i a, __m128i b) { return _mm_sub_epi64(a, b); }
+
+/**
+ * Multiply whole 16 byte blocks
+ * @return size_t the number of bytes done, 0 when the host has no multiply for
+ * this element width and everything is left to the scalar loop
+ ********************************************************************************/
+template <typename T>
+static size_t simd_mul(uint8_t *, const uint8_t *, const uint8_t *, size_t)
+{
+    return 0;
+}
+
+template <>
+size_t simd_mul<uint16_t>(uint8_t *d, const uint8_t *a, const uint8_t *b, size_t bytes)
+{
+    size_t i = 0;
+    for(; i + 16 <= bytes; i += 16)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i),
+            _mm_mullo_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                            _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i))));
+    return i;
+}
+
+#if defined(__SSE4_1__)
+template <>
+size_t simd_mul<uint32_t>(uint8_t *d, const uint8_t *a, const uint8_t *b, size_t bytes)
+{
+    size_t i = 0;
+    for(; i + 16 <= bytes; i += 16)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i),
+            _mm_mullo_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                            _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i))));
+    return i;
+}
+#endif
+
+/**
+ * Element-wise operation on whole 16 byte blocks
+ * @return size_t the number of bytes done
+ *
+* @param op the operation
+* @param d the destination elements
+* @param a the vs2 elements
+* @param b the vs1 elements or the splatted scalar
+* @param bytes the number of bytes to do
+ ********************************************************************************/
+template <typename T>
+static size_t simd_arith(vop op, uint8_t *d, const uint8_t *a, const uint8_t *b, size_t bytes)
+{
+    size_t i = 0;
+
+#define V_LOOP(expr) \
+    for(; i + 16 <= bytes; i += 16) \
+    { \
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)); \
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)); \
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), expr); \
+    }
+
+    switch(op)
+    {
+        default: break;                                 // left to the scalar loop
+        case vop_add: V_LOOP(simd_add<T>(va, vb)); break;
+        case vop_sub: V_LOOP(simd_sub<T>(va, vb)); break;
+        case vop_and: V_LOOP(_mm_and_si128(va, vb)); break;
+        case vop_or: V_LOOP(_mm_or_si128(va, vb)); break;
+        case vop_xor: V_LOOP(_mm_xor_si128(va, vb)); break;
+        case vop_mul: i = simd_mul<T>(d, a, b, bytes); break;
+    }
+#undef V_LOOP
+
+    return i;
+}
+
+/**
+ * Reduce whole 16 byte blocks into one host register and fold its lanes
+ * @return size_t the number of bytes done
+ *
+* @param op the operation, only add, and, or and xor use the host vector unit
+* @param a the vs2 elements
+* @param bytes the number of bytes to reduce
+* @param acc the running result, updated with every element done
+ ********************************************************************************/
+template <typename T>
+static size_t simd_reduce(vop op, const uint8_t *a, size_t bytes, T &acc)
+{
+    if(bytes < 16 || !(op == vop_add || op == vop_and || op == vop_or || op == vop_xor))
+        return 0;
+
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+    size_t i = 16;
+    for(; i + 16 <= bytes; i += 16)
+    {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        switch(op)
+        {
+            default:
+            case vop_add: v = simd_add<T>(v, va); break;
+            case vop_and: v = _mm_and_si128(v, va); break;
+            case vop_or: v = _mm_or_si128(v, va); break;
+            case vop_xor: v = _mm_xor_si128(v, va); break;
+        }
+    }
+
+    T lanes[16/sizeof(T)];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), v);
+    for(T lane : lanes)
+        acc = v_elem(op, acc, lane);
+    return i;
+}
+
+#else
+
+template <typename T>
+static size_t simd_arith(vop, uint8_t *, const uint8_t *, const uint8_t *, size_t)
+{
+    return 0;
+}
+
+template <typename T>
+static size_t simd_reduce(vop, const uint8_t *, size_t, T &)
+{
+    return 0;
+}
+
+#endif
+
+/**
+ * Element-wise operation on n elements
+ * @return void
+ *
+* @param op the operation
+* @param d the destination elements
+* @param a the vs2 elements
+* @param b the vs1 elements or the splatted scalar
+* @param n the number of elements (vl)
+ ********************************************************************************/
+template <typename T>
+static void v_arith(vop op, uint8_t *d, const uint8_t *a, const uint8_t *b, size_t n)
+{
+    size_t i = simd_arith<T>(op, d, a, b, n*sizeof(T)) / sizeof(T);
+
+    for(; i < n; ++i)                   // the elements the host vector unit did not do
+    {
+        T x, y;
+        std::memcpy(&x, a + i*sizeof(T), sizeof(T));
+        std::memcpy(&y, b + i*sizeof(T), sizeof(T));
+        x = v_elem(op, x, y);
+        std::memcpy(d + i*sizeof(T), &x, sizeof(T));
+    }
+}
+
+/**
+ * Reduce n elements into element 0 of the destination
+ * @return uint64_t the result, zero extended
+ *
+* @param op the operation
+* @param d the destination register
+* @param a the vs2 elements
+* @param init the vs1 register, element 0 is the starting value
+* @param n the number of elements (vl)
+ ********************************************************************************/
+template <typename T>
+static uint64_t v_reduce(vop op, uint8_t *d, const uint8_t *a, const uint8_t *init, size_t n)
+{
+    T acc;
+    std::memcpy(&acc, init, sizeof(T));
+
+    size_t i = simd_reduce<T>(op, a, n*sizeof(T), acc) / sizeof(T);
+    for(; i < n; ++i)
+    {
+        T x;
+        std::memcpy(&x, a + i*sizeof(T), sizeof(T));
+        acc = v_elem(op, acc, x);
+    }
+    std::memcpy(d, &acc, sizeof(T));
+    return acc;
+}
+
+/**
+ * Main exec for the vector arithmetic opcode
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note Goes through a switch to find what function is need for the instruction 
+ * to be able to execute it 
+ ********************************************************************************/
+void rv32i_hart::exec_vector(uint32_t insn, std::ostream* pos)
+{
+    v_used = true;
+
+    switch(get_funct3(insn))
+    {
+        default:  exec_illegal_insn(insn,pos); return;
+        case funct3_opcfg:  exec_vsetvl(insn,pos); return;
+        case funct3_opivv:
+        case funct3_opivx:
+        case funct3_opivi:
+        case funct3_opmvx:
+            exec_varith(insn,pos); return;
+        case funct3_opmvv:
+            if(get_funct6(insn) == funct6_vmul)
+            {
+                exec_varith(insn,pos); return;
+            }
+            exec_vreduce(insn,pos); return;
+    }
+}
+
+/**
+ * exec a vsetvli, vsetivli or vsetvl instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note sets vtype and vl = min(AVL, VLMAX), writes vl to rd and adds 4 to PC.
+ * An unsupported vtype sets vill and vl = 0
+ ********************************************************************************/
+void rv32i_hart::exec_vsetvl(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t vtype;
+    reg_t avl;
+
+    if((insn & 0xc0000000) == 0xc0000000)          // vsetivli
+    {
+        vtype = (insn >> 20) & 0x3ff;
+        avl = rs1;
+    }
+    else
+    {
+        if(!(insn & 0x80000000))                    // vsetvli
+            vtype = (insn >> 20) & 0x7ff;
+        else if((insn & 0xfe000000) == 0x80000000)  // vsetvl
+            vtype = ((reg_t)regs.get(get_rs2(insn)) >> 8) ? 0x100 : regs.get(get_rs2(insn));
+        else
+        {
+            exec_illegal_insn(insn,pos); return;
+        }
+
+        if(rs1 != 0)
+            avl = regs.get(rs1);
+        else if(rd != 0)
+            avl = ~(reg_t)0;                        // as many as fit
+        else
+            avl = vregs.get_vl();                   // keep vl, change vtype
+    }
+
+    // simulates the instruction
+    uint32_t vl = 0;
+    if(vregs.set_vtype(vtype))
+        vl = std::min<reg_t>(avl, vregs.get_vlmax());
+    vregs.set_vl(vl);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_vsetvl(insn);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = vl = min(" << xlen_t::to_hex0x(avl) << ", " << 
+    std::dec << (vregs.is_vill() ? 0 : vregs.get_vlmax()) << ") = " << xlen_t::to_hex0x(vl);
+
+    }
+    regs.set(rd, vl);
+    pc+=4;
+}
+
+/**
+ * check that a vector instruction can run with the current vtype
+ * @return bool false if the instruction is illegal
+ *
+* @param insn the instruction needed to exec 
+ *
+ * @note vtype must be legal and masked (vm = 0) instructions are not supported
+ ********************************************************************************/
+bool rv32i_hart::v_check(uint32_t insn) const
+{
+    return !vregs.is_vill() && get_vm(insn);
+}
+
+/**
+ * exec a unit-stride vector load
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note copies vl elements of the instruction element width from memory at rs1
+ * into the register group starting at vd and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_vle(uint32_t insn, std::ostream* pos)
+{
+    uint32_t vd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t eew = get_veew(insn);
+    uint32_t vl = vregs.get_vl();
+    uint32_t bytes = vl * eew / 8;
+
+    v_used = true;
+    if(!v_check(insn) || bytes > (32 - vd) * vregisterfile::vlenb)
+    {
+        exec_illegal_insn(insn,pos); return;
+    }
+
+    // simulates the instruction
+    reg_t addr = regs.get(rs1);
+    mem.get_block(addr, vregs.get(vd), bytes);
+    observe(addr, bytes, mem_observer::load);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_vmem(insn, "vle");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_vreg(vd) << " = m" << std::dec << eew << "[" << vl << "](" << xlen_t::to_hex0x(addr) << ")";
+
+    }
+    pc+=4;
+}
+
+/**
+ * exec a unit-stride vector store
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note copies vl elements of the instruction element width from the register
+ * group starting at vs3 to memory at rs1 and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_vse(uint32_t insn, std::ostream* pos)
+{
+    uint32_t vs3 = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t eew = get_veew(insn);
+    uint32_t vl = vregs.get_vl();
+    uint32_t bytes = vl * eew / 8;
+
+    v_used = true;
+    if(!v_check(insn) || bytes > (32 - vs3) * vregisterfile::vlenb)
+    {
+        exec_illegal_insn(insn,pos); return;
+    }
+
+    // simulates the instruction
+    reg_t addr = regs.get(rs1);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_vmem(insn, "vse");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// m" << std::dec << eew << "[" << vl << "](" << xlen_t::to_hex0x(addr) << ") = " << render_vreg(vs3);
+
+    }
+    mem.set_block(addr, vregs.get(vs3), bytes);
+    observe(addr, bytes, mem_observer::store);
+    pc+=4;
+}
+
+/**
+ * exec a vector arithmetic instruction (vadd, vsub, vand, vor, vxor, vmul)
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note .vx and .vi splat the scalar operand across a temporary register group
+ * so all three forms run the same element loop, adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_varith(uint32_t insn, std::ostream* pos)
+{
+    uint32_t funct3 = get_funct3(insn);
+    uint32_t vd = get_rd(insn);
+    uint32_t vs2 = get_rs2(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t lmul = vregs.get_lmul();
+    bool vv = (funct3 == funct3_opivv || funct3 == funct3_opmvv);
+
+    vop op;
+    const char *mnemonic;
+    const char *sym;
+    switch(get_funct6(insn))
+    {
+        default:  exec_illegal_insn(insn,pos); return;
+        case funct6_vadd:  op = vop_add; mnemonic = "vadd"; sym = "+"; break;
+        case funct6_vsub:  op = vop_sub; mnemonic = "vsub"; sym = "-"; break;
+        case funct6_vand:  op = vop_and; mnemonic = "vand"; sym = "&"; break;
+        case funct6_vor:  op = vop_or; mnemonic = "vor"; sym = "|"; break;
+        case funct6_vxor:  op = vop_xor; mnemonic = "vxor"; sym = "^"; break;
+        case funct6_vmul:  op = vop_mul; mnemonic = "vmul"; sym = "*"; break;
+    }
+    bool is_mul = (op == vop_mul);
+    bool is_opm = (funct3 == funct3_opmvv || funct3 == funct3_opmvx);
+    if(is_mul != is_opm || (op == vop_sub && funct3 == funct3_opivi)
+        || !v_check(insn) || vd % lmul || vs2 % lmul || (vv && rs1 % lmul))
+    {
+        exec_illegal_insn(insn,pos); return;
+    }
+
+    // simulates the instruction
+    uint32_t sew = vregs.get_sew();
+    uint32_t vl = vregs.get_vl();
+    uint8_t splat[8*vregisterfile::vlenb];
+    const uint8_t *b = vregs.get(rs1);
+    uint64_t x = 0;
+    if(!vv)
+    {
+        x = (funct3 == funct3_opivi) ? (int64_t)(((int32_t)(rs1 << 27)) >> 27) : (int64_t)regs.get(rs1);
+        for(uint32_t i = 0; i < vl * sew / 8; ++i)
+            splat[i] = x >> (8 * (i % (sew / 8)));
+        b = splat;
+    }
+
+    switch(sew)
+    {
+        case 8:  v_arith<uint8_t>(op, vregs.get(vd), vregs.get(vs2), b, vl); break;
+        case 16:  v_arith<uint16_t>(op, vregs.get(vd), vregs.get(vs2), b, vl); break;
+        case 32:  v_arith<uint32_t>(op, vregs.get(vd), vregs.get(vs2), b, vl); break;
+        case 64:  v_arith<uint64_t>(op, vregs.get(vd), vregs.get(vs2), b, vl); break;
+    }
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_vop(insn, mnemonic);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_vreg(vd) << " = " << render_vreg(vs2) << " " << sym << " ";
+    if(vv)
+        *pos << render_vreg(rs1);
+    else
+        *pos << v_hex(x, sew);
+    *pos << ", vl = " << std::dec << vl;
+
+    }
+    pc+=4;
+}
+
+/**
+ * exec a vector reduction instruction (vredsum, vredand, vredor, vredxor,
+ * vredmin, vredminu, vredmax, vredmaxu)
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note vd[0] = op(vs1[0], vs2[0], ..., vs2[vl-1]), the rest of vd is left alone
+ * and nothing is written when vl is 0, adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_vreduce(uint32_t insn, std::ostream* pos)
+{
+    uint32_t vd = get_rd(insn);
+    uint32_t vs2 = get_rs2(insn);
+    uint32_t vs1 = get_rs1(insn);
+
+    vop op;
+    const char *mnemonic;
+    switch(get_funct6(insn))
+    {
+        default:  exec_illegal_insn(insn,pos); return;
+        case funct6_vredsum:  op = vop_add; mnemonic = "vredsum"; break;
+        case funct6_vredand:  op = vop_and; mnemonic = "vredand"; break;
+        case funct6_vredor:  op = vop_or; mnemonic = "vredor"; break;
+        case funct6_vredxor:  op = vop_xor; mnemonic = "vredxor"; break;
+        case funct6_vredminu:  op = vop_minu; mnemonic = "vredminu"; break;
+        case funct6_vredmin:  op = vop_min; mnemonic = "vredmin"; break;
+        case funct6_vredmaxu:  op = vop_maxu; mnemonic = "vredmaxu"; break;
+        case funct6_vredmax:  op = vop_max; mnemonic = "vredmax"; break;
+    }
+    if(!v_check(insn) || vs2 % vregs.get_lmul())
+    {
+        exec_illegal_insn(insn,pos); return;
+    }
+
+    // simulates the instruction
+    uint32_t sew = vregs.get_sew();
+    uint32_t vl = vregs.get_vl();
+    uint64_t init = 0;
+    std::memcpy(&init, vregs.get(vs1), sew / 8);
+    uint64_t val = 0;
+    if(vl != 0)
+    {
+        switch(sew)
+        {
+            case 8:  val = v_reduce<uint8_t>(op, vregs.get(vd), vregs.get(vs2), vregs.get(vs1), vl); break;
+            case 16:  val = v_reduce<uint16_t>(op, vregs.get(vd), vregs.get(vs2), vregs.get(vs1), vl); break;
+            case 32:  val = v_reduce<uint32_t>(op, vregs.get(vd), vregs.get(vs2), vregs.get(vs1), vl); break;
+            case 64:  val = v_reduce<uint64_t>(op, vregs.get(vd), vregs.get(vs2), vregs.get(vs1), vl); break;
+        }
+    }
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_vop(insn, mnemonic);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_vreg(vd) << "[0] = " << (mnemonic + 1) << "(" << v_hex(init, sew) << ", " << 
+    render_vreg(vs2) << ") = " << v_hex(val, sew) << ", vl = " << std::dec << vl;
+
+    }
+    pc+=4;
+}
@@ -0,0 +1,42 @@
+#include "rv32i_predecode.h"
+
+/**
+ * Predecode a region of simulated memory
+ *
+ * @param mem the memory to read the instructions from
+ * @param addr the address of the first instruction
+ * @param len the number of bytes to predecode
+ * @return void
+ *
+ * @note the region is clipped to the end of memory and rounded down to whole words
+ ********************************************************************************/
+void rv32i_predecode::predecode_region(const memory &mem, uint32_t addr, uint32_t len)
+{
+    if(addr >= mem.get_size())
+    {
+        insn.clear();
+        return;
+    }
+
+    if(len > mem.get_size() - addr)         // clip to the end of memory
+        len = mem.get_size() - addr;
+
+    predecode_words(mem.get_data() + addr, len / 4);
+}
+
+/**
+ * Predecode count little-endian instruction words
+ *
+ * @param src pointer to the first byte of the first instruction
+ * @param count the number of instruction words
+ * @return void
+ ********************************************************************************/
+void rv32i_predecode::predecode_words(const uint8_t *src, size_t count)
+{
+    insn.resize(count);
+    for(size_t i = 0; i < count; ++i)
+    {
+        const uint8_t *p = src + i*4;       // assemble in little-endian order
+        insn[i] = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+}
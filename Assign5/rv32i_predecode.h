@@ -0,0 +1,26 @@
+#ifndef RV32I_PREDECODE_H
+#define RV32I_PREDECODE_H
+
+#include <vector>
+#include <cstdint>
+#include "memory.h"
+
+// Reads a region of instruction words out of memory in one pass for the bulk
+// disassembler.  The words are all it keeps: decode() and the hart's exec()
+// take the raw word and pull out the fields they need, so there is nothing
+// that could use fields split out ahead of time.
+class rv32i_predecode
+{
+public:
+    void predecode_region(const memory &, uint32_t, uint32_t);
+    void predecode_words(const uint8_t *, size_t);
+
+    size_t size() const { return insn.size(); }
+
+    const std::vector<uint32_t> &get_insns() const { return insn; }
+
+private:
+    std::vector<uint32_t> insn;
+};
+
+#endif
@@ -0,0 +1,333 @@
+#include "rv32i_translate.h"
+#include <vector>
+
+/**
+ * register operand as a C++ expression
+ * @return std::string x[r], or 0u for x0
+ ********************************************************************************/
+static std::string X(uint32_t r)
+{
+    return r == 0 ? std::string("0u") : "x[" + std::to_string(r) + "]";
+}
+
+/**
+ * 32-bit constant as a C++ expression
+ * @return std::string 0x........u
+ ********************************************************************************/
+static std::string K(uint32_t v)
+{
+    return hex::to_hex0x32(v) + "u";
+}
+
+/**
+ * Find the basic blocks reachable from entry
+ *
+ * @param entry the address execution starts at
+ * @return void
+ *
+ * @note follows branch and jal targets and fall-through paths. The address after
+ * every call (jal/jalr with rd != x0) and after every instruction left to the
+ * interpreter also starts a block, so returns and resumes stay translated.
+ * Targets only known at run time (jalr) are not followed, and neither is
+ * anything after an ecall, an ebreak or an illegal instruction, which may be data
+ ********************************************************************************/
+void rv32i_translate::discover(uint32_t entry)
+{
+    this->entry = entry;
+    std::vector<uint32_t> work = { entry };
+
+    while(!work.empty())
+    {
+        uint32_t start = work.back();
+        work.pop_back();
+        if((start & 3) || start >= mem.get_size() || !blocks.insert(start).second)
+            continue;
+
+        for(uint32_t addr = start; addr + 4 <= mem.get_size(); addr += 4)
+        {
+            uint32_t insn = mem.get32(addr);
+            std::ostringstream discard;
+            bool ends = false;
+            if(!translate(addr, insn, discard, ends))
+            {
+                if(insn != insn_ecall && insn != insn_ebreak && decode(addr, insn) != render_illegal_insn(insn))
+                    work.push_back(addr + 4);       // after the interpreter runs it
+                break;
+            }
+            if(!ends)
+                continue;
+
+            switch(get_opcode(insn))
+            {
+                case opcode_btype:
+                    work.push_back(addr + get_imm_b(insn));
+                    work.push_back(addr + 4);
+                    break;
+                case opcode_jal:
+                    work.push_back(addr + get_imm_j(insn));
+                    if(get_rd(insn) != 0)
+                        work.push_back(addr + 4);
+                    break;
+                case opcode_jalr:
+                    if(get_rd(insn) != 0)
+                        work.push_back(addr + 4);
+                    break;
+            }
+            break;
+        }
+    }
+}
+
+/**
+ * Write the translated program as a C++ source file
+ *
+ * @param os where to write it
+ * @param source the name of the image, for the header comment
+ * @return void
+ *
+ * @note emits the memory image, one function per block and aot_lookup(), which
+ * maps a block address to its function. Link it with aotrt.a
+ ********************************************************************************/
+void rv32i_translate::emit(std::ostream &os, const std::string &source)
+{
+    os << "// translated from " << source << " by rv32aot, do not edit" << std::endl;
+    os << "#include \"aot_runtime.h\"" << std::endl << std::endl;
+
+    os << "const uint32_t aot_entry = " << K(entry) << ";" << std::endl;
+    os << "const uint32_t aot_mem_size = " << K(mem.get_size()) << ";" << std::endl;
+    os << "const uint32_t aot_image_size = " << K(image_size) << ";" << std::endl;
+    os << "const uint8_t aot_image[] = {";
+    const uint8_t *data = mem.get_data();
+    for(uint32_t i = 0; i < image_size; ++i)
+        os << (i % 16 ? " " : "\n    ") << "0x" << hex::to_hex8(data[i]) << ",";
+    os << "\n    0x00\n};" << std::endl << std::endl;
+
+    emitted.clear();
+    for(uint32_t start : blocks)
+        if(emit_block(start, os))
+            emitted.push_back(start);
+
+    os << "aot_block_fn aot_lookup(uint32_t pc)" << std::endl;
+    os << "{" << std::endl;
+    os << "    switch(pc)" << std::endl;
+    os << "    {" << std::endl;
+    for(uint32_t start : emitted)
+        os << "        case " << K(start) << ": return b_" << hex::to_hex32(start) << ";" << std::endl;
+    os << "        default: return nullptr;" << std::endl;
+    os << "    }" << std::endl;
+    os << "}" << std::endl;
+}
+
+/**
+ * Write the function for the block starting at start
+ *
+ * @param start the block address
+ * @param os where to write it
+ * @return bool false if the first instruction is not translatable, nothing is
+ * written and the interpreter runs the block
+ ********************************************************************************/
+bool rv32i_translate::emit_block(uint32_t start, std::ostream &os) const
+{
+    std::ostringstream body;
+    uint32_t count = 0;
+    uint32_t addr = start;
+    bool ends = false;
+
+    for(; addr + 4 <= mem.get_size() && !ends; addr += 4)
+    {
+        uint32_t insn = mem.get32(addr);
+        std::ostringstream code;
+        if(!translate(addr, insn, code, ends))
+            break;
+        ++count;
+        body << "    " << code.str() << std::string(code.str().size() < 56 ? 56 - code.str().size() : 1, ' ')
+             << "// " << hex::to_hex32(addr) << ": " << decode(addr, insn) << std::endl;
+    }
+    if(count == 0)
+        return false;
+
+    os << "static uint32_t b_" << hex::to_hex32(start) << "(aot_state &s)" << std::endl;
+    os << "{" << std::endl;
+    os << "    uint32_t *x = s.x;" << std::endl;
+    os << "    (void)x;" << std::endl;
+    os << "    s.insns += " << count << ";" << std::endl;
+    os << body.str();
+    if(!ends)
+        os << "    return " << K(addr) << ";" << std::endl;
+    os << "}" << std::endl << std::endl;
+    return true;
+}
+
+/**
+ * Translate one instruction into a C++ statement
+ *
+ * @param addr the address of the instruction
+ * @param insn the instruction
+ * @param os where to write the statement
+ * @param ends set when the instruction ends the block (it returns the next pc)
+ * @return bool false if the instruction is left to the interpreter
+ *
+ * @note covers RV32I and RV32M. System, CSR, F, V and the bit-manipulation
+ * instructions are left to the interpreter
+ ********************************************************************************/
+bool rv32i_translate::translate(uint32_t addr, uint32_t insn, std::ostream &os, bool &ends) const
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t funct3 = get_funct3(insn);
+    std::string dst = "x[" + std::to_string(rd) + "] = ";
+
+    ends = false;
+    switch(get_opcode(insn))
+    {
+        default:  return false;
+
+        case opcode_lui:
+            if(rd)
+                os << dst << K(get_imm_u(insn)) << ";";
+            return true;
+
+        case opcode_auipc:
+            if(rd)
+                os << dst << K(addr + get_imm_u(insn)) << ";";
+            return true;
+
+        case opcode_jal:
+            if(rd)
+                os << dst << K(addr + 4) << "; ";
+            os << "return " << K(addr + get_imm_j(insn)) << ";";
+            ends = true;
+            return true;
+
+        case opcode_jalr:
+            if(funct3 != 0)
+                return false;
+            os << "{ uint32_t t = (" << X(rs1) << " + " << K(get_imm_i(insn)) << ") & ~1u; ";
+            if(rd)
+                os << dst << K(addr + 4) << "; ";
+            os << "return t; }";
+            ends = true;
+            return true;
+
+        case opcode_btype:
+        {
+            std::string a = X(rs1), b = X(rs2), cond;
+            switch(funct3)
+            {
+                default:  return false;
+                case funct3_beq:  cond = a + " == " + b; break;
+                case funct3_bne:  cond = a + " != " + b; break;
+                case funct3_blt:  cond = "(int32_t)" + a + " < (int32_t)" + b; break;
+                case funct3_bge:  cond = "(int32_t)" + a + " >= (int32_t)" + b; break;
+                case funct3_bltu:  cond = a + " < " + b; break;
+                case funct3_bgeu:  cond = a + " >= " + b; break;
+            }
+            os << "if(" << cond << ") return " << K(addr + get_imm_b(insn)) << "; return " << K(addr + 4) << ";";
+            ends = true;
+            return true;
+        }
+
+        case opcode_load_imm:
+        {
+            std::string ea = X(rs1) + " + " + K(get_imm_i(insn));
+            std::string val;
+            switch(funct3)
+            {
+                default:  return false;
+                case funct3_lb:  val = "(uint32_t)(int8_t)aot_ld8(s, " + ea + ")"; break;
+                case funct3_lh:  val = "(uint32_t)(int16_t)aot_ld16(s, " + ea + ")"; break;
+                case funct3_lw:  val = "aot_ld32(s, " + ea + ")"; break;
+                case funct3_lbu:  val = "aot_ld8(s, " + ea + ")"; break;
+                case funct3_lhu:  val = "aot_ld16(s, " + ea + ")"; break;
+            }
+            if(rd)
+                os << dst << val << ";";
+            else
+                os << "(void)" << val << ";";       // keep the out of range warning
+            return true;
+        }
+
+        case opcode_stype:
+        {
+            std::string ea = X(rs1) + " + " + K(get_imm_s(insn));
+            switch(funct3)
+            {
+                default:  return false;
+                case funct3_sb:  os << "aot_st8(s, " << ea << ", " << X(rs2) << ");"; break;
+                case funct3_sh:  os << "aot_st16(s, " << ea << ", " << X(rs2) << ");"; break;
+                case funct3_sw:  os << "aot_st32(s, " << ea << ", " << X(rs2) << ");"; break;
+            }
+            return true;
+        }
+
+        case opcode_alu_imm:
+            return translate_alu(insn, true, os);
+        case opcode_rtype:
+            return translate_alu(insn, false, os);
+
+        case opcode_fence:
+            return funct3 == 0;                     // one hart, nothing to order
+    }
+}
+
+/**
+ * Translate an ALU instruction, register-immediate or register-register
+ *
+ * @param insn the instruction
+ * @param imm true for the opcode_alu_imm forms
+ * @param os where to write the statement
+ * @return bool false if the instruction is left to the interpreter
+ ********************************************************************************/
+bool rv32i_translate::translate_alu(uint32_t insn, bool imm, std::ostream &os) const
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t funct3 = get_funct3(insn);
+    uint32_t funct7 = get_funct7(insn);
+    std::string a = X(get_rs1(insn));
+    std::string b = imm ? K(get_imm_i(insn)) : X(get_rs2(insn));
+    std::string sh = imm ? std::to_string(get_rs2(insn)) : "(" + b + " & 31)";
+    std::string val;
+
+    if(!imm && funct7 == funct7_muldiv)
+    {
+        switch(funct3)
+        {
+            case funct3_mul:  val = a + " * " + b; break;
+            case funct3_mulh:  val = "(uint32_t)(((int64_t)(int32_t)" + a + " * (int64_t)(int32_t)" + b + ") >> 32)"; break;
+            case funct3_mulhsu:  val = "(uint32_t)(((int64_t)(int32_t)" + a + " * (int64_t)" + b + ") >> 32)"; break;
+            case funct3_mulhu:  val = "(uint32_t)(((uint64_t)" + a + " * " + b + ") >> 32)"; break;
+            case funct3_div:  val = "aot_div(" + a + ", " + b + ")"; break;
+            case funct3_divu:  val = "aot_divu(" + a + ", " + b + ")"; break;
+            case funct3_rem:  val = "aot_rem(" + a + ", " + b + ")"; break;
+            case funct3_remu:  val = "aot_remu(" + a + ", " + b + ")"; break;
+        }
+    }
+    else
+    {
+        bool alt = false;                           // sub, sra and srai
+        if(funct3 == funct3_srx || funct3 == funct3_sll || !imm)
+        {
+            if(funct7 == funct7_sub && (funct3 == funct3_srx || (!imm && funct3 == funct3_add)))
+                alt = true;
+            else if(funct7 != 0)
+                return false;                       // Zb* and the like
+        }
+
+        switch(funct3)
+        {
+            case funct3_add:  val = a + (alt ? " - " : " + ") + b; break;
+            case funct3_sll:  val = a + " << " + sh; break;
+            case funct3_slt:  val = "(uint32_t)((int32_t)" + a + " < (int32_t)" + b + ")"; break;
+            case funct3_sltu:  val = "(uint32_t)(" + a + " < " + b + ")"; break;
+            case funct3_xor:  val = a + " ^ " + b; break;
+            case funct3_srx:  val = alt ? "(uint32_t)((int32_t)" + a + " >> " + sh + ")" : a + " >> " + sh; break;
+            case funct3_or:  val = a + " | " + b; break;
+            case funct3_and:  val = a + " & " + b; break;
+        }
+    }
+
+    if(rd)
+        os << "x[" << rd << "] = " << val << ";";
+    return true;
+}
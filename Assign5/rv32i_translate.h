@@ -0,0 +1,35 @@
+#ifndef RV32I_TRANSLATE_H
+#define RV32I_TRANSLATE_H
+
+#include <set>
+#include <vector>
+#include <string>
+#include <iostream>
+#include "rv32i_decode.h"
+#include "memory.h"
+
+class rv32i_translate : public rv32i_decode
+{
+public:
+    rv32i_translate(const memory &m, uint32_t image_size) : mem(m), image_size(image_size) {}
+
+    void discover(uint32_t entry);
+    void emit(std::ostream &os, const std::string &source);
+
+    size_t get_block_count() const { return emitted.size(); }
+
+private:
+    static constexpr uint32_t opcode_fence          = 0b0001111;
+
+    bool translate(uint32_t addr, uint32_t insn, std::ostream &os, bool &ends) const;
+    bool translate_alu(uint32_t insn, bool imm, std::ostream &os) const;
+    bool emit_block(uint32_t start, std::ostream &os) const;
+
+    const memory &mem;
+    uint32_t image_size;
+    uint32_t entry = { 0 };
+    std::set<uint32_t> blocks;              ///< block entry addresses
+    std::vector<uint32_t> emitted;          ///< the blocks emit() translated
+};
+
+#endif
@@ -0,0 +1,583 @@
+#include "rv32i_hart.h"
+#include <climits>
+
+// The RV64I (and RV64M) instructions that only exist when the simulator is
+// built with RV_XLEN=64.  The W forms work on the low 32 bits and sign extend
+// the 32-bit result to XLEN bits.  In an RV32I build exec() never calls these.
+
+/**
+ * exec a ld instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note loads 64 bits from memory into rd and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_ld(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    int32_t imm_i = get_imm_i(insn);
+
+    // simulates the instruction
+    reg_t addr = regs.get(rs1) + imm_i;
+    sreg_t val = mem.get64(addr);
+    observe(addr, 8, mem_observer::load);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_itype_load(insn,"ld");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = m64(" << xlen_t::to_hex0x(regs.get(rs1)) << " + " << xlen_t::to_hex0x(imm_i)
+    << ") = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a lwu instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note loads 32 bits from memory, zero extended, into rd and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_lwu(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    int32_t imm_i = get_imm_i(insn);
+
+    // simulates the instruction
+    reg_t addr = regs.get(rs1) + imm_i;
+    sreg_t val = mem.get32(addr);
+    observe(addr, 4, mem_observer::load);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_itype_load(insn,"lwu");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = zx(m32(" << xlen_t::to_hex0x(regs.get(rs1)) << " + " << xlen_t::to_hex0x(imm_i)
+    << ")) = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a sd instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note stores all 64 bits of rs2 in memory and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_sd(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    int32_t imm_s = get_imm_s(insn);
+
+    // simulates the instruction
+    reg_t addr = regs.get(rs1) + imm_s;
+    reg_t val = regs.get(rs2);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_stype(insn, "sd");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// m64(" << xlen_t::to_hex0x(regs.get(rs1)) << " + " << xlen_t::to_hex0x(imm_s)
+    << ") = " << xlen_t::to_hex0x(val);
+
+    }
+    mem.set64(addr, val);
+    observe(addr, 8, mem_observer::store);
+    pc+=4;
+}
+
+/**
+ * exec a addiw instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note adds the immediate to the low 32 bits of rs1, sign extends the sum and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_addiw(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    int32_t imm_i = get_imm_i(insn);
+
+    // simulates the instruction
+    sreg_t val = (int32_t)((uint32_t)regs.get(rs1) + (uint32_t)imm_i);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_itype_alu(insn, "addiw", imm_i);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = sx(" << xlen_t::to_hex0x(regs.get(rs1)) << " + " << 
+    xlen_t::to_hex0x(imm_i) << ") = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a slliw instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note shifts the low 32 bits of rs1 left, sign extends the result and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_slliw(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t shamt = get_imm_i(insn) & 0x1f;
+
+    // simulates the instruction
+    sreg_t val = (int32_t)((uint32_t)regs.get(rs1) << shamt);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_itype_alu(insn, "slliw", shamt);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = sx(" << xlen_t::to_hex0x(regs.get(rs1)) << " << " << 
+    std::dec << shamt << ") = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a srliw instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note shifts the low 32 bits of rs1 right logically, sign extends the result and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_srliw(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t shamt = get_imm_i(insn) & 0x1f;
+
+    // simulates the instruction
+    sreg_t val = (int32_t)((uint32_t)regs.get(rs1) >> shamt);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_itype_alu(insn, "srliw", shamt);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = sx(" << xlen_t::to_hex0x(regs.get(rs1)) << " >> " << 
+    std::dec << shamt << ") = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a sraiw instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note shifts the low 32 bits of rs1 right arithmetically, sign extends the result and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_sraiw(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t shamt = get_imm_i(insn) & 0x1f;
+
+    // simulates the instruction
+    sreg_t val = (int32_t)((int32_t)regs.get(rs1) >> shamt);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_itype_alu(insn, "sraiw", shamt);
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = sx(" << xlen_t::to_hex0x(regs.get(rs1)) << " >> " << 
+    std::dec << shamt << ") = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd, val);
+    pc+=4;
+}
+
+/**
+ * exec a addw instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note adds the low 32 bits of rs1 and rs2, sign extends the 32-bit result and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_addw(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t a = regs.get(rs1);
+    uint32_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = (int32_t)(a + b);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "addw");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = sx(" << hex::to_hex0x32(a) << " + " << 
+    hex::to_hex0x32(b) << ") = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+ * exec a subw instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note subtracts the low 32 bits of rs2 from rs1, sign extends the 32-bit result and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_subw(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t a = regs.get(rs1);
+    uint32_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = (int32_t)(a - b);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "subw");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = sx(" << hex::to_hex0x32(a) << " - " << 
+    hex::to_hex0x32(b) << ") = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+ * exec a sllw instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note shifts the low 32 bits of rs1 left by rs2 % 32, sign extends the 32-bit result and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_sllw(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t a = regs.get(rs1);
+    uint32_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = (int32_t)(a << (b & 0x1f));
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "sllw");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = sx(" << hex::to_hex0x32(a) << " << " << 
+    hex::to_hex0x32(b) << ") = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+ * exec a srlw instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note shifts the low 32 bits of rs1 right logically by rs2 % 32, sign extends the 32-bit result and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_srlw(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t a = regs.get(rs1);
+    uint32_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = (int32_t)(a >> (b & 0x1f));
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "srlw");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = sx(" << hex::to_hex0x32(a) << " >> " << 
+    hex::to_hex0x32(b) << ") = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+ * exec a sraw instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note shifts the low 32 bits of rs1 right arithmetically by rs2 % 32, sign extends the 32-bit result and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_sraw(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t a = regs.get(rs1);
+    uint32_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = (int32_t)((uint32_t)((int32_t)a >> (b & 0x1f)));
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "sraw");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = sx(" << hex::to_hex0x32(a) << " >> " << 
+    hex::to_hex0x32(b) << ") = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+ * exec a mulw instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note multiplies the low 32 bits of rs1 and rs2, sign extends the 32-bit result and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_mulw(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t a = regs.get(rs1);
+    uint32_t b = regs.get(rs2);
+
+    // simulates the instruction
+    sreg_t val = (int32_t)(a * b);
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "mulw");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = sx(" << hex::to_hex0x32(a) << " * " << 
+    hex::to_hex0x32(b) << ") = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+ * exec a divw instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note signed 32-bit rs1 / rs2. Divide by zero gives -1 and overflow gives rs1, sign extends the 32-bit result and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_divw(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t a = regs.get(rs1);
+    uint32_t b = regs.get(rs2);
+
+    // simulates the instruction
+    int32_t val32;
+    if((int32_t)b == 0)
+        val32 = -1;                                 // divide by zero
+    else if((int32_t)a == INT32_MIN && (int32_t)b == -1)
+        val32 = a;                                  // overflow
+    else
+        val32 = (int32_t)a / (int32_t)b;
+    sreg_t val = val32;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "divw");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = sx(" << hex::to_hex0x32(a) << " / " << 
+    hex::to_hex0x32(b) << ") = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+ * exec a divuw instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note unsigned 32-bit rs1 / rs2. Divide by zero gives all ones, sign extends the 32-bit result and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_divuw(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t a = regs.get(rs1);
+    uint32_t b = regs.get(rs2);
+
+    // simulates the instruction
+    uint32_t val32;
+    if(b == 0)
+        val32 = UINT32_MAX;                         // divide by zero
+    else
+        val32 = a / b;
+    sreg_t val = (int32_t)val32;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "divuw");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = sx(" << hex::to_hex0x32(a) << " /U " << 
+    hex::to_hex0x32(b) << ") = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+ * exec a remw instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note signed 32-bit rs1 % rs2. Divide by zero gives rs1 and overflow gives 0, sign extends the 32-bit result and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_remw(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t a = regs.get(rs1);
+    uint32_t b = regs.get(rs2);
+
+    // simulates the instruction
+    int32_t val32;
+    if((int32_t)b == 0)
+        val32 = a;                                  // divide by zero
+    else if((int32_t)a == INT32_MIN && (int32_t)b == -1)
+        val32 = 0;                                  // overflow
+    else
+        val32 = (int32_t)a % (int32_t)b;
+    sreg_t val = val32;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "remw");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = sx(" << hex::to_hex0x32(a) << " % " << 
+    hex::to_hex0x32(b) << ") = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd,val);
+    pc+=4;
+}
+
+/**
+ * exec a remuw instruction
+ * @return void
+ *
+* @param insn the instruction needed to exec 
+* @param pos  ostream to be able to print   
+ *
+ * @note unsigned 32-bit rs1 % rs2. Divide by zero gives rs1, sign extends the 32-bit result and adds 4 to PC
+ ********************************************************************************/
+void rv32i_hart::exec_remuw(uint32_t insn, std::ostream* pos)
+{
+    uint32_t rd = get_rd(insn);
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t a = regs.get(rs1);
+    uint32_t b = regs.get(rs2);
+
+    // simulates the instruction
+    uint32_t val32;
+    if(b == 0)
+        val32 = a;                                  // divide by zero
+    else
+        val32 = a % b;
+    sreg_t val = (int32_t)val32;
+
+   // adds the rendered values plus a commented version of it to be printed
+    if ( pos )
+    {
+    std::string s = render_rtype(insn, "remuw");
+    *pos << std :: setw (instruction_width) << std :: setfill (' ') << std :: left << s;
+    *pos << "// " << render_reg(rd) << " = sx(" << hex::to_hex0x32(a) << " %U " << 
+    hex::to_hex0x32(b) << ") = " << xlen_t::to_hex0x(val);
+
+    }
+    regs.set(rd,val);
+    pc+=4;
+}
@@ -0,0 +1,615 @@
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <getopt.h>
+#include <sys/resource.h>
+#include "memory.h"
+#include "rv32i_asm.h"
+#include "cpu_single_hart.h"
+
+// Runs a fixed set of guest programs through cpu_single_hart and reports how
+// fast the simulator goes.  The guests are built here with rv32i_asm so the
+// corpus needs no cross compiler, and each one leaves a checksum in a0 that is
+// compared with the same computation done on the host, so a fast but wrong
+// simulator does not get a number.  -w writes the guests out as .bin images
+// that rv32i runs directly.
+
+static constexpr uint32_t guest_mem_size = 0x40000;     ///< stack starts at the top
+static constexpr uint32_t data_base = 0x8000;           ///< code stays below this
+
+typedef rv32i_asm a;
+
+/**
+ * Sieve of Eratosthenes over an 8K byte array, reps times
+ * @return void
+ *
+* @param as the assembler
+* @param reps how many times the whole sieve runs
+ ********************************************************************************/
+static void build_sieve(rv32i_asm &as, uint32_t reps)
+{
+    auto outer = as.new_label(), init = as.new_label(), scan = as.new_label();
+    auto mark = as.new_label(), next = as.new_label();
+
+    as.li(a::s0, reps);
+    as.li(a::s1, 0);
+    as.li(a::s2, data_base);
+    as.li(a::s3, 8192);
+    as.bind(outer);
+    as.li(a::t0, 0);
+    as.li(a::t1, 1);
+    as.bind(init);                          // a[i] = 1
+    as.add(a::t2, a::s2, a::t0);
+    as.sb(a::t1, a::t2, 0);
+    as.addi(a::t0, a::t0, 1);
+    as.blt(a::t0, a::s3, init);
+    as.li(a::t0, 2);
+    as.bind(scan);
+    as.add(a::t2, a::s2, a::t0);
+    as.lbu(a::t3, a::t2, 0);
+    as.beq(a::t3, a::zero, next);
+    as.addi(a::s1, a::s1, 1);               // a prime, cross off its multiples
+    as.add(a::t4, a::t0, a::t0);
+    as.bind(mark);
+    as.bge(a::t4, a::s3, next);
+    as.add(a::t5, a::s2, a::t4);
+    as.sb(a::zero, a::t5, 0);
+    as.add(a::t4, a::t4, a::t0);
+    as.j(mark);
+    as.bind(next);
+    as.addi(a::t0, a::t0, 1);
+    as.blt(a::t0, a::s3, scan);
+    as.addi(a::s0, a::s0, -1);
+    as.bne(a::s0, a::zero, outer);
+    as.mv(a::a0, a::s1);
+    as.ebreak();
+}
+
+/**
+ * What build_sieve leaves in a0
+ * @return uint32_t
+ ********************************************************************************/
+static uint32_t expect_sieve(uint32_t reps)
+{
+    std::vector<bool> comp(8192, false);
+    uint32_t count = 0;
+    for(uint32_t i = 2; i < 8192; ++i)
+        if(!comp[i])
+        {
+            ++count;
+            for(uint32_t j = i + i; j < 8192; j += i)
+                comp[j] = true;
+        }
+    return count * reps;
+}
+
+/**
+ * A dhrystone-like mix: a record copy, a string compare and some integer work
+ * per iteration, with the record and string work in leaf calls
+ * @return void
+ *
+* @param as the assembler
+* @param n the number of iterations
+ ********************************************************************************/
+static void build_dhry(rv32i_asm &as, uint32_t n)
+{
+    const int32_t r1 = data_base, r2 = data_base + 0x40;
+    const int32_t s1 = data_base + 0x80, s2 = data_base + 0xc0;
+    auto init_rec = as.new_label(), init_str = as.new_label(), loop = as.new_label();
+    auto copy_rec = as.new_label(), copy_loop = as.new_label();
+    auto str_cmp = as.new_label(), cmp_loop = as.new_label(), cmp_diff = as.new_label();
+
+    as.li(a::t0, 0);                        // r1[k] = k
+    as.li(a::t1, r1);
+    as.li(a::t2, 8);
+    as.bind(init_rec);
+    as.sw(a::t0, a::t1, 0);
+    as.addi(a::t1, a::t1, 4);
+    as.addi(a::t0, a::t0, 1);
+    as.blt(a::t0, a::t2, init_rec);
+    as.li(a::t0, 'A');                      // s1 = s2 = "ABC...", 30 chars
+    as.li(a::t1, s1);
+    as.li(a::t2, s2);
+    as.li(a::t3, 'A' + 30);
+    as.bind(init_str);
+    as.sb(a::t0, a::t1, 0);
+    as.sb(a::t0, a::t2, 0);
+    as.addi(a::t1, a::t1, 1);
+    as.addi(a::t2, a::t2, 1);
+    as.addi(a::t0, a::t0, 1);
+    as.blt(a::t0, a::t3, init_str);
+    as.li(a::t0, 'A' + 28);                 // differ in the last char
+    as.li(a::t1, s2);
+    as.sb(a::t0, a::t1, 29);
+
+    as.li(a::s0, 0);
+    as.li(a::s1, 0);
+    as.li(a::s3, n);
+    as.bind(loop);
+    as.call(copy_rec);
+    as.call(str_cmp);
+    as.add(a::s1, a::s1, a::a0);
+    as.srli(a::t0, a::s0, 3);
+    as.xor_(a::t0, a::t0, a::s0);
+    as.add(a::s1, a::s1, a::t0);
+    as.slti(a::t0, a::s0, 1000);
+    as.add(a::s1, a::s1, a::t0);
+    as.li(a::t1, r2);
+    as.lw(a::t0, a::t1, 0);
+    as.add(a::s1, a::s1, a::t0);
+    as.addi(a::s0, a::s0, 1);
+    as.blt(a::s0, a::s3, loop);
+    as.mv(a::a0, a::s1);
+    as.ebreak();
+
+    as.bind(copy_rec);                      // r2 = r1, then ++r1[0]
+    as.li(a::a1, r1);
+    as.li(a::a2, r2);
+    as.li(a::t0, 8);
+    as.bind(copy_loop);
+    as.lw(a::t1, a::a1, 0);
+    as.sw(a::t1, a::a2, 0);
+    as.addi(a::a1, a::a1, 4);
+    as.addi(a::a2, a::a2, 4);
+    as.addi(a::t0, a::t0, -1);
+    as.bne(a::t0, a::zero, copy_loop);
+    as.li(a::a1, r1);
+    as.lw(a::t1, a::a1, 0);
+    as.addi(a::t1, a::t1, 1);
+    as.sw(a::t1, a::a1, 0);
+    as.ret();
+
+    as.bind(str_cmp);                       // a0 = strncmp(s1, s2, 30)
+    as.li(a::a1, s1);
+    as.li(a::a2, s2);
+    as.li(a::t0, 30);
+    as.bind(cmp_loop);
+    as.lbu(a::t1, a::a1, 0);
+    as.lbu(a::t2, a::a2, 0);
+    as.bne(a::t1, a::t2, cmp_diff);
+    as.addi(a::a1, a::a1, 1);
+    as.addi(a::a2, a::a2, 1);
+    as.addi(a::t0, a::t0, -1);
+    as.bne(a::t0, a::zero, cmp_loop);
+    as.li(a::a0, 0);
+    as.ret();
+    as.bind(cmp_diff);
+    as.sub(a::a0, a::t1, a::t2);
+    as.ret();
+}
+
+/**
+ * What build_dhry leaves in a0
+ * @return uint32_t
+ ********************************************************************************/
+static uint32_t expect_dhry(uint32_t n)
+{
+    uint32_t sum = 0;
+    for(uint32_t i = 0; i < n; ++i)
+        sum += 1 + (i ^ (i >> 3)) + (i < 1000) + i;
+    return sum;
+}
+
+static constexpr uint32_t memcpy_words = 4096;
+static constexpr uint32_t memcpy_bytes = 1024;
+static constexpr uint32_t memcpy_step = 0x9e3779b1;
+
+/**
+ * Copies a 16K block a word at a time (unrolled by four) and 1K of it a byte
+ * at a time, reps times, summing one word and one byte of the copies each time
+ * @return void
+ *
+* @param as the assembler
+* @param reps the number of copies
+ ********************************************************************************/
+static void build_memcpy(rv32i_asm &as, uint32_t reps)
+{
+    const int32_t src = data_base, dst = src + memcpy_words * 4, dst2 = dst + memcpy_words * 4;
+    auto fill = as.new_label(), loop = as.new_label();
+    auto wcopy = as.new_label(), bcopy = as.new_label();
+
+    as.li(a::t0, 0);                        // src[k] = (k + 1) * step
+    as.li(a::t1, memcpy_step);
+    as.li(a::a1, src);
+    as.li(a::a3, src + memcpy_words * 4);
+    as.bind(fill);
+    as.add(a::t0, a::t0, a::t1);
+    as.sw(a::t0, a::a1, 0);
+    as.addi(a::a1, a::a1, 4);
+    as.bltu(a::a1, a::a3, fill);
+
+    as.li(a::s0, 0);
+    as.li(a::s1, 0);
+    as.li(a::s3, reps);
+    as.li(a::s4, dst);
+    as.li(a::s5, dst2);
+    as.bind(loop);
+    as.li(a::a1, src);
+    as.mv(a::a2, a::s4);
+    as.li(a::a3, src + memcpy_words * 4);
+    as.bind(wcopy);
+    as.lw(a::t0, a::a1, 0);
+    as.lw(a::t1, a::a1, 4);
+    as.lw(a::t2, a::a1, 8);
+    as.lw(a::t3, a::a1, 12);
+    as.sw(a::t0, a::a2, 0);
+    as.sw(a::t1, a::a2, 4);
+    as.sw(a::t2, a::a2, 8);
+    as.sw(a::t3, a::a2, 12);
+    as.addi(a::a1, a::a1, 16);
+    as.addi(a::a2, a::a2, 16);
+    as.bltu(a::a1, a::a3, wcopy);
+    as.li(a::a1, src);
+    as.mv(a::a2, a::s5);
+    as.li(a::a3, src + memcpy_bytes);
+    as.bind(bcopy);
+    as.lbu(a::t0, a::a1, 0);
+    as.sb(a::t0, a::a2, 0);
+    as.addi(a::a1, a::a1, 1);
+    as.addi(a::a2, a::a2, 1);
+    as.bltu(a::a1, a::a3, bcopy);
+    as.slli(a::t0, a::s0, 20);              // dst[rep % 4096]
+    as.srli(a::t0, a::t0, 18);
+    as.add(a::t0, a::t0, a::s4);
+    as.lw(a::t1, a::t0, 0);
+    as.add(a::s1, a::s1, a::t1);
+    as.andi(a::t0, a::s0, memcpy_bytes - 1);    // dst2[rep % 1024]
+    as.add(a::t0, a::t0, a::s5);
+    as.lbu(a::t1, a::t0, 0);
+    as.add(a::s1, a::s1, a::t1);
+    as.addi(a::s0, a::s0, 1);
+    as.blt(a::s0, a::s3, loop);
+    as.mv(a::a0, a::s1);
+    as.ebreak();
+}
+
+/**
+ * What build_memcpy leaves in a0
+ * @return uint32_t
+ ********************************************************************************/
+static uint32_t expect_memcpy(uint32_t reps)
+{
+    uint32_t sum = 0;
+    for(uint32_t r = 0; r < reps; ++r)
+    {
+        uint32_t b = r % memcpy_bytes;
+        sum += ((r % memcpy_words) + 1) * memcpy_step;
+        sum += (((b / 4) + 1) * memcpy_step >> (8 * (b % 4))) & 0xff;
+    }
+    return sum;
+}
+
+static constexpr uint32_t xorshift_seed = 2463534242u;
+
+/**
+ * A xorshift32 generator feeding four data dependent branches per step, so
+ * the host branch predictor has nothing to learn
+ * @return void
+ *
+* @param as the assembler
+* @param n the number of steps
+ ********************************************************************************/
+static void build_branch(rv32i_asm &as, uint32_t n)
+{
+    auto loop = as.new_label(), l1 = as.new_label(), l2 = as.new_label();
+    auto l3 = as.new_label(), l4 = as.new_label();
+
+    as.li(a::s2, xorshift_seed);
+    as.li(a::s3, n);
+    as.li(a::s4, 0);                        // the four counters
+    as.li(a::s5, 0);
+    as.li(a::s6, 0);
+    as.li(a::s7, 0);
+    as.li(a::s1, 0x55555555);
+    as.bind(loop);
+    as.slli(a::t0, a::s2, 13);
+    as.xor_(a::s2, a::s2, a::t0);
+    as.srli(a::t0, a::s2, 17);
+    as.xor_(a::s2, a::s2, a::t0);
+    as.slli(a::t0, a::s2, 5);
+    as.xor_(a::s2, a::s2, a::t0);
+    as.andi(a::t0, a::s2, 1);
+    as.beq(a::t0, a::zero, l1);
+    as.addi(a::s4, a::s4, 1);
+    as.bind(l1);
+    as.bgeu(a::s2, a::s1, l2);
+    as.addi(a::s5, a::s5, 1);
+    as.bind(l2);
+    as.srli(a::t0, a::s2, 8);
+    as.andi(a::t0, a::t0, 3);
+    as.bne(a::t0, a::zero, l3);
+    as.addi(a::s6, a::s6, 1);
+    as.bind(l3);
+    as.blt(a::s2, a::zero, l4);
+    as.addi(a::s7, a::s7, 1);
+    as.bind(l4);
+    as.addi(a::s3, a::s3, -1);
+    as.bne(a::s3, a::zero, loop);
+    as.slli(a::s5, a::s5, 1);               // a0 = c1 + 2*c2 + 4*c3 + 8*c4
+    as.slli(a::s6, a::s6, 2);
+    as.slli(a::s7, a::s7, 3);
+    as.add(a::a0, a::s4, a::s5);
+    as.add(a::a0, a::a0, a::s6);
+    as.add(a::a0, a::a0, a::s7);
+    as.ebreak();
+}
+
+/**
+ * What build_branch leaves in a0
+ * @return uint32_t
+ ********************************************************************************/
+static uint32_t expect_branch(uint32_t n)
+{
+    uint32_t x = xorshift_seed, c1 = 0, c2 = 0, c3 = 0, c4 = 0;
+    for(uint32_t i = 0; i < n; ++i)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        c1 += x & 1;
+        c2 += x < 0x55555555;
+        c3 += ((x >> 8) & 3) == 0;
+        c4 += (int32_t)x >= 0;
+    }
+    return c1 + 2 * c2 + 4 * c3 + 8 * c4;
+}
+
+static constexpr uint32_t fib_n = 18;
+
+/**
+ * Naive recursive fib(18) reps times, which is mostly calls, returns and
+ * stack traffic
+ * @return void
+ *
+* @param as the assembler
+* @param reps the number of fib(18) calls from main
+ ********************************************************************************/
+static void build_call(rv32i_asm &as, uint32_t reps)
+{
+    auto loop = as.new_label(), fib = as.new_label(), base = as.new_label();
+
+    as.li(a::s2, reps);
+    as.li(a::s3, 0);
+    as.bind(loop);
+    as.li(a::a0, fib_n);
+    as.call(fib);
+    as.add(a::s3, a::s3, a::a0);
+    as.addi(a::s2, a::s2, -1);
+    as.bne(a::s2, a::zero, loop);
+    as.mv(a::a0, a::s3);
+    as.ebreak();
+
+    as.bind(fib);                           // a0 = fib(a0)
+    as.li(a::t0, 2);
+    as.blt(a::a0, a::t0, base);
+    as.addi(a::sp, a::sp, -16);
+    as.sw(a::ra, a::sp, 12);
+    as.sw(a::s0, a::sp, 8);
+    as.sw(a::s1, a::sp, 4);
+    as.mv(a::s0, a::a0);
+    as.addi(a::a0, a::s0, -1);
+    as.call(fib);
+    as.mv(a::s1, a::a0);
+    as.addi(a::a0, a::s0, -2);
+    as.call(fib);
+    as.add(a::a0, a::a0, a::s1);
+    as.lw(a::ra, a::sp, 12);
+    as.lw(a::s0, a::sp, 8);
+    as.lw(a::s1, a::sp, 4);
+    as.addi(a::sp, a::sp, 16);
+    as.bind(base);
+    as.ret();
+}
+
+/**
+ * What build_call leaves in a0
+ * @return uint32_t
+ ********************************************************************************/
+static uint32_t expect_call(uint32_t reps)
+{
+    uint32_t f0 = 0, f1 = 1;
+    for(uint32_t i = 0; i < fib_n; ++i)
+    {
+        uint32_t t = f0 + f1;
+        f0 = f1;
+        f1 = t;
+    }
+    return f0 * reps;
+}
+
+struct guest
+{
+    const char *name;
+    void (*build)(rv32i_asm &, uint32_t);
+    uint32_t (*expect)(uint32_t);
+    uint32_t n;                             ///< iterations at scale 1, a few million instructions
+};
+
+static const guest guests[] =
+{
+    { "sieve",   build_sieve,   expect_sieve,   20 },
+    { "dhry",    build_dhry,    expect_dhry,    15000 },
+    { "memcpy",  build_memcpy,  expect_memcpy,  250 },
+    { "branch",  build_branch,  expect_branch,  200000 },
+    { "call",    build_call,    expect_call,    30 },
+};
+
+/**
+ * Print a usage message and abort the program.
+ *
+ ********************************************************************************/
+static void usage()
+{
+    std::cerr << "Usage: rvbench [-c] [-n runs] [-s scale] [-w dir] [guest...]" << std::endl;
+    std::cerr << "    -c csv output" << std::endl;
+    std::cerr << "    -n runs of each guest, the best and the median are reported (default 5)" << std::endl;
+    std::cerr << "    -s multiplies the work each guest does (default 1)" << std::endl;
+    std::cerr << "    -w write the guest images to dir as <guest>.bin and exit" << std::endl;
+    std::cerr << "    guests:";
+    for(const auto &g : guests)
+        std::cerr << " " << g.name;
+    std::cerr << std::endl;
+    exit(1);
+}
+
+/**
+ * Peak resident set size of this process
+ * @return long kilobytes
+ ********************************************************************************/
+static long peak_rss_kb()
+{
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss;
+}
+
+/**
+ * Runs each selected guest and prints its timing
+ *
+* @param argc an int for the argument count
+* @param argv a char for the argument values
+ * @return int 1 if a guest gave the wrong answer
+ *
+ ********************************************************************************/
+int main(int argc, char **argv)
+{
+    unsigned runs = 5;
+    uint32_t scale = 1;
+    bool csv = false;
+    std::string write_dir;
+    int opt;
+    while((opt = getopt(argc, argv, "cn:s:w:")) != -1)
+    {
+        switch(opt)
+        {
+            case 'c':
+                csv = true;
+                break;
+            case 'n':
+            {
+                std::istringstream iss(optarg);
+                iss >> std::dec >> runs;
+            }
+            break;
+            case 's':
+            {
+                std::istringstream iss(optarg);
+                iss >> std::dec >> scale;
+            }
+            break;
+            case 'w':
+                write_dir = optarg;
+                break;
+            default:
+                usage();
+        }
+    }
+    if(runs == 0 || scale == 0)
+        usage();
+
+    std::vector<const guest*> selected;
+    for(int i = optind; i < argc; ++i)
+    {
+        auto it = std::find_if(std::begin(guests), std::end(guests),
+            [&](const guest &g) { return argv[i] == std::string(g.name); });
+        if(it == std::end(guests))
+        {
+            std::cerr << "Unknown guest " << argv[i] << std::endl;
+            usage();
+        }
+        selected.push_back(&*it);
+    }
+    if(selected.empty())
+        for(const auto &g : guests)
+            selected.push_back(&g);
+
+    if(!write_dir.empty())
+    {
+        for(const guest *g : selected)
+        {
+            rv32i_asm as;
+            g->build(as, g->n * scale);
+            std::string fname = write_dir + "/" + g->name + ".bin";
+            if(!as.save(fname))
+            {
+                std::cerr << "Can't write file '" << fname << "'" << std::endl;
+                return 1;
+            }
+            std::cout << fname << "  expect a0 = " << hex::to_hex0x32(g->expect(g->n * scale)) << std::endl;
+        }
+        return 0;
+    }
+
+    std::ostream discard(nullptr);          // the run summary is not wanted here
+    if(csv)
+        std::cout << "guest,insns,runs,best_s,median_s,mips,insns_per_ns" << std::endl;
+    else
+        std::cout << std::left << std::setw(8) << "guest" << std::right
+            << std::setw(12) << "insns" << std::setw(11) << "best s" << std::setw(11) << "median s"
+            << std::setw(9) << "MIPS" << std::setw(10) << "insns/ns" << std::endl;
+
+    int rc = 0;
+    for(const guest *g : selected)
+    {
+        rv32i_asm as;
+        g->build(as, g->n * scale);
+        const std::vector<uint32_t> &code = as.finish();
+        uint32_t expect = g->expect(g->n * scale);
+
+        std::vector<double> secs;
+        uint64_t insns = 0;
+        bool ok = true;
+        for(unsigned r = 0; r < runs && ok; ++r)
+        {
+            memory mem(guest_mem_size);
+            mem.set_output(discard);
+            mem.set_block(0, reinterpret_cast<const uint8_t*>(code.data()), code.size() * 4);
+            cpu_single_hart cpu(mem);
+            cpu.set_output(discard);
+            cpu.reset();
+
+            auto start = std::chrono::steady_clock::now();
+            cpu.run(0);
+            auto stop = std::chrono::steady_clock::now();
+
+            cosim_state st;
+            cpu.get_state(st);
+            if(cpu.get_halt_reason() != "EBREAK instruction" || (uint32_t)st.x[10] != expect)
+            {
+                std::cerr << g->name << ": " << cpu.get_halt_reason() << ", a0 = "
+                    << hex::to_hex0x32(st.x[10]) << ", expected " << hex::to_hex0x32(expect) << std::endl;
+                ok = false;
+                rc = 1;
+            }
+            insns = cpu.get_insn_counter();
+            secs.push_back(std::chrono::duration<double>(stop - start).count());
+        }
+        if(!ok)
+            continue;
+
+        std::sort(secs.begin(), secs.end());
+        double best = secs.front();
+        double median = secs[secs.size() / 2];
+        double mips = insns / median / 1e6;
+
+        if(csv)
+            std::cout << g->name << "," << insns << "," << runs << "," << best << "," << median << ","
+                << mips << "," << mips / 1e3 << std::endl;
+        else
+            std::cout << std::left << std::setw(8) << g->name << std::right << std::fixed
+                << std::setw(12) << insns << std::setprecision(4) << std::setw(11) << best
+                << std::setw(11) << median << std::setprecision(1) << std::setw(9) << mips
+                << std::setprecision(4) << std::setw(10) << mips / 1e3 << std::endl;
+    }
+
+    // every guest gets the same memory and the peak is for the whole process,
+    // so neither is a per guest number
+    if(!csv)
+        std::cout << "guest memory " << guest_mem_size / 1024 << " KB, peak RSS of all runs "
+            << peak_rss_kb() << " KB" << std::endl;
+    return rc;
+}
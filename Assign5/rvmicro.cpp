@@ -0,0 +1,285 @@
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <cstring>
+#include <getopt.h>
+#include "memory.h"
+#include "registerfile.h"
+#include "rv32i_decode.h"
+
+// Times the primitives the simulator spends its time in, one at a time, and
+// reports ns per call.  Each benchmark works through a table of batch inputs
+// so the calls can't be hoisted out of the loop, and folds every result into
+// a sink.  The batch is repeated until a sample takes at least -t ms, the
+// first samples are thrown away as warmup and the rest give the median, the
+// minimum and the spread.
+//
+// This file is built with -O2 so the harness costs little, but the code under
+// test is the same objects rv32i links, built the way the Makefile builds them.
+
+static constexpr unsigned batch = 1024;        ///< calls per pass over the inputs
+
+static volatile uint64_t sink;
+
+// the decode helpers are protected, this opens up the ones being timed
+class decode_access : public rv32i_decode
+{
+public:
+    using rv32i_decode::get_imm_i;
+    using rv32i_decode::get_imm_u;
+    using rv32i_decode::get_imm_b;
+    using rv32i_decode::get_imm_s;
+    using rv32i_decode::get_imm_j;
+    using rv32i_decode::get_opcode;
+    using rv32i_decode::opcode_lui;
+    using rv32i_decode::opcode_auipc;
+    using rv32i_decode::opcode_jal;
+    using rv32i_decode::opcode_jalr;
+    using rv32i_decode::opcode_btype;
+    using rv32i_decode::opcode_load_imm;
+    using rv32i_decode::opcode_stype;
+    using rv32i_decode::opcode_alu_imm;
+    using rv32i_decode::opcode_rtype;
+    using rv32i_decode::opcode_system;
+    using rv32i_decode::insn_ecall;
+    using rv32i_decode::insn_ebreak;
+};
+
+struct result
+{
+    double median;
+    double min;
+    double mean;
+    double stddev;
+    uint64_t passes;                        ///< passes over the batch per sample
+};
+
+static unsigned warmup = 3;
+static unsigned samples = 15;
+static double min_sample_ms = 20;
+
+/**
+ * Times one benchmark
+ * @return result ns per call
+ *
+* @param pass does one pass over the batch and returns a value for the sink
+ *
+ * @note the pass count is doubled until a sample takes min_sample_ms
+ ********************************************************************************/
+template <typename F>
+static result measure(F pass)
+{
+    typedef std::chrono::steady_clock clock;
+    uint64_t acc = 0;
+
+    uint64_t passes = 1;
+    for(;;)
+    {
+        auto start = clock::now();
+        for(uint64_t p = 0; p < passes; ++p)
+            acc += pass();
+        double ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+        if(ms >= min_sample_ms)
+            break;
+        passes *= 2;
+    }
+
+    std::vector<double> ns;
+    for(unsigned s = 0; s < warmup + samples; ++s)
+    {
+        auto start = clock::now();
+        for(uint64_t p = 0; p < passes; ++p)
+            acc += pass();
+        double t = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        if(s >= warmup)
+            ns.push_back(t / (passes * batch));
+    }
+    sink = sink + acc;
+
+    result r;
+    r.passes = passes;
+    r.mean = 0;
+    for(double v : ns)
+        r.mean += v;
+    r.mean /= ns.size();
+    r.stddev = 0;
+    for(double v : ns)
+        r.stddev += (v - r.mean) * (v - r.mean);
+    r.stddev = ns.size() > 1 ? std::sqrt(r.stddev / (ns.size() - 1)) : 0;
+    std::sort(ns.begin(), ns.end());
+    r.min = ns.front();
+    r.median = ns.size() % 2 ? ns[ns.size() / 2] : (ns[ns.size() / 2 - 1] + ns[ns.size() / 2]) / 2;
+    return r;
+}
+
+/**
+ * Next value of a xorshift32 generator, so the inputs are the same every run
+ * @return uint32_t
+ ********************************************************************************/
+static uint32_t next_rand(uint32_t &x)
+{
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+/**
+ * Print a usage message and abort the program.
+ *
+ ********************************************************************************/
+static void usage()
+{
+    std::cerr << "Usage: rvmicro [-c] [-l] [-r samples] [-t ms] [-w warmup] [name...]" << std::endl;
+    std::cerr << "    -c csv output" << std::endl;
+    std::cerr << "    -l list the benchmarks and exit" << std::endl;
+    std::cerr << "    -r samples per benchmark (default 15)" << std::endl;
+    std::cerr << "    -t minimum ms per sample (default 20)" << std::endl;
+    std::cerr << "    -w samples thrown away first (default 3)" << std::endl;
+    std::cerr << "    name runs the benchmarks that start with name" << std::endl;
+    exit(1);
+}
+
+struct bench
+{
+    const char *name;
+    std::function<uint64_t()> pass;
+};
+
+/**
+ * Runs the selected microbenchmarks
+ *
+* @param argc an int for the argument count
+* @param argv a char for the argument values
+ * @return int
+ *
+ ********************************************************************************/
+int main(int argc, char **argv)
+{
+    bool csv = false;
+    bool list = false;
+    int opt;
+    while((opt = getopt(argc, argv, "clr:t:w:")) != -1)
+    {
+        switch(opt)
+        {
+            case 'c':
+                csv = true;
+                break;
+            case 'l':
+                list = true;
+                break;
+            case 'r':
+            {
+                std::istringstream iss(optarg);
+                iss >> std::dec >> samples;
+            }
+            break;
+            case 't':
+            {
+                std::istringstream iss(optarg);
+                iss >> min_sample_ms;
+            }
+            break;
+            case 'w':
+            {
+                std::istringstream iss(optarg);
+                iss >> std::dec >> warmup;
+            }
+            break;
+            default:
+                usage();
+        }
+    }
+    if(samples == 0)
+        usage();
+
+    // inputs: instruction words with real opcodes, in range addresses and
+    // register numbers, all from a fixed seed
+    static const uint32_t opcodes[] =
+    {
+        decode_access::opcode_lui, decode_access::opcode_auipc, decode_access::opcode_jal,
+        decode_access::opcode_jalr, decode_access::opcode_btype, decode_access::opcode_load_imm,
+        decode_access::opcode_stype, decode_access::opcode_alu_imm, decode_access::opcode_rtype,
+        decode_access::opcode_system,
+    };
+    const uint32_t mem_size = 0x10000;
+    uint32_t seed = 2463534242u;
+    std::vector<uint32_t> insns(batch), addrs(batch), values(batch), regs(batch);
+    for(unsigned i = 0; i < batch; ++i)
+    {
+        uint32_t x = next_rand(seed);
+        insns[i] = (x & ~0x7fu) | opcodes[x % (sizeof(opcodes) / sizeof(opcodes[0]))];
+        if(decode_access::get_opcode(insns[i]) == decode_access::opcode_system)
+            insns[i] = x & 0x100 ? decode_access::insn_ebreak : decode_access::insn_ecall;
+        addrs[i] = next_rand(seed) % mem_size;
+        values[i] = next_rand(seed);
+        regs[i] = next_rand(seed) % 32;
+    }
+
+    memory mem(mem_size);
+    registerfile rf;
+
+    // each pass touches every input once; aligned accesses mask off the low bits
+    std::vector<bench> benches =
+    {
+        { "get_imm_i", [&] { uint64_t s = 0; for(uint32_t w : insns) s += decode_access::get_imm_i(w); return s; } },
+        { "get_imm_u", [&] { uint64_t s = 0; for(uint32_t w : insns) s += decode_access::get_imm_u(w); return s; } },
+        { "get_imm_b", [&] { uint64_t s = 0; for(uint32_t w : insns) s += decode_access::get_imm_b(w); return s; } },
+        { "get_imm_s", [&] { uint64_t s = 0; for(uint32_t w : insns) s += decode_access::get_imm_s(w); return s; } },
+        { "get_imm_j", [&] { uint64_t s = 0; for(uint32_t w : insns) s += decode_access::get_imm_j(w); return s; } },
+        { "decode", [&] { uint64_t s = 0; for(unsigned i = 0; i < batch; ++i) s += rv32i_decode::decode(i * 4, insns[i]).size(); return s; } },
+        { "memory::get8", [&] { uint64_t s = 0; for(uint32_t a : addrs) s += mem.get8(a); return s; } },
+        { "memory::get16", [&] { uint64_t s = 0; for(uint32_t a : addrs) s += mem.get16(a & ~1u); return s; } },
+        { "memory::get32", [&] { uint64_t s = 0; for(uint32_t a : addrs) s += mem.get32(a & ~3u); return s; } },
+        { "memory::set32", [&] { for(unsigned i = 0; i < batch; ++i) mem.set32(addrs[i] & ~3u, values[i]); return (uint64_t)mem.get8(0); } },
+        { "registerfile::get", [&] { uint64_t s = 0; for(uint32_t r : regs) s += rf.get(r); return s; } },
+        { "registerfile::set", [&] { for(unsigned i = 0; i < batch; ++i) rf.set(regs[i], values[i]); return (uint64_t)rf.get(1); } },
+        { "hex::to_hex8", [&] { uint64_t s = 0; for(uint32_t v : values) s += hex::to_hex8(v)[0]; return s; } },
+        { "hex::to_hex32", [&] { uint64_t s = 0; for(uint32_t v : values) s += hex::to_hex32(v)[0]; return s; } },
+        { "hex::to_hex0x12", [&] { uint64_t s = 0; for(uint32_t v : values) s += hex::to_hex0x12(v)[2]; return s; } },
+        { "hex::to_hex0x20", [&] { uint64_t s = 0; for(uint32_t v : values) s += hex::to_hex0x20(v)[2]; return s; } },
+        { "hex::to_hex0x32", [&] { uint64_t s = 0; for(uint32_t v : values) s += hex::to_hex0x32(v)[2]; return s; } },
+        { "hex::append_hex32", [&] { std::string buf; for(uint32_t v : values) hex::append_hex32(buf, v); return (uint64_t)buf.size(); } },
+    };
+
+    if(list)
+    {
+        for(const auto &b : benches)
+            std::cout << b.name << std::endl;
+        return 0;
+    }
+
+    if(csv)
+        std::cout << "name,median_ns,min_ns,mean_ns,stddev_ns,samples,calls_per_sample" << std::endl;
+    else
+        std::cout << std::left << std::setw(20) << "name" << std::right << std::setw(10) << "ns/op"
+            << std::setw(10) << "min" << std::setw(10) << "mean" << std::setw(9) << "+-%" << std::endl;
+
+    for(const auto &b : benches)
+    {
+        bool wanted = optind >= argc;
+        for(int i = optind; i < argc; ++i)
+            if(std::string(b.name).compare(0, strlen(argv[i]), argv[i]) == 0)
+                wanted = true;
+        if(!wanted)
+            continue;
+
+        result r = measure(b.pass);
+        if(csv)
+            std::cout << b.name << "," << r.median << "," << r.min << "," << r.mean << ","
+                << r.stddev << "," << samples << "," << r.passes * batch << std::endl;
+        else
+            std::cout << std::left << std::setw(20) << b.name << std::right << std::fixed
+                << std::setprecision(2) << std::setw(10) << r.median << std::setw(10) << r.min
+                << std::setw(10) << r.mean << std::setprecision(1) << std::setw(9)
+                << (r.mean > 0 ? 100 * r.stddev / r.mean : 0) << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,491 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <deque>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+#include <getopt.h>
+#include <dirent.h>
+#include "rv32i_driver.h"
+
+// Runs every golden output in a testdata directory through the simulator.
+// A golden file is named after the image and the rv32i flags it was made with:
+//
+//     allinsns5-dirz.out              rv32i -d -i -r -z allinsns5.bin
+//     align-dirzl5.out                rv32i -d -i -r -z -l 5 align.bin
+//     torture5-iz-m8500.out           rv32i -i -z -m 8500 torture5.bin
+//     sieve-z-m50000-tail-100.out     rv32i -z -m 50000 sieve.bin | tail -100
+//
+// grep, head and tail name a filter the output went through.  The cases run
+// in this process, in parallel, through the same rv32i_driver as rv32i, with
+// each one writing into a stream that is compared with the golden file line
+// by line as it is produced.  Built with RV_XLEN=64 as rvtest64 it runs the
+// rv64i goldens in testdata64 the same way.
+
+/**
+ * Usage function used to print useful information
+ *
+ * @return void
+ *
+ * @note Shows how to use the program flags
+ ********************************************************************************/
+static void usage()
+{
+    std::cerr << "Usage: rvtest [-j threads] [-v] [testdata-dir]" << std::endl;
+    std::cerr << "    -j run this many cases at once (0 = one per core)" << std::endl;
+    std::cerr << "    -v show the first difference of each failing case" << std::endl;
+    exit(2);
+}
+
+enum case_status { case_pass, case_fail, case_skip };
+
+struct test_case
+{
+    std::string name;                   ///< golden file name without .out
+    std::string image;                  ///< the .bin it runs
+    std::vector<std::string> args;      ///< the rv32i options before the image
+    std::string filter;                 ///< "", "grep", "head" or "tail"
+    std::string filter_arg;
+
+    case_status status = { case_skip };
+    std::string note;                   ///< why it failed or was skipped
+    double seconds = { 0 };
+};
+
+/**
+ * A stream buffer that compares what is written to it with a golden file
+ *
+ * @note complete lines go through the case's grep/head/tail filter and are
+ * compared as they arrive, so no output is kept except a partial line and
+ * the lines a tail filter is holding. Only the first difference is recorded
+ ********************************************************************************/
+class golden_diff : public std::streambuf
+{
+public:
+    golden_diff(std::istream &g, const test_case &tc, size_t max) : golden(g), filter(tc.filter), max_lines(max)
+    {
+        if(filter == "head" || filter == "tail")
+            count = std::stoul(tc.filter_arg);
+        else
+            pattern = tc.filter_arg;
+    }
+
+    void finish();
+    bool matched() const { return !failed; }
+    const std::string &get_report() const { return report; }
+
+protected:
+    int_type overflow(int_type c) override;
+    std::streamsize xsputn(const char *s, std::streamsize n) override;
+
+private:
+    void take(const std::string &l);
+    void compare(const std::string &l);
+    void mismatch(const std::string &expected, const std::string &actual);
+
+    std::istream &golden;
+    std::string filter;
+    std::string pattern;
+    size_t count = { 0 };               ///< lines kept by head or tail
+    size_t max_lines;                   ///< compare no more than this many lines, 0 for all
+    std::string line;                   ///< the partial line written so far
+    std::deque<std::string> tail;
+    size_t taken = { 0 };               ///< lines that got through the filter
+    size_t compared = { 0 };
+    bool failed = { false };
+    std::string report;
+};
+
+/**
+ * Takes one character
+ * @return int_type the character, never eof
+ *
+ * @param c the character written
+ ********************************************************************************/
+golden_diff::int_type golden_diff::overflow(int_type c)
+{
+    if(c == traits_type::eof())
+        return traits_type::not_eof(c);
+
+    char ch = traits_type::to_char_type(c);
+    if(ch == '\n')
+    {
+        take(line);
+        line.clear();
+    }
+    else
+        line += ch;
+    return c;
+}
+
+/**
+ * Takes a block of characters
+ * @return std::streamsize n, everything is always taken
+ *
+ * @param s the characters written
+ * @param n how many
+ *
+ * @note splits the block at newlines without copying whole lines twice
+ ********************************************************************************/
+std::streamsize golden_diff::xsputn(const char *s, std::streamsize n)
+{
+    const char *end = s + n;
+    while(s < end)
+    {
+        const char *nl = std::find(s, end, '\n');
+        line.append(s, nl);
+        if(nl == end)
+            break;
+        take(line);
+        line.clear();
+        s = nl + 1;
+    }
+    return n;
+}
+
+/**
+ * Runs one output line through the filter
+ * @return void
+ *
+ * @param l the line without its newline
+ ********************************************************************************/
+void golden_diff::take(const std::string &l)
+{
+    if(failed)
+        return;
+
+    if(filter == "grep")
+    {
+        if(l.find(pattern) != std::string::npos)
+            compare(l);
+    }
+    else if(filter == "head")
+    {
+        if(taken < count)
+            compare(l);
+    }
+    else if(filter == "tail")
+    {
+        tail.push_back(l);
+        if(tail.size() > count)
+            tail.pop_front();
+    }
+    else
+        compare(l);
+    ++taken;
+}
+
+/**
+ * Compares one filtered output line with the next golden line
+ * @return void
+ *
+ * @param l the line without its newline
+ ********************************************************************************/
+void golden_diff::compare(const std::string &l)
+{
+    if(failed || (max_lines && compared >= max_lines))
+        return;
+    ++compared;
+
+    std::string g;
+    if(!std::getline(golden, g))
+        mismatch("<end of file>", l);
+    else if(g != l)
+        mismatch(g, l);
+}
+
+/**
+ * Records the first difference
+ * @return void
+ *
+ * @param expected the golden line
+ * @param actual the simulator's line
+ ********************************************************************************/
+void golden_diff::mismatch(const std::string &expected, const std::string &actual)
+{
+    failed = true;
+    std::ostringstream os;
+    os << "line " << compared << std::endl
+       << "    expected: " << expected << std::endl
+       << "    actual:   " << actual;
+    report = os.str();
+}
+
+/**
+ * Ends the output
+ * @return void
+ *
+ * @note compares a last line without a newline, the lines a tail filter kept
+ * and then checks that the golden file has nothing left
+ ********************************************************************************/
+void golden_diff::finish()
+{
+    if(!line.empty())
+    {
+        take(line);
+        line.clear();
+    }
+    for(const auto &l : tail)
+        compare(l);
+    tail.clear();
+
+    if(failed || (max_lines && compared >= max_lines))
+        return;
+
+    std::string g;
+    if(std::getline(golden, g))
+    {
+        ++compared;
+        mismatch(g, "<end of output>");
+    }
+}
+
+/**
+ * Works out the image and rv32i flags from a golden file name
+ * @return bool false if the name does not follow the pattern
+ *
+ * @param name the file name without .out
+ * @param tc filled in with the image and flags
+ *
+ * @note the first word is the image, a word of m and hex digits is the memory
+ * size and grep/head/tail take the next word. Any other word is a run of flag
+ * letters where l is followed by the decimal exec limit. The letters are not
+ * checked here, one rv32i does not know is left for it to reject
+ ********************************************************************************/
+static bool parse_case(const std::string &name, test_case &tc)
+{
+    std::vector<std::string> words;
+    std::istringstream iss(name);
+    std::string w;
+    while(std::getline(iss, w, '-'))
+        words.push_back(w);
+    if(words.size() < 2 || words[0].empty())
+        return false;
+
+    tc.name = name;
+    tc.image = words[0] + ".bin";
+    for(size_t i = 1; i < words.size(); ++i)
+    {
+        const std::string &word = words[i];
+        if(word.empty())
+            return false;
+        if(word == "grep" || word == "head" || word == "tail")
+        {
+            if(i + 1 >= words.size() || !tc.filter.empty())
+                return false;
+            tc.filter = word;
+            tc.filter_arg = words[++i];
+            if(word != "grep" && tc.filter_arg.find_first_not_of("0123456789") != std::string::npos)
+                return false;
+            continue;
+        }
+        if(word[0] == 'm' && word.size() > 1 && word.find_first_not_of("0123456789abcdef", 1) == std::string::npos)
+        {
+            tc.args.push_back("-m");
+            tc.args.push_back(word.substr(1));
+            continue;
+        }
+        for(size_t j = 0; j < word.size(); ++j)
+        {
+            tc.args.push_back(std::string("-") + word[j]);
+            if(word[j] == 'l')
+            {
+                size_t k = word.find_first_not_of("0123456789", j + 1);
+                if(k == j + 1)
+                    return false;           // l needs a limit
+                tc.args.push_back(word.substr(j + 1, k - j - 1));
+                j = (k == std::string::npos ? word.size() : k) - 1;
+            }
+        }
+    }
+    return true;
+}
+
+static std::mutex getopt_lock;          ///< rv32i_driver::parse uses getopt's globals
+
+/**
+ * Runs one case and compares its output with the golden file
+ *
+ * @param dir the testdata directory
+ * @param tc the case, its status, note and time are filled in
+ * @return void
+ *
+ * @note a case whose command line rv32i rejects only compares the first line,
+ * the complaint about it. The usage text after that lists the current
+ * options and is not compared
+ ********************************************************************************/
+static void run_case(const std::string &dir, test_case &tc)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    std::ifstream golden(dir + "/" + tc.name + ".out");
+    if(!golden.is_open())
+    {
+        tc.status = case_fail;
+        tc.note = "can't open the golden file";
+        return;
+    }
+    if(!std::ifstream(dir + "/" + tc.image).is_open())
+    {
+        tc.status = case_skip;
+        tc.note = "no " + tc.image;
+        return;
+    }
+
+    std::vector<std::string> args = tc.args;
+    args.insert(args.begin(), "./rv32i");
+    args.push_back(dir + "/" + tc.image);
+    std::vector<char*> argv;
+    for(auto &a : args)
+        argv.push_back(&a[0]);
+    argv.push_back(nullptr);
+
+    rv32i_driver driver;
+    std::ostringstream complaint;
+    bool parsed;
+    {
+        std::lock_guard<std::mutex> lock(getopt_lock);
+        parsed = driver.parse(args.size(), argv.data(), complaint);
+    }
+
+    golden_diff diff(golden, tc, parsed ? 0 : 1);
+    std::ostream os(&diff);
+    if(parsed)
+        driver.run(os, os);
+    else
+        os << complaint.str();
+    os.flush();
+    diff.finish();
+
+    tc.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    tc.status = diff.matched() ? case_pass : case_fail;
+    tc.note = diff.get_report();
+}
+
+/**
+ * Finds the golden files in a directory
+ *
+ * @param dir the testdata directory
+ * @param cases filled with one case per .out file, sorted by name
+ * @return bool false if the directory can't be read
+ ********************************************************************************/
+static bool find_cases(const std::string &dir, std::vector<test_case> &cases)
+{
+    DIR *d = opendir(dir.c_str());
+    if(!d)
+    {
+        std::cerr << "Can't open directory " << dir << std::endl;
+        return false;
+    }
+
+    std::vector<std::string> names;
+    while(struct dirent *e = readdir(d))
+    {
+        std::string f = e->d_name;
+        if(f.size() > 4 && f.compare(f.size() - 4, 4, ".out") == 0)
+            names.push_back(f.substr(0, f.size() - 4));
+    }
+    closedir(d);
+    std::sort(names.begin(), names.end());
+
+    for(const auto &n : names)
+    {
+        test_case tc;
+        if(!parse_case(n, tc))
+        {
+            tc.name = n;
+            tc.status = case_fail;
+            tc.note = "can't work out the flags from the name";
+        }
+        cases.push_back(tc);
+    }
+    return true;
+}
+
+/**
+ * Main function, runs every golden case in the directory
+ *
+* @param argc an int for the argument count
+* @param argv a char for the argument values
+ * @return int 0 if every case that ran passed, 1 if any failed
+ *
+ ********************************************************************************/
+int main(int argc, char **argv)
+{
+    unsigned threads = 0;
+    bool verbose = false;
+    int opt;
+    while((opt = getopt(argc, argv, "j:v")) != -1)
+    {
+        switch(opt)
+        {
+            case 'j':
+            {
+                std::istringstream iss(optarg);
+                iss >> std::dec >> threads;
+            }
+            break;
+            case 'v':  verbose = true; break;
+            default: /* ’?’ */
+            usage();
+        }
+    }
+    if(optind + 1 < argc)
+        usage();
+    std::string dir = optind < argc ? argv[optind] : "testdata";
+
+    std::vector<test_case> cases;
+    if(!find_cases(dir, cases))
+        return 2;
+
+    if(threads == 0)
+        threads = std::thread::hardware_concurrency();
+    if(threads == 0)
+        threads = 1;
+    threads = std::min<size_t>(threads, std::max<size_t>(cases.size(), 1));
+
+    auto start = std::chrono::steady_clock::now();
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> workers;
+    for(unsigned t = 0; t < threads; ++t)
+        workers.emplace_back([&]()
+        {
+            for(size_t i = next++; i < cases.size(); i = next++)
+                if(!cases[i].image.empty())
+                    run_case(dir, cases[i]);
+        });
+    for(auto &w : workers)
+        w.join();
+    double total = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t passed = 0, failed = 0, skipped = 0;
+    for(const auto &tc : cases)
+    {
+        static const char *label[] = { "PASS", "FAIL", "SKIP" };
+        std::cout << label[tc.status] << "  " << std::left << std::setw(36) << tc.name
+                  << std::right << std::fixed << std::setprecision(4) << std::setw(9) << tc.seconds << "s";
+        size_t nl = tc.note.find('\n');
+        if(tc.status != case_pass)
+            std::cout << "  " << tc.note.substr(0, nl);
+        if(tc.status == case_fail && verbose && nl != std::string::npos)
+            std::cout << tc.note.substr(nl);
+        std::cout << std::endl;
+
+        if(tc.status == case_pass)
+            ++passed;
+        else if(tc.status == case_fail)
+            ++failed;
+        else
+            ++skipped;
+    }
+    std::cout << passed << " passed, " << failed << " failed, " << skipped << " skipped in "
+              << std::fixed << std::setprecision(4) << total << "s" << std::endl;
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,248 @@
+#include "syscalls.h"
+#include <cerrno>
+#include <cstdio>
+#include <ctime>
+#include <fcntl.h>
+#include <unistd.h>
+
+// guest open flags (asm-generic, what RISC-V Linux uses)
+static constexpr uint32_t guest_o_accmode   = 00000003;
+static constexpr uint32_t guest_o_creat     = 00000100;
+static constexpr uint32_t guest_o_excl      = 00000200;
+static constexpr uint32_t guest_o_trunc     = 00001000;
+static constexpr uint32_t guest_o_append    = 00002000;
+static constexpr int32_t guest_at_fdcwd     = -100;
+
+/**
+ * check a guest buffer without the memory warnings
+ * @return bool true if [addr, addr+len) is inside the guest memory
+ ********************************************************************************/
+static bool in_range(const memory &mem, memory::addr_t addr, memory::addr_t len)
+{
+    return addr <= mem.get_size() && len <= mem.get_size() - addr;
+}
+
+/**
+ * Constructor
+ *
+* @param m the guest memory
+* @param brk the initial program break, the first byte after the loaded image
+* @param bufsize the size of the host-side buffer for guest stdout
+ ********************************************************************************/
+syscalls::syscalls(memory &m, memory::addr_t brk, size_t bufsize) : mem(m), init_brk(brk), cur_brk(brk), obuf(bufsize)
+{
+}
+
+/**
+ * Destructor
+ *
+ * @note writes whatever the guest left in the stdout buffer and closes any files
+ * the guest did not
+ ********************************************************************************/
+syscalls::~syscalls()
+{
+    flush();
+    for(int fd : open_fds)
+        ::close(fd);
+}
+
+/**
+ * write the buffered guest stdout to the output stream
+ * @return void
+ ********************************************************************************/
+void syscalls::flush()
+{
+    if(obuf_used)
+    {
+        out->write(obuf.data(), obuf_used);
+        obuf_used = 0;
+    }
+    out->flush();
+}
+
+/**
+ * emulate the system call in a7 with the arguments in a0-a5
+ * @return bool true if the guest called exit and the hart should halt
+ *
+* @param regs the hart registers, the result is written to a0
+ *
+ * @note errors are returned the Linux way as -errno in a0. Calls that are not
+ * emulated return -ENOSYS
+ ********************************************************************************/
+bool syscalls::call(registerfile &regs)
+{
+    sreg_t a0 = regs.get(10);
+    sreg_t a1 = regs.get(11);
+    sreg_t a2 = regs.get(12);
+    sreg_t a3 = regs.get(13);
+    sreg_t ret;
+
+    switch((registerfile::reg_t)regs.get(17))
+    {
+        default:  ret = -ENOSYS; break;
+        case sys_openat:  ret = do_openat(a0, a1, a2, a3); break;
+        case sys_close:  ret = do_close(a0); break;
+        case sys_read:  ret = do_read(a0, a1, a2); break;
+        case sys_write:  ret = do_write(a0, a1, a2); break;
+        case (RV_XLEN == 64 ? sys_clock_gettime : sys_clock_gettime64):  ret = do_clock_gettime(a0, a1); break;
+        case sys_brk:  ret = do_brk(a0, regs.get(2)); break;
+        case sys_exit:
+        case sys_exit_group:
+            exited = true;
+            exit_code = (int)a0;
+            return true;
+    }
+    regs.set(10, ret);
+    return false;
+}
+
+/**
+ * openat(dirfd, path, flags, mode)
+ * @return sreg_t the new fd or -errno
+ *
+ * @note only AT_FDCWD or an absolute path is supported
+ ********************************************************************************/
+syscalls::sreg_t syscalls::do_openat(sreg_t dirfd, memory::addr_t path, sreg_t flags, sreg_t mode)
+{
+    std::string name;
+    for(memory::addr_t a = path; ; ++a)
+    {
+        if(!in_range(mem, a, 1))
+            return -EFAULT;
+        char c = mem.get8(a);
+        if(c == '\0')
+            break;
+        name += c;
+    }
+    if(dirfd != guest_at_fdcwd && (name.empty() || name[0] != '/'))
+        return -EBADF;
+
+    int hflags = 0;
+    switch(flags & guest_o_accmode)
+    {
+        case 0:  hflags = O_RDONLY; break;
+        case 1:  hflags = O_WRONLY; break;
+        default:  hflags = O_RDWR; break;
+    }
+    if(flags & guest_o_creat) hflags |= O_CREAT;
+    if(flags & guest_o_excl) hflags |= O_EXCL;
+    if(flags & guest_o_trunc) hflags |= O_TRUNC;
+    if(flags & guest_o_append) hflags |= O_APPEND;
+
+    int fd = ::open(name.c_str(), hflags, (mode_t)(mode & 0777));
+    if(fd < 0)
+        return -errno;
+    open_fds.insert(fd);
+    return fd;
+}
+
+/**
+ * close(fd)
+ * @return sreg_t 0 or -errno
+ *
+ * @note the guest can only close what it opened, closing stdin, stdout or
+ * stderr is quietly ignored
+ ********************************************************************************/
+syscalls::sreg_t syscalls::do_close(sreg_t fd)
+{
+    if(fd >= 0 && fd <= 2)
+        return 0;
+    if(!open_fds.erase((int)fd))
+        return -EBADF;
+    return ::close((int)fd) < 0 ? -errno : 0;
+}
+
+/**
+ * read(fd, buf, count)
+ * @return sreg_t the number of bytes read or -errno
+ ********************************************************************************/
+syscalls::sreg_t syscalls::do_read(sreg_t fd, memory::addr_t buf, memory::addr_t count)
+{
+    if(fd != 0 && !open_fds.count((int)fd))
+        return -EBADF;
+    if(!in_range(mem, buf, count))
+        return -EFAULT;
+    if(fd == 0)
+        flush();                                    // show any prompt first
+
+    scratch.resize(count);
+    ssize_t n = ::read((int)fd, scratch.data(), count);
+    if(n < 0)
+        return -errno;
+    mem.set_block(buf, scratch.data(), n);
+    return n;
+}
+
+/**
+ * write(fd, buf, count)
+ * @return sreg_t the number of bytes written or -errno
+ *
+ * @note stdout goes through the host-side buffer, stderr is written right away
+ * after flushing stdout so the two stay in order
+ ********************************************************************************/
+syscalls::sreg_t syscalls::do_write(sreg_t fd, memory::addr_t buf, memory::addr_t count)
+{
+    if(!in_range(mem, buf, count))
+        return -EFAULT;
+
+    if(fd == 1)
+    {
+        if(obuf_used + count > obuf.size())
+            flush();
+        if(count > obuf.size())                     // too big to buffer at all
+        {
+            scratch.resize(count);
+            mem.get_block(buf, scratch.data(), count);
+            out->write(reinterpret_cast<const char*>(scratch.data()), count);
+            return count;
+        }
+        mem.get_block(buf, reinterpret_cast<uint8_t*>(&obuf[obuf_used]), count);
+        obuf_used += count;
+        return count;
+    }
+
+    if(fd != 2 && !open_fds.count((int)fd))
+        return -EBADF;
+    if(fd == 2)
+        flush();
+
+    scratch.resize(count);
+    mem.get_block(buf, scratch.data(), count);
+    ssize_t n = ::write((int)fd, scratch.data(), count);
+    return n < 0 ? -errno : n;
+}
+
+/**
+ * clock_gettime(clk, tp) on RV64, clock_gettime64(clk, tp) on RV32
+ * @return sreg_t 0 or -errno
+ *
+ * @note writes a 64-bit tv_sec and tv_nsec, the timespec both calls use
+ ********************************************************************************/
+syscalls::sreg_t syscalls::do_clock_gettime(sreg_t clk, memory::addr_t tp)
+{
+    if(!in_range(mem, tp, 16))
+        return -EFAULT;
+
+    struct timespec ts;
+    if(::clock_gettime((clockid_t)clk, &ts) < 0)
+        return -errno;
+    mem.set64(tp, ts.tv_sec);
+    mem.set64(tp + 8, ts.tv_nsec);
+    return 0;
+}
+
+/**
+ * brk(addr)
+ * @return sreg_t the new program break, or the old one if addr can't be used
+ *
+* @param addr the requested break, 0 asks for the current one
+* @param limit the guest stack pointer, the heap may not grow past it
+ *
+ * @note the break never moves below the end of the loaded image
+ ********************************************************************************/
+syscalls::sreg_t syscalls::do_brk(memory::addr_t addr, memory::addr_t limit)
+{
+    if(addr >= init_brk && addr <= limit && addr <= mem.get_size())
+        cur_brk = addr;
+    return cur_brk;
+}
@@ -0,0 +1,58 @@
+#ifndef SYSCALLS_H
+#define SYSCALLS_H
+#include <vector>
+#include <set>
+#include <string>
+#include <iostream>
+#include "memory.h"
+#include "registerfile.h"
+
+class syscalls
+{
+    public:
+        // Linux system call numbers (asm-generic), passed in a7
+        static constexpr uint32_t sys_openat            = 56;
+        static constexpr uint32_t sys_close             = 57;
+        static constexpr uint32_t sys_read              = 63;
+        static constexpr uint32_t sys_write             = 64;
+        static constexpr uint32_t sys_exit              = 93;
+        static constexpr uint32_t sys_exit_group        = 94;
+        static constexpr uint32_t sys_clock_gettime     = 113;      ///< RV64 only
+        static constexpr uint32_t sys_brk               = 214;
+        static constexpr uint32_t sys_clock_gettime64   = 403;      ///< RV32 only, it has no 32-bit time calls
+
+        static constexpr size_t default_buffer_size     = 1 << 20;
+
+        syscalls(memory &m, memory::addr_t brk, size_t bufsize = default_buffer_size);
+        ~syscalls();
+
+        bool call(registerfile &regs);
+        void flush();
+        void set_output(std::ostream &os) { out = &os; }
+
+        bool has_exited() const { return exited; }
+        int get_exit_code() const { return exit_code; }
+
+    private:
+        typedef registerfile::sreg_t sreg_t;
+
+        sreg_t do_openat(sreg_t dirfd, memory::addr_t path, sreg_t flags, sreg_t mode);
+        sreg_t do_close(sreg_t fd);
+        sreg_t do_read(sreg_t fd, memory::addr_t buf, memory::addr_t count);
+        sreg_t do_write(sreg_t fd, memory::addr_t buf, memory::addr_t count);
+        sreg_t do_clock_gettime(sreg_t clk, memory::addr_t tp);
+        sreg_t do_brk(memory::addr_t addr, memory::addr_t limit);
+
+        memory &mem;
+        memory::addr_t init_brk;            ///< the end of the loaded image
+        memory::addr_t cur_brk;
+        std::vector<char> obuf;             ///< guest stdout, written to the host when full
+        size_t obuf_used = { 0 };
+        std::ostream *out = { &std::cout };     ///< where guest stdout goes
+        std::vector<uint8_t> scratch;       ///< staging for read and write
+        std::set<int> open_fds;             ///< host fds opened by the guest
+        bool exited = { false };
+        int exit_code = { 0 };
+};
+
+#endif
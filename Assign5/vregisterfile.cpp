@@ -0,0 +1,80 @@
+#include "vregisterfile.h"
+
+/**
+ * Constructor 
+ * @return void  
+ *
+ * @note resets vregisterfile with default values 
+ ********************************************************************************/
+vregisterfile::vregisterfile()
+{
+    reset(); 
+}
+
+/**
+ * reset function to reset vregisterfile 
+ * @return void  
+ *
+ * @note fills all 32 registers with the same pattern as the integer registers,
+ * vl is 0 and vtype is illegal until the first vsetvl
+ ********************************************************************************/
+void vregisterfile::reset()
+{
+    registers.assign(32*vlenb,0xf0);
+    vl = 0;
+    vtype = 0;
+    vill = true;
+
+}
+
+/**
+ * set vtype
+ * @return bool false if the setting is not supported, vill is set and vl must be 0
+ * @param val the new vtype
+ * @note only whole register groups (LMUL 1 to 8) and SEW 8 to 64 are supported
+ ********************************************************************************/
+bool vregisterfile::set_vtype(uint32_t val)
+{
+    uint32_t vsew = (val >> 3) & 0x7;
+    uint32_t vlmul = val & 0x7;
+
+    if(vsew > 3 || vlmul > 3 || (val >> 8) != 0)       // fractional LMUL and reserved bits
+    {
+        vtype = 0;
+        vill = true;
+        vl = 0;
+        return false;
+    }
+    vtype = val;
+    vill = false;
+    return true;
+
+}
+
+/**
+ * Dump the register file
+ * @return void  
+ * @param hdr prefix string 
+ * @param os where to print
+ * @note prints each register as one VLEN-bit little-endian number, four per
+ * line, followed by vl and vtype
+ * 
+ ********************************************************************************/
+void vregisterfile::dump(const std::string &hdr, std::ostream &os) const
+{
+    for(size_t r = 0; r < 32; r += 4)
+    {
+        os << hdr << std::right << std::setw(3) << std::setfill(' ') << ("v" + std::to_string(r));
+
+        for(size_t x = 0; x < 4; x++)       // loops through the 4 registers
+        {
+            const uint8_t *v = get(r + x);
+            os << " ";
+            for(int b = vlenb - 1; b >= 0; --b)
+                os << hex::to_hex8(v[b]);
+        }
+        os << std::endl;
+    }
+    os << hdr << " vl " << hex::to_hex32(vl) << " vtype " << hex::to_hex32(vill ? 0x80000000 : vtype) << std::endl;
+
+}
@@ -0,0 +1,38 @@
+#ifndef VREGISTERFILE_H
+#define VREGISTERFILE_H
+#include <vector>
+#include <iostream>
+#include "hex.h"
+
+class vregisterfile
+{
+    public:
+        static constexpr uint32_t VLEN          = 128;          // bits in one vector register
+        static constexpr uint32_t vlenb         = VLEN/8;
+
+        vregisterfile();
+        void reset();
+
+        uint8_t *get(uint32_t r) { return &registers[r*vlenb]; }
+        const uint8_t *get(uint32_t r) const { return &registers[r*vlenb]; }
+
+        uint32_t get_vl() const { return vl; }
+        uint32_t get_vtype() const { return vtype; }
+        bool is_vill() const { return vill; }
+        uint32_t get_sew() const { return 8 << ((vtype >> 3) & 0x7); }
+        uint32_t get_lmul() const { return 1 << (vtype & 0x7); }
+        uint32_t get_vlmax() const { return get_lmul() * VLEN / get_sew(); }
+
+        bool set_vtype(uint32_t val);
+        void set_vl(uint32_t val) { vl = val; }
+
+        void dump(const std::string &hdr, std::ostream &os = std::cout) const;
+
+    private: 
+        std::vector<uint8_t> registers;
+        uint32_t vl = { 0 };
+        uint32_t vtype = { 0 };
+        bool vill = { true };
+};
+
+#endif
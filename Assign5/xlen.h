@@ -0,0 +1,46 @@
+#ifndef XLEN_H
+#define XLEN_H
+#include <cstdint>
+#include <string>
+#include "hex.h"
+
+// The register width is picked when the simulator is built, -DRV_XLEN=64 builds
+// the RV64I simulator from the same sources.  Everything that depends on the
+// width comes from xlen_traits so there are no width checks at run time.
+#ifndef RV_XLEN
+#define RV_XLEN 32
+#endif
+
+template <unsigned N> struct xlen_traits;          // only 32 and 64 are defined
+
+template <> struct xlen_traits<32>
+{
+    typedef uint32_t uword_t;               ///< unsigned register value
+    typedef int32_t sword_t;                ///< signed register value
+    typedef uint64_t udword_t;              ///< twice the width, for mulh
+    typedef int64_t sdword_t;
+
+    static constexpr uint32_t shamt_mask    = 0x1f;
+    static constexpr uint32_t funct7_mask   = 0x7f;   ///< funct7 bits not used by shamt
+
+    static std::string to_hex(uword_t v) { return hex::to_hex32(v); }
+    static std::string to_hex0x(uword_t v) { return hex::to_hex0x32(v); }
+};
+
+template <> struct xlen_traits<64>
+{
+    typedef uint64_t uword_t;
+    typedef int64_t sword_t;
+    typedef unsigned __int128 udword_t;
+    typedef __int128 sdword_t;
+
+    static constexpr uint32_t shamt_mask    = 0x3f;
+    static constexpr uint32_t funct7_mask   = 0x7e;
+
+    static std::string to_hex(uword_t v) { return hex::to_hex64(v); }
+    static std::string to_hex0x(uword_t v) { return hex::to_hex0x64(v); }
+};
+
+typedef xlen_traits<RV_XLEN> xlen_t;
+
+#endif